@@ -21,10 +21,14 @@ set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_COUNTERMEASUR
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE")
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_GMEM_PROFILE")
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_FORCE_USE_INTERFERENCE_SIZE -Wno-interference-size")
+# set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_GMEM_NUMA_AWARE")   # use ALCONCURRENT_CONF_GMEM_NUMA_MAX_NODES=N to change the max number of NUMA nodes(default: 4)
+# set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE")   # Linux only. use membarrier() on the reclaimer side of hazard pointer
+# set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_HAZARD_PTR_SIMD_SCAN")   # x86_64 only. compare hazard pointer slots by AVX2/SSE2
 ### Debug purpose options
 set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_USE_MALLOC_ALLWAYS_FOR_DEBUG_WITH_SANITIZER")
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_RECORD_BACKTRACE_CHECK_DOUBLE_FREE")   # To use this option, it is better to define  -rdynamic. This option is also enable double free check
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_CHECK_OVERRUN_WRITING")
+# set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD")   # use ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_SAMPLING_INTERVAL=N and ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_QUARANTINE_SIZE=N to tune(default: 1000 and 64)
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_CHECK_PUSH_FRONT_FUNCTION_NULLPTR")
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_ENABLE_CHECK_TAIL_NODE_NEXT_NULLPTR")
 # set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DALCONCURRENT_CONF_REPLACE_STATIC_CAST_OF_ZDPTR_TO_DYNAMIC_CAST")
@@ -0,0 +1,214 @@
+/**
+ * @file atomic_shared_ptr.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief atomic shared pointer that is implemented by hazard pointer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * std::atomic<std::shared_ptr<T>> of libstdc++ uses a lock for load() also.
+ * atomic_shared_ptr<T> keeps std::shared_ptr<T> in a node, and swaps the pointer to the node atomically.
+ * load() protects the node by hazard pointer and copies std::shared_ptr<T> in the node. Therefore, load() does not take any lock.
+ * The replaced node is retired by hazard_ptr_mgr::Retire(), and is released after no thread refers it.
+ */
+
+#ifndef ALCONCCURRENT_INC_ATOMIC_SHARED_PTR_HPP_
+#define ALCONCCURRENT_INC_ATOMIC_SHARED_PTR_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "hazard_ptr.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief atomic shared pointer that has the interface like std::atomic<std::shared_ptr<T>>
+ *
+ * memory_order parameters are accepted for the compatibility with std::atomic<std::shared_ptr<T>>.
+ * But internal operations are always done with acquire/release or stronger memory order.
+ *
+ * @note
+ * store(), exchange() and compare_exchange_*() allocate a node by operator new.
+ * All operations that read the value, including load(), may throw std::bad_alloc if the calling thread fails to get a hazard pointer slot.
+ *
+ * @tparam T element type of std::shared_ptr
+ */
+template <typename T>
+class atomic_shared_ptr {
+public:
+	using value_type = std::shared_ptr<T>;
+
+	atomic_shared_ptr( void ) noexcept
+	  : hph_()
+	{
+	}
+	atomic_shared_ptr( std::nullptr_t ) noexcept
+	  : hph_()
+	{
+	}
+	atomic_shared_ptr( value_type desired )
+	  : hph_( make_node( std::move( desired ) ) )
+	{
+	}
+	~atomic_shared_ptr()
+	{
+		// load()はハザードポインタを解放してから戻るため、破棄時にはノードを参照しているスレッドはいない。
+		delete hph_.load( std::memory_order_acquire );
+	}
+
+	atomic_shared_ptr( const atomic_shared_ptr& )            = delete;
+	atomic_shared_ptr& operator=( const atomic_shared_ptr& ) = delete;
+
+	atomic_shared_ptr& operator=( value_type desired )
+	{
+		store( std::move( desired ) );
+		return *this;
+	}
+
+	bool is_lock_free( void ) const noexcept
+	{
+		return true;
+	}
+
+	value_type load( std::memory_order order = std::memory_order_seq_cst ) const
+	{
+		static_cast<void>( order );
+
+		hazard_pointer hp = get_hazard_pointer();
+		while ( !hph_.verify_exchange( hp ) ) {}
+		return copy_from_node( hp.get() );
+	}
+
+	operator value_type() const
+	{
+		return load();
+	}
+
+	void store( value_type desired, std::memory_order order = std::memory_order_seq_cst )
+	{
+		static_cast<void>( order );
+
+		retire_node( hph_.exchange( make_node( std::move( desired ) ), std::memory_order_acq_rel ) );
+	}
+
+	value_type exchange( value_type desired, std::memory_order order = std::memory_order_seq_cst )
+	{
+		static_cast<void>( order );
+
+		node_type* p_old = hph_.exchange( make_node( std::move( desired ) ), std::memory_order_acq_rel );
+
+		// 他スレッドがload()でp_oldのsp_をコピー中の可能性があるため、ムーブせずにコピーする。
+		value_type ans = copy_from_node( p_old );
+		retire_node( p_old );
+		return ans;
+	}
+
+	/**
+	 * @brief CAS操作を実施する。
+	 *
+	 * 保持しているstd::shared_ptrが、expectedと同じポインタを保持し、かつ所有権を共有している場合に、desiredで置き換える。
+	 *
+	 * @return true 置き換えに成功
+	 * @return false 置き換えに失敗。expectedは、保持している値で置き換えられている。
+	 */
+	bool compare_exchange_strong( value_type& expected, value_type desired, std::memory_order success = std::memory_order_seq_cst, std::memory_order failure = std::memory_order_seq_cst )
+	{
+		static_cast<void>( success );
+		static_cast<void>( failure );
+
+		std::unique_ptr<node_type> up_new_node( make_node( std::move( desired ) ) );
+		hazard_pointer             hp = get_hazard_pointer();
+		while ( true ) {
+			if ( !hph_.verify_exchange( hp ) ) {
+				continue;
+			}
+
+			// ここに到達した時点で、hpのノードはハザードポインタとして登録済みのため、参照可能。
+			if ( !is_equivalent( hp.get(), expected ) ) {
+				expected = copy_from_node( hp.get() );
+				return false;
+			}
+
+			node_type* p_expect = hp.get();
+			if ( hph_.compare_exchange_strong( p_expect, up_new_node.get(), std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+				up_new_node.release();
+				retire_node( hp.get() );
+				return true;
+			}
+			// 他スレッドによって変更されたため、変更後の値で検査をやり直す。
+		}
+	}
+	bool compare_exchange_strong( value_type& expected, value_type desired, std::memory_order order )
+	{
+		return compare_exchange_strong( expected, std::move( desired ), order, order );
+	}
+
+	bool compare_exchange_weak( value_type& expected, value_type desired, std::memory_order success = std::memory_order_seq_cst, std::memory_order failure = std::memory_order_seq_cst )
+	{
+		return compare_exchange_strong( expected, std::move( desired ), success, failure );
+	}
+	bool compare_exchange_weak( value_type& expected, value_type desired, std::memory_order order )
+	{
+		return compare_exchange_strong( expected, std::move( desired ), order, order );
+	}
+
+private:
+	struct node_type {
+		const value_type sp_;   // ノードが共有された後は変更しない
+
+		explicit node_type( value_type&& sp )
+		  : sp_( std::move( sp ) )
+		{
+		}
+	};
+	using hazard_pointer = typename hazard_ptr_handler<node_type>::hazard_pointer;
+
+	static node_type* make_node( value_type&& sp )
+	{
+		// 空のstd::shared_ptrはノードを持たずにnullptrで表す。
+		if ( ( sp.get() == nullptr ) && ( sp.use_count() == 0 ) ) return nullptr;
+		return new node_type( std::move( sp ) );
+	}
+
+	hazard_pointer get_hazard_pointer( void ) const
+	{
+		// hazard_ptr_handler::get_to_verify_exchange()はnoexceptのため、スロット確保に失敗した場合の例外を呼び出し元へ伝えるには、ここでハザードポインタを構築する。
+		return hazard_pointer( hph_.load( std::memory_order_acquire ) );
+	}
+
+	static value_type copy_from_node( const node_type* p_node ) noexcept
+	{
+		if ( p_node == nullptr ) return value_type();
+		return p_node->sp_;
+	}
+
+	static void retire_node( node_type* p_node )
+	{
+		if ( p_node == nullptr ) return;
+		internal::hazard_ptr_mgr::Retire( p_node );
+	}
+
+	static bool is_equivalent( const node_type* p_node, const value_type& sp ) noexcept
+	{
+		const value_type& cur = ( p_node == nullptr ) ? empty_sp() : p_node->sp_;
+		return ( cur.get() == sp.get() ) && !cur.owner_before( sp ) && !sp.owner_before( cur );
+	}
+
+	static const value_type& empty_sp( void ) noexcept
+	{
+		static const value_type empty;
+		return empty;
+	}
+
+	hazard_ptr_handler<node_type> hph_;
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
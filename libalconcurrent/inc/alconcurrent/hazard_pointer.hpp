@@ -0,0 +1,218 @@
+/**
+ * @file hazard_pointer.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief std::hazard_pointer (P2530) compatible interface
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * This provides the interface of std::hazard_pointer that is proposed by P2530 on top of hazard_ptr_mgr.
+ * Therefore, hazard_pointer shares the hazard pointer slots with hazard_ptr<T>, and retire() uses hazard_ptr_mgr::Retire().
+ */
+
+#ifndef ALCONCCURRENT_INC_HAZARD_POINTER_HPP_
+#define ALCONCCURRENT_INC_HAZARD_POINTER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "internal/hazard_ptr_internal.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief base class of the object that is protected by hazard_pointer
+ *
+ * @tparam T derived class
+ * @tparam D deleter type
+ */
+template <typename T, typename D = std::default_delete<T>>
+class hazard_pointer_obj_base {
+public:
+	/**
+	 * @brief retire this object
+	 *
+	 * d( static_cast<T*>( this ) ) is called after this object becomes not hazard pointer.
+	 * If the retired list could not be extended, this waits for this object to become not hazard pointer and calls d synchronously.
+	 *
+	 * @pre this object should be unreachable from the shared data structure.
+	 * @pre d should not throw any exception.
+	 */
+	void retire( D d = D() ) noexcept
+	{
+		deleter_ = std::move( d );
+		internal::hazard_ptr_mgr::Retire( static_cast<void*>( static_cast<T*>( this ) ), &hazard_pointer_obj_base::call_deleter );
+	}
+
+protected:
+	hazard_pointer_obj_base( void )                                      = default;
+	hazard_pointer_obj_base( const hazard_pointer_obj_base& )            = default;
+	hazard_pointer_obj_base( hazard_pointer_obj_base&& )                 = default;
+	hazard_pointer_obj_base& operator=( const hazard_pointer_obj_base& ) = default;
+	hazard_pointer_obj_base& operator=( hazard_pointer_obj_base&& )      = default;
+	~hazard_pointer_obj_base()                                           = default;
+
+private:
+	static void call_deleter( void* p )
+	{
+		T* p_obj = static_cast<T*>( p );
+		D  d     = std::move( static_cast<hazard_pointer_obj_base*>( p_obj )->deleter_ );
+		d( p_obj );
+	}
+
+	D deleter_;
+};
+
+/**
+ * @brief hazard pointer that owns a hazard pointer slot
+ *
+ * A hazard_pointer is created by make_hazard_pointer(). A default constructed hazard_pointer is empty and has no slot.
+ */
+class hazard_pointer {
+public:
+	hazard_pointer( void ) noexcept = default;
+	hazard_pointer( hazard_pointer&& src ) noexcept
+	  : os_( std::move( src.os_ ) )
+	{
+	}
+	hazard_pointer& operator=( hazard_pointer&& src ) noexcept
+	{
+		if ( this == &src ) return *this;
+		os_ = std::move( src.os_ );
+		return *this;
+	}
+	~hazard_pointer() = default;
+
+	hazard_pointer( const hazard_pointer& )            = delete;
+	hazard_pointer& operator=( const hazard_pointer& ) = delete;
+
+	bool empty( void ) const noexcept
+	{
+		return os_ == nullptr;
+	}
+
+	/**
+	 * @brief protect the pointer that is loaded from src
+	 *
+	 * @pre this is not empty
+	 *
+	 * @return T* protected pointer
+	 */
+	template <typename T>
+	T* protect( const std::atomic<T*>& src ) noexcept
+	{
+		T* p = src.load( std::memory_order_relaxed );
+		while ( !try_protect( p, src ) ) {}
+		return p;
+	}
+
+	/**
+	 * @brief try to protect ptr
+	 *
+	 * @pre this is not empty
+	 *
+	 * @param ptr [in] pointer that is expected to be in src. [out] the latest value of src.
+	 * @param src source of pointer
+	 * @return true ptr is protected
+	 * @return false src is changed. ptr is updated to the latest value of src, and is not protected.
+	 */
+	template <typename T>
+	bool try_protect( T*& ptr, const std::atomic<T*>& src ) noexcept
+	{
+		T* p_expect = ptr;
+		reset_protection( p_expect );
+		ptr = src.load( std::memory_order_acquire );
+		if ( p_expect != ptr ) {
+			reset_protection();
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief protect ptr
+	 *
+	 * @pre this is not empty
+	 */
+	template <typename T>
+	void reset_protection( const T* ptr ) noexcept
+	{
+		store_to_slot( static_cast<const void*>( ptr ) );
+	}
+
+	/**
+	 * @brief clear protection
+	 *
+	 * @pre this is not empty
+	 */
+	void reset_protection( std::nullptr_t = nullptr ) noexcept
+	{
+		store_to_slot( nullptr );
+	}
+
+	void swap( hazard_pointer& other ) noexcept
+	{
+		os_.swap( other.os_ );
+	}
+
+private:
+	explicit hazard_pointer( internal::hzrd_slot_ownership_t&& os ) noexcept
+	  : os_( std::move( os ) )
+	{
+	}
+
+	void store_to_slot( const void* p ) noexcept
+	{
+		// nullptrは空きスロットを意味するため、使用中でハザードポインタが無い状態は1を格納する。
+		os_->store( ( p == nullptr ) ? reinterpret_cast<const void*>( static_cast<std::uintptr_t>( 1U ) ) : p, internal::hzrd_slot_memory_order_for_store );
+		internal::hzrd_slot_fence_after_store();
+	}
+
+	internal::hzrd_slot_ownership_t os_;
+
+	friend hazard_pointer make_hazard_pointer( void );
+	template <size_t N>
+	friend std::array<hazard_pointer, N> make_hazard_pointer( void );
+};
+
+inline void swap( hazard_pointer& a, hazard_pointer& b ) noexcept
+{
+	a.swap( b );
+}
+
+/**
+ * @brief create a hazard_pointer that owns a hazard pointer slot
+ */
+inline hazard_pointer make_hazard_pointer( void )
+{
+	return hazard_pointer( internal::hazard_ptr_mgr::AssignHazardPtrSlot( nullptr ) );
+}
+
+/**
+ * @brief create N hazard_pointers at once
+ *
+ * The hazard pointer slots of the calling thread are walked only once to reserve N slots.
+ */
+template <size_t N>
+std::array<hazard_pointer, N> make_hazard_pointer( void )
+{
+	std::array<internal::hzrd_slot_ownership_t, N> slots;
+	internal::hazard_ptr_mgr::AssignHazardPtrSlots( slots.data(), N );
+
+	std::array<hazard_pointer, N> ans;
+	for ( size_t i = 0; i < N; i++ ) {
+		ans[i] = hazard_pointer( std::move( slots[i] ) );
+	}
+	return ans;
+}
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
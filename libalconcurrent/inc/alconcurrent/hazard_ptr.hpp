@@ -14,7 +14,9 @@
 #ifndef ALCONCCURRENT_INC_HAZARD_PTR_HPP_
 #define ALCONCCURRENT_INC_HAZARD_PTR_HPP_
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -34,6 +36,62 @@ class hazard_ptr_handler;
 template <typename T>
 class hazard_ptr_w_mark_handler;
 
+template <typename T>
+class hazard_ptr;
+
+/**
+ * @brief scoped set of hazard pointer slots that are reserved at once for one operation
+ *
+ * The constructor walks the hazard pointer slots of the calling thread only once to reserve K slots.
+ * hazard_ptr that is constructed with this set takes one of the reserved slots without the slot search of hazard_ptr_mgr::AssignHazardPtrSlot().
+ * After that, hazard_ptr changes the protected pointer within its slot by store() or reuse_to_verify_exchange().
+ *
+ * The slots that are not taken by hazard_ptr are released when this set is destructed.
+ * The slot that is taken by hazard_ptr is owned by hazard_ptr, therefore hazard_ptr could outlive this set.
+ *
+ * @tparam K number of slots to reserve
+ */
+template <size_t K>
+class hazard_slot_set {
+public:
+	hazard_slot_set( void )
+	  : slots_()
+	  , num_taken_( 0 )
+	{
+		internal::hazard_ptr_mgr::AssignHazardPtrSlots( slots_.data(), K );
+	}
+	~hazard_slot_set() = default;
+
+	hazard_slot_set( const hazard_slot_set& )            = delete;
+	hazard_slot_set( hazard_slot_set&& )                 = delete;
+	hazard_slot_set& operator=( const hazard_slot_set& ) = delete;
+	hazard_slot_set& operator=( hazard_slot_set&& )      = delete;
+
+	/**
+	 * @brief number of slots that are not taken yet
+	 */
+	size_t remaining( void ) const noexcept
+	{
+		return K - num_taken_;
+	}
+
+private:
+	internal::hzrd_slot_ownership_t take_slot( void )
+	{
+		if ( num_taken_ >= K ) {
+			// 予約数を超えた場合は、通常の割り当てにフォールバックする。
+			return internal::hazard_ptr_mgr::AssignHazardPtrSlot( nullptr );
+		}
+		return std::move( slots_[num_taken_++] );
+	}
+
+	std::array<internal::hzrd_slot_ownership_t, K> slots_;
+	size_t                                         num_taken_;
+
+	template <typename T>
+	friend class hazard_ptr;
+};
+
 template <typename T>
 class hazard_ptr {
 public:
@@ -45,6 +103,18 @@ public:
 	  , os_( internal::hazard_ptr_mgr::AssignHazardPtrSlot( p_arg ) )
 	{
 	}
+	/**
+	 * @brief construct with a slot that is reserved by hss
+	 */
+	template <size_t K>
+	explicit hazard_ptr( hazard_slot_set<K>& hss, pointer p_arg = nullptr )
+	  : p_( p_arg )
+	  , os_( hss.take_slot() )
+	{
+		if ( p_ != nullptr ) {
+			reflect_from_p();
+		}
+	}
 	~hazard_ptr() = default;
 	ALCC_INTERNAL_CONSTEXPR_CONSTRUCTOR_BODY hazard_ptr( const hazard_ptr& src )
 	  : p_( src.p_ )
@@ -67,6 +137,7 @@ public:
 
 		p_ = src.p_;
 		os_->store( src.os_->load( std::memory_order_acquire ), internal::hzrd_slot_memory_order_for_store );
+		internal::hzrd_slot_fence_after_store();
 		// nullptrが特別扱いされるため、src側がnullptrだった場合に自然に対応できるようにload()を使う。
 		// p == nullptrで判定しても良いが、どちら効率的かは不明。。。
 
@@ -165,6 +236,7 @@ private:
 #endif
 
 		os_->store( ( p_ == nullptr ) ? reinterpret_cast<pointer>( static_cast<std::uintptr_t>( 1U ) ) : p_, internal::hzrd_slot_memory_order_for_store );
+		internal::hzrd_slot_fence_after_store();
 	}
 
 	pointer                         p_;
@@ -721,6 +793,12 @@ public:
 		  , hp_( p_arg )
 		{
 		}
+		template <size_t K>
+		explicit hazard_pointer_w_mark_impl( hazard_slot_set<K>& hss )
+		  : mark_( false )
+		  , hp_( hss )
+		{
+		}
 		hazard_pointer_w_mark_impl( const hazard_pointer_w_mark_impl& )            = default;
 		hazard_pointer_w_mark_impl( hazard_pointer_w_mark_impl&& )                 = default;
 		hazard_pointer_w_mark_impl& operator=( const hazard_pointer_w_mark_impl& ) = default;
@@ -1040,6 +1118,246 @@ private:
 	std::atomic<addr_markable> a_target_addr_;
 };
 
+/**
+ * @brief 上位16bitにタグ情報を持つポインタを保持し、ハザードポインタとして取り出すハンドラ
+ *
+ * x86-64やAArch64のユーザ空間のアドレスは、上位16bitが0であるため、この16bitにバージョンカウンタや複数bitの状態を格納する。
+ * ハザードポインタとして登録するのは、タグ情報を除いたポインタである。
+ * verify_exchange()やCAS系のI/Fは、タグ情報を含めて比較するため、ポインタが同じでもタグ情報が変化した場合は失敗する。
+ *
+ * @warning
+ * 57bitアドレス(5-level paging)で上位のアドレスを使う場合や、上位bitを使用するポインタタグ機能(ARMのPointer Authentication等)と併用する場合は使用できない。
+ *
+ * @tparam T
+ */
+template <typename T>
+class hazard_ptr_w_tag_handler {
+public:
+	using element_type   = T;
+	using pointer        = T*;
+	using hazard_pointer = hazard_ptr<T>;
+	using tag_type       = std::uint16_t;
+
+	static constexpr size_t kTagBits = 16;
+
+	struct pointer_w_tag {
+		tag_type tag_ = 0;
+		pointer  p_   = nullptr;
+	};
+
+	struct hazard_pointer_w_tag {
+		tag_type       tag_;
+		hazard_pointer hp_;   // std::memory_order_releaseを扱いやすくするために、tag_の後にアトミック変数関連の操作を持つhazard_pointerの変数を宣言する。
+
+		hazard_pointer_w_tag( void )
+		  : tag_( 0 )
+		  , hp_()
+		{
+		}
+		template <size_t K>
+		explicit hazard_pointer_w_tag( hazard_slot_set<K>& hss )
+		  : tag_( 0 )
+		  , hp_( hss )
+		{
+		}
+		explicit hazard_pointer_w_tag( const pointer_w_tag& src )
+		  : tag_( src.tag_ )
+		  , hp_( src.p_ )
+		{
+		}
+		hazard_pointer_w_tag( const hazard_pointer_w_tag& )            = default;
+		hazard_pointer_w_tag( hazard_pointer_w_tag&& )                 = default;
+		hazard_pointer_w_tag& operator=( const hazard_pointer_w_tag& ) = default;
+		hazard_pointer_w_tag& operator=( hazard_pointer_w_tag&& )      = default;
+		~hazard_pointer_w_tag()                                        = default;
+
+		hazard_pointer_w_tag& operator=( const pointer_w_tag& src )
+		{
+			tag_ = src.tag_;
+			hp_.store( src.p_ );
+			return *this;
+		}
+		void swap( hazard_pointer_w_tag& src ) noexcept
+		{
+			std::swap( tag_, src.tag_ );
+			hp_.swap( src.hp_ );
+		}
+	};
+
+	constexpr hazard_ptr_w_tag_handler( void ) noexcept
+	  : a_target_addr_( static_cast<addr_tagged>( 0U ) )
+	{
+	}
+	explicit hazard_ptr_w_tag_handler( pointer p_desired, tag_type tag_desired = 0 ) noexcept
+	  : a_target_addr_( zip_to_addr_tagged( p_desired, tag_desired ) )
+	{
+	}
+	hazard_ptr_w_tag_handler( const hazard_ptr_w_tag_handler& src ) noexcept
+	  : a_target_addr_( src.a_target_addr_.load( std::memory_order_acquire ) )
+	{
+	}
+	hazard_ptr_w_tag_handler& operator=( const hazard_ptr_w_tag_handler& src ) noexcept
+	{
+		if ( this == &src ) return *this;
+
+		a_target_addr_.store( src.a_target_addr_.load( std::memory_order_acquire ), std::memory_order_release );
+
+		return *this;
+	}
+
+	pointer_w_tag load( std::memory_order order = std::memory_order_acquire ) const noexcept
+	{
+		return unzip_addr_tagged( a_target_addr_.load( order ) );
+	}
+
+	void store( const pointer_w_tag& desired, std::memory_order order = std::memory_order_release ) noexcept
+	{
+		a_target_addr_.store( zip_to_addr_tagged( desired.p_, desired.tag_ ), order );
+	}
+	void store( pointer p_desired, tag_type tag_desired, std::memory_order order = std::memory_order_release ) noexcept
+	{
+		a_target_addr_.store( zip_to_addr_tagged( p_desired, tag_desired ), order );
+	}
+
+	hazard_pointer_w_tag get_to_verify_exchange( void ) const noexcept
+	{
+		return hazard_pointer_w_tag( load( std::memory_order_acquire ) );
+	}
+
+	void reuse_to_verify_exchange( hazard_pointer_w_tag& hp_w_tag_reuse ) const noexcept
+	{
+		hp_w_tag_reuse = load( std::memory_order_acquire );
+	}
+
+	/**
+	 * @brief hp_w_tagと自身のポインタとタグ情報の一致をチェックする
+	 *
+	 * @return true 一致
+	 * @return false 不一致。かつ、自身が保持するポインタとタグ情報でhp_w_tagを更新した。
+	 */
+	bool verify_exchange( hazard_pointer_w_tag& hp_w_tag ) const noexcept
+	{
+		addr_tagged addr_desired = zip_to_addr_tagged( hp_w_tag.hp_.get(), hp_w_tag.tag_ );
+		addr_tagged addr_expect  = a_target_addr_.load( std::memory_order_acquire );
+
+		bool ret = ( addr_expect == addr_desired );
+		if ( !ret ) {
+			hp_w_tag = unzip_addr_tagged( addr_expect );
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief CAS操作を実施する。CAS操作には、compare_exchange_weak を使用する。
+	 *
+	 * @return true CAS操作に成功。
+	 * @return false CAS操作に失敗。expected は、自身が保持する現在の情報で置き換えられている。
+	 */
+	bool compare_exchange_weak( pointer_w_tag&       expected,
+	                            const pointer_w_tag& desired,
+	                            std::memory_order    success = std::memory_order_acq_rel,
+	                            std::memory_order    failure = std::memory_order_acquire ) noexcept
+	{
+		addr_tagged addr_expected = zip_to_addr_tagged( expected.p_, expected.tag_ );
+		bool        ret           = a_target_addr_.compare_exchange_weak( addr_expected, zip_to_addr_tagged( desired.p_, desired.tag_ ), success, failure );
+		if ( !ret ) {
+			expected = unzip_addr_tagged( addr_expected );
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief CAS操作を実施する。CAS操作には、compare_exchange_strong を使用する。
+	 *
+	 * @return true CAS操作に成功。
+	 * @return false CAS操作に失敗。expected は、自身が保持する現在の情報で置き換えられている。
+	 */
+	bool compare_exchange_strong( pointer_w_tag&       expected,
+	                              const pointer_w_tag& desired,
+	                              std::memory_order    success = std::memory_order_acq_rel,
+	                              std::memory_order    failure = std::memory_order_acquire ) noexcept
+	{
+		addr_tagged addr_expected = zip_to_addr_tagged( expected.p_, expected.tag_ );
+		bool        ret           = a_target_addr_.compare_exchange_strong( addr_expected, zip_to_addr_tagged( desired.p_, desired.tag_ ), success, failure );
+		if ( !ret ) {
+			expected = unzip_addr_tagged( addr_expected );
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief CAS操作を実施する。CAS操作には、compare_exchange_strong を使用する。
+	 *
+	 * @param expected 自身が保持していると期待されるハザードポインタとタグ情報
+	 * @param desired CAS操作で置き換える新たなポインタとタグ情報
+	 * @return true CAS操作に成功。 expected は、desired で置き換えられている。
+	 * @return false CAS操作に失敗。expected は、自身が保持する現在の情報で置き換えられている。
+	 */
+	bool compare_exchange_strong_to_verify_exchange1( hazard_pointer_w_tag& expected,
+	                                                  const pointer_w_tag&  desired,
+	                                                  std::memory_order     success = std::memory_order_acq_rel,
+	                                                  std::memory_order     failure = std::memory_order_acquire ) noexcept
+	{
+		addr_tagged addr_expected = zip_to_addr_tagged( expected.hp_.get(), expected.tag_ );
+		bool        ret           = a_target_addr_.compare_exchange_strong( addr_expected, zip_to_addr_tagged( desired.p_, desired.tag_ ), success, failure );
+		if ( ret ) {
+			expected = desired;
+		} else {
+			expected = unzip_addr_tagged( addr_expected );
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief CAS操作を実施する。CAS操作には、compare_exchange_strong を使用する。
+	 *
+	 * @param expected 自身が保持していると期待されるハザードポインタとタグ情報
+	 * @param desired CAS操作で置き換える新たなポインタとタグ情報
+	 * @return true CAS操作に成功。また、 expected は呼び出し前の状態を維持している。
+	 * @return false CAS操作に失敗。expected は、自身が保持する現在の情報で置き換えられている。
+	 */
+	bool compare_exchange_strong_to_verify_exchange2( hazard_pointer_w_tag& expected,
+	                                                  const pointer_w_tag&  desired,
+	                                                  std::memory_order     success = std::memory_order_acq_rel ) noexcept
+	{
+		addr_tagged addr_expected = zip_to_addr_tagged( expected.hp_.get(), expected.tag_ );
+		bool        ret           = a_target_addr_.compare_exchange_strong( addr_expected, zip_to_addr_tagged( desired.p_, desired.tag_ ), success, std::memory_order_acquire );
+		if ( !ret ) {
+			expected = unzip_addr_tagged( addr_expected );
+		}
+		return ret;
+	}
+
+private:
+	using addr_tagged = std::uintptr_t;
+
+	static_assert( sizeof( addr_tagged ) * 8 == 64, "hazard_ptr_w_tag_handler requires 64bit pointer" );
+
+	static constexpr size_t      tag_shift = 64 - kTagBits;
+	static constexpr addr_tagged addr_mask = ( static_cast<addr_tagged>( 1U ) << tag_shift ) - 1U;
+
+	static addr_tagged zip_to_addr_tagged( pointer p, tag_type tag ) noexcept
+	{
+		addr_tagged addr = reinterpret_cast<addr_tagged>( p );
+#if defined( ALCONCURRENT_CONF_ENABLE_CHECK_LOGIC_ERROR ) || defined( ALCONCURRENT_CONF_ENABLE_THROW_LOGIC_ERROR_TERMINATION )
+		if ( ( addr & ~addr_mask ) != 0 ) {
+			internal::LogOutput( log_type::ERR, "upper %zu bits of pointer is not zero, p=%p", kTagBits, p );
+#ifdef ALCONCURRENT_CONF_ENABLE_THROW_LOGIC_ERROR_TERMINATION
+			std::abort();
+#endif
+		}
+#endif
+		return ( addr & addr_mask ) | ( static_cast<addr_tagged>( tag ) << tag_shift );
+	}
+
+	static pointer_w_tag unzip_addr_tagged( addr_tagged addr ) noexcept
+	{
+		return pointer_w_tag { static_cast<tag_type>( addr >> tag_shift ), reinterpret_cast<pointer>( addr & addr_mask ) };
+	}
+
+	std::atomic<addr_tagged> a_target_addr_;
+};
+
 }   // namespace concurrent
 }   // namespace alpha
 
@@ -0,0 +1,118 @@
+/**
+ * @file ebr_domain.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief epoch based reclamation
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#ifndef ALCONCURRENT_INC_INTERNAL_EBR_DOMAIN_HPP_
+#define ALCONCURRENT_INC_INTERNAL_EBR_DOMAIN_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief reclamation policy tag to select hazard pointer for the lock-free containers
+ *
+ * This is the default policy.
+ */
+struct hazard_ptr_reclamation {};
+
+/**
+ * @brief reclamation policy tag to select epoch based reclamation for the lock-free containers
+ *
+ * A thread announces the global epoch once per API call instead of publishing and re-validating a hazard pointer per node access.
+ * Instead of that, a thread that stalls in an API call blocks the reclamation of all retired nodes.
+ */
+struct epoch_based_reclamation {};
+
+namespace internal {
+
+/**
+ * @brief epoch based reclamation domain
+ *
+ * Each thread announces the global epoch at the entry of its critical section.
+ * The global epoch advances only when all threads that are in critical section have announced the current global epoch.
+ * A pointer that was retired in epoch e is released after the global epoch becomes e + 2.
+ */
+class ebr_domain {
+public:
+	using retire_deleter_t = void ( * )( void* );   //!< deleter type for Retire()
+
+	/**
+	 * @brief RAII guard of critical section of epoch based reclamation
+	 *
+	 * A pointer that is loaded from the shared data structure in the scope of this guard is not released until this guard is destructed.
+	 * This guard could be nested.
+	 */
+	class critical_section {
+	public:
+		critical_section( void )
+		{
+			ebr_domain::Enter();
+		}
+		~critical_section()
+		{
+			ebr_domain::Leave();
+		}
+
+		critical_section( const critical_section& )            = delete;
+		critical_section( critical_section&& )                 = delete;
+		critical_section& operator=( const critical_section& ) = delete;
+		critical_section& operator=( critical_section&& )      = delete;
+	};
+
+	/**
+	 * @brief enter critical section
+	 *
+	 * Please use critical_section instead of calling this API directly.
+	 */
+	static void Enter( void );
+
+	/**
+	 * @brief leave critical section
+	 *
+	 * Please use critical_section instead of calling this API directly.
+	 */
+	static void Leave( void ) noexcept;
+
+	/**
+	 * @brief retire p, and call deleter( p ) after all threads that may access p leave their critical section
+	 *
+	 * @pre p should be unreachable from the shared data structure before calling this API.
+	 *
+	 * @param p pointer to retire. if p is nullptr, do nothing.
+	 * @param deleter function to release p
+	 */
+	static void Retire( void* p, retire_deleter_t deleter );
+
+	/**
+	 * @brief reclaim the retired pointers of the calling thread and the retired pointers that are left by exited threads
+	 *
+	 * @pre the calling thread is not in critical section.
+	 *
+	 * @return size_t the number of retired pointers that could not be reclaimed yet
+	 */
+	static size_t DrainRetired( void );
+
+	/**
+	 * @brief get current global epoch
+	 *
+	 * This API is for debug and test purpose.
+	 */
+	static std::uint64_t GetGlobalEpoch( void ) noexcept;
+};
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
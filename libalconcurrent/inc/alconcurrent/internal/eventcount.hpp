@@ -0,0 +1,123 @@
+/**
+ * @file eventcount.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief eventcount to park the waiting threads without adding the cost to the notifying side
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * A waiter calls prepare_wait(), re-checks its condition, and then calls commit_wait() or cancel_wait().
+ * A notifier changes the condition, and then calls notify_one() or notify_all().
+ * If there is no waiter, notify_one()/notify_all() is one fence and one load, and no system call is done.
+ */
+
+#ifndef ALCONCURRENT_INC_INTERNAL_EVENTCOUNT_HPP_
+#define ALCONCURRENT_INC_INTERNAL_EVENTCOUNT_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined( __linux__ )
+#define ALCC_INTERNAL_EVENTCOUNT_USE_FUTEX
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+class eventcount {
+public:
+	using key_type = std::uint32_t;
+
+	eventcount( void ) noexcept
+	  : epoch_( 0 )
+	  , waiters_( 0 )
+	{
+	}
+
+	eventcount( const eventcount& )            = delete;
+	eventcount( eventcount&& )                 = delete;
+	eventcount& operator=( const eventcount& ) = delete;
+	eventcount& operator=( eventcount&& )      = delete;
+
+	/**
+	 * @brief 待ち合わせの準備をする
+	 *
+	 * この関数の呼び出し後に、待ち合わせ条件を再確認すること。その後、commit_wait()かcancel_wait()のどちらかを必ず呼び出すこと。
+	 *
+	 * @return key_type commit_wait()に渡すキー
+	 */
+	key_type prepare_wait( void ) noexcept
+	{
+		waiters_.fetch_add( 1, std::memory_order_seq_cst );
+		return epoch_.load( std::memory_order_seq_cst );
+	}
+
+	/**
+	 * @brief prepare_wait()後に、待ち合わせ条件が成立していたため、待ち合わせを取り消す
+	 */
+	void cancel_wait( void ) noexcept
+	{
+		waiters_.fetch_sub( 1, std::memory_order_relaxed );
+	}
+
+	/**
+	 * @brief prepare_wait()以降にnotify_one()/notify_all()が呼ばれるまで待つ
+	 *
+	 * spurious wakeupがあり得るため、呼び出し元は待ち合わせ条件を再確認すること。
+	 *
+	 * @param key prepare_wait()の戻り値
+	 */
+	void commit_wait( key_type key ) noexcept;
+
+	/**
+	 * @brief prepare_wait()以降にnotify_one()/notify_all()が呼ばれるか、rel_timeが経過するまで待つ
+	 *
+	 * @param key prepare_wait()の戻り値
+	 * @param rel_time 待ち合わせる最大時間
+	 * @return true notifyされた、あるいはspurious wakeup
+	 * @return false タイムアウト
+	 */
+	bool commit_wait_for( key_type key, std::chrono::nanoseconds rel_time ) noexcept;
+
+	/**
+	 * @brief 待ち合わせ条件を変更した後に、待っているスレッドを1つ起こす
+	 */
+	void notify_one( void ) noexcept
+	{
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		if ( waiters_.load( std::memory_order_relaxed ) == 0 ) return;
+		wake( false );
+	}
+
+	/**
+	 * @brief 待ち合わせ条件を変更した後に、待っているスレッドをすべて起こす
+	 */
+	void notify_all( void ) noexcept
+	{
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		if ( waiters_.load( std::memory_order_relaxed ) == 0 ) return;
+		wake( true );
+	}
+
+private:
+	void wake( bool is_all ) noexcept;
+
+	std::atomic<key_type> epoch_;     //!< futex word. incremented by notify when there is a waiter
+	std::atomic<key_type> waiters_;   //!< number of the threads between prepare_wait() and commit_wait()/cancel_wait()
+#ifndef ALCC_INTERNAL_EVENTCOUNT_USE_FUTEX
+	std::mutex              mtx_;
+	std::condition_variable cv_;
+#endif
+};
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
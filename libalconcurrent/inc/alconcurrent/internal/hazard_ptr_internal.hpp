@@ -42,7 +42,33 @@ extern std::atomic<size_t> call_count_hazard_ptr_get_;
 extern std::atomic<size_t> loop_count_in_hazard_ptr_get_;
 #endif
 
+#ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE
+constexpr std::memory_order hzrd_slot_memory_order_for_store = std::memory_order_release;
+
+extern std::atomic<bool> g_is_hzrd_ptr_asymmetric_fence_available;   //!< true: membarrier() is available for the heavy side fence
+#else
 constexpr std::memory_order hzrd_slot_memory_order_for_store = std::memory_order_seq_cst;
+#endif
+
+/**
+ * @brief reader side fence that should be called after storing a pointer into hazard pointer slot
+ *
+ * If ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE is defined and membarrier() is available,
+ * this is only compiler barrier, because the reclaimer side issues membarrier() before scanning hazard pointer slots.
+ * If membarrier() is not available, this falls back to std::atomic_thread_fence( std::memory_order_seq_cst ).
+ *
+ * If ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE is not defined, hzrd_slot_memory_order_for_store is seq_cst and this does nothing.
+ */
+inline void hzrd_slot_fence_after_store( void ) noexcept
+{
+#ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE
+	if ( g_is_hzrd_ptr_asymmetric_fence_available.load( std::memory_order_relaxed ) ) {
+		std::atomic_signal_fence( std::memory_order_seq_cst );
+	} else {
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+	}
+#endif
+}
 
 class hzrd_slot_releaser {
 public:
@@ -54,9 +80,74 @@ public:
 };
 using hzrd_slot_ownership_t = std::unique_ptr<std::atomic<const void*>, hzrd_slot_releaser>;
 
+/////////////////////////////////////////////////////////////////
+class global_scope_hazard_ptr_chain;
+class hazard_ptr_group;
+
+/**
+ * @brief snapshot of all hazard pointers at the time of hazard_ptr_mgr::TakeSnapshot()
+ *
+ * hazard_ptr_mgr::TakeSnapshot() gathers all hazard pointers once into a sorted array, and contains() answers the membership by binary search.
+ * Therefore, the cost to check a batch of candidate pointers does not scale with (number of hazard pointer slots) x (number of candidates).
+ *
+ * @warning
+ * A snapshot answers correctly only for the pointers that had already been unreachable from the shared data structure before TakeSnapshot() was called.
+ * Please take a snapshot after gathering the candidate pointers.
+ *
+ * If the number of hazard pointers exceeds the inline buffer, the buffer that is cached per thread is borrowed.
+ * Therefore, a snapshot should be destructed by the thread that took it.
+ */
+class hazard_ptr_snapshot {
+public:
+	hazard_ptr_snapshot( void ) noexcept;
+	hazard_ptr_snapshot( hazard_ptr_snapshot&& src ) noexcept;
+	hazard_ptr_snapshot& operator=( hazard_ptr_snapshot&& src ) noexcept;
+	~hazard_ptr_snapshot();
+	hazard_ptr_snapshot( const hazard_ptr_snapshot& )            = delete;
+	hazard_ptr_snapshot& operator=( const hazard_ptr_snapshot& ) = delete;
+
+	/**
+	 * @brief Check if p was hazard pointer at the time of taking this snapshot or not
+	 *
+	 * @param p
+	 * @return true p is hazard pointer
+	 * @return false p is not hazard pointer
+	 */
+	bool contains( const void* p ) const noexcept;
+
+	size_t size( void ) const noexcept
+	{
+		return size_;
+	}
+
+private:
+	static constexpr size_t kInlineCapacity = 64;
+
+	void push_back( const void* p ) noexcept;
+	void sort( void ) noexcept;
+	void release_overflow_buff( void ) noexcept;
+
+	const void* const* data( void ) const noexcept
+	{
+		return ( p_overflow_buff_ != nullptr ) ? p_overflow_buff_ : inline_buff_;
+	}
+
+	const void*  inline_buff_[kInlineCapacity];
+	const void** p_overflow_buff_;          //!< buffer when the number of hazard pointers exceeds kInlineCapacity. nullptr means inline_buff_ is used
+	bool         is_overflow_buff_owned_;   //!< true: p_overflow_buff_ is owned by this snapshot. false: p_overflow_buff_ is borrowed from the thread local cache
+	size_t       size_;
+	size_t       capacity_;
+	bool         is_incomplete_;   //!< true: fail to allocate buffer. contains() falls back to hazard_ptr_mgr::CheckPtrIsHazardPtr()
+
+	friend class global_scope_hazard_ptr_chain;
+	friend class hazard_ptr_group;
+};
+
 /////////////////////////////////////////////////////////////////
 class hazard_ptr_mgr {
 public:
+	using retire_deleter_t = void ( * )( void* );   //!< deleter type for Retire()
+
 	/**
 	 * @brief assign a slot of hazard pointer and set the pointer
 	 *
@@ -67,6 +158,17 @@ public:
 	 */
 	static hzrd_slot_ownership_t AssignHazardPtrSlot( const void* p );
 
+	/**
+	 * @brief assign n slots of hazard pointer at once
+	 *
+	 * Each assigned slot is set as the slot that has no hazard pointer, but is in use.
+	 * The hazard pointer slots of the calling thread are walked only once.
+	 *
+	 * @param p_out pointer to the array of hzrd_slot_ownership_t that has n elements at least.
+	 * @param n the number of slots to assign
+	 */
+	static void AssignHazardPtrSlots( hzrd_slot_ownership_t* p_out, size_t n );
+
 	/**
 	 * @brief Check if p is still in hazard pointer list or not
 	 *
@@ -76,6 +178,21 @@ public:
 	 */
 	static bool CheckPtrIsHazardPtr( void* p ) noexcept;
 
+	/**
+	 * @brief Check if p may be in hazard pointer list or not, without the heavy side fence
+	 *
+	 * This does not issue membarrier() even if ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE is defined.
+	 * In that case, a hazard pointer that is being set by a reader may be invisible without membarrier().
+	 * Therefore, if membarrier() is available, this always returns true, and the decision is delegated to the scan like TakeSnapshot() that issues membarrier() once for a batch.
+	 * Please use this API only to decide whether the pointer can be moved to a list that is checked by such scan later.
+	 * If membarrier() is not available or ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE is not defined, this is same to CheckPtrIsHazardPtr().
+	 *
+	 * @param p
+	 * @return true p is still listed in hazard pointer list, or may be hazard pointer
+	 * @return false p is not hazard pointer
+	 */
+	static bool CheckPtrMayBeHazardPtr( void* p ) noexcept;
+
 	/**
 	 * @brief Check if p is still in hazard pointer list or not
 	 *
@@ -83,6 +200,57 @@ public:
 	 */
 	static void ScanHazardPtrs( std::function<void( const void* )> pred );
 
+	/**
+	 * @brief gather all hazard pointers at this time
+	 *
+	 * If you check many pointers, please use this API and hazard_ptr_snapshot::contains() instead of calling CheckPtrIsHazardPtr() for each pointer.
+	 *
+	 * @return hazard_ptr_snapshot snapshot of all hazard pointers
+	 */
+	static hazard_ptr_snapshot TakeSnapshot( void ) noexcept;
+
+	/**
+	 * @brief retire p, and call deleter( p ) after p becomes not hazard pointer
+	 *
+	 * p is kept in the retired list of the calling thread.
+	 * When the size of the list exceeds the threshold that is proportional to the number of hazard pointer slots,
+	 * the list is checked with one snapshot of hazard pointers, and deleter is called for the pointers that are not hazard pointer.
+	 * Therefore, the amortized cost of this API is O(1).
+	 *
+	 * If the thread exits, the remaining pointers are moved to the global list and are reclaimed by other thread or DrainRetired().
+	 *
+	 * The retired list is allocated by gmem_allocate(). If the list could not be extended,
+	 * this API waits for p to become not hazard pointer and calls deleter( p ) synchronously instead of throwing std::bad_alloc.
+	 *
+	 * @pre p should be unreachable from the shared data structure before calling this API.
+	 * @pre deleter should not throw any exception.
+	 *
+	 * @param p pointer to retire. if p is nullptr, do nothing.
+	 * @param deleter function to release p
+	 */
+	static void Retire( void* p, retire_deleter_t deleter ) noexcept;
+
+	/**
+	 * @brief retire p, and call delete p after p becomes not hazard pointer
+	 *
+	 * @tparam T type of object
+	 * @param p pointer to retire
+	 */
+	template <typename T>
+	static void Retire( T* p ) noexcept
+	{
+		Retire( static_cast<void*>( p ), []( void* p_arg ) { delete static_cast<T*>( p_arg ); } );
+	}
+
+	/**
+	 * @brief reclaim the retired pointers of the calling thread and the retired pointers that are left by exited threads
+	 *
+	 * This API is for shutdown or the timing that the application would like to release memory.
+	 *
+	 * @return size_t the number of retired pointers that are still hazard pointer and could not be reclaimed
+	 */
+	static size_t DrainRetired( void );
+
 	/**
 	 * @brief remove all hazard_ptr_group from internal global variable
 	 *
@@ -12,12 +12,18 @@
 #ifndef ALCONCURRENT_INC_INTERNAL_OD_LOCKFREE_FIFO_HPP_
 #define ALCONCURRENT_INC_INTERNAL_OD_LOCKFREE_FIFO_HPP_
 
+#include "alconcurrent/internal/od_lockfree_fifo_engine.hpp"
 #include "alconcurrent/internal/od_node_essence.hpp"
 
 namespace alpha {
 namespace concurrent {
 namespace internal {
 
+/**
+ * @brief lock-free fifo of od_node_link_by_hazard_handler
+ *
+ * This is a thin wrapper of od_lockfree_fifo_engine that picks up the value by virtual function callback_to_pick_up_value() and void* context.
+ */
 class od_lockfree_fifo {
 public:
 	using node_pointer = od_node_link_by_hazard_handler*;
@@ -47,6 +53,14 @@ public:
 	 */
 	void push_back( node_pointer p_nd ) noexcept;
 
+	/**
+	 * @brief 事前にnext()でつないだノード列を、1回のCASでFIFOの最後にpushする
+	 *
+	 * @param p_first pushするノード列の先頭ノードへのポインタ
+	 * @param p_last pushするノード列の最後のノードへのポインタ。p_firstからnext()をたどってp_lastに到達できること。
+	 */
+	void push_back_chain( node_pointer p_first, node_pointer p_last ) noexcept;
+
 	/**
 	 * @brief ノードをFIFOの先頭からpopする
 	 *
@@ -55,6 +69,19 @@ public:
 	 */
 	ALCC_INTERNAL_NODISCARD_ATTR node_pointer pop_front( void* p_context_local_data ) noexcept;
 
+	/**
+	 * @brief 最大max_n個のノードを、1回のheadの更新でFIFOの先頭からpopする
+	 *
+	 * 値を保持するノードのうち、最後のノードは新たな番兵ノードとなるため、そのノードの値のみcallback_to_pick_up_value()で渡す。
+	 * それ以外の値を保持するノードは、所有権と共にpopされたノード列として返す。
+	 *
+	 * @param p_context_local_data 仮想関数callback_to_pick_up_value()の第2引数として渡すポインタ
+	 * @param max_n popするノードの最大数
+	 * @param pp_popped_head [out] popされたノード列の先頭ノード(古い番兵ノード)。next()でたどれる戻り値の個数分のノードの所有権を持つ。先頭ノード以外は値を保持している。
+	 * @return popされたノードの個数。callback_to_pick_up_value()で渡された値を含めた、取り出した値の個数と同じ。
+	 */
+	ALCC_INTERNAL_NODISCARD_ATTR size_t pop_front_bulk( void* p_context_local_data, size_t max_n, node_pointer* pp_popped_head ) noexcept;
+
 	/**
 	 * @brief ノードをFIFOの先頭にpushする
 	 *
@@ -101,18 +128,7 @@ protected:
 	virtual void do_for_purged_node( node_pointer p_nd ) noexcept;
 
 private:
-	using hazard_ptr_handler_t = typename od_node_link_by_hazard_handler::hazard_ptr_handler_t;
-	using hazard_pointer       = typename od_node_link_by_hazard_handler::hazard_pointer;
-
-	hazard_ptr_handler_t hph_head_;
-	hazard_ptr_handler_t hph_tail_;
-#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
-	std::atomic<size_t> count_;
-#endif
-#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
-	std::atomic<size_t> pushpop_count_;
-	std::atomic<size_t> pushpop_loop_count_;
-#endif
+	od_lockfree_fifo_engine<od_node_link_by_hazard_handler> engine_;
 };
 
 }   // namespace internal
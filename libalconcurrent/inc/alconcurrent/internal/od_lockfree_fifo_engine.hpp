@@ -0,0 +1,514 @@
+/**
+ * @file od_lockfree_fifo_engine.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief header only lock-free fifo engine that picks up a value by compile-time policy
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * The value is picked up by a functor that is given as template parameter.
+ * od_lockfree_fifo is a thin wrapper of this engine that picks up the value by virtual function callback_to_pick_up_value() and void* context.
+ */
+
+#ifndef ALCONCURRENT_INC_INTERNAL_OD_LOCKFREE_FIFO_ENGINE_HPP_
+#define ALCONCURRENT_INC_INTERNAL_OD_LOCKFREE_FIFO_ENGINE_HPP_
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "alconcurrent/conf_logger.hpp"
+#include "alconcurrent/internal/od_node_essence.hpp"
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+/**
+ * @brief lock-free fifo engine of the nodes that is a derived class of od_node_link_by_hazard_handler
+ *
+ * @tparam NODE_T node type. this should be a derived class of od_node_link_by_hazard_handler
+ */
+template <typename NODE_T>
+class od_lockfree_fifo_engine {
+public:
+	static_assert( std::is_base_of<od_node_link_by_hazard_handler, NODE_T>::value, "NODE_T should be a derived class of od_node_link_by_hazard_handler" );
+
+	using node_type    = NODE_T;
+	using node_pointer = NODE_T*;
+
+	od_lockfree_fifo_engine( node_pointer p_sentinel ) noexcept
+	  : hph_head_( p_sentinel )
+	  , hph_tail_( p_sentinel )
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+	  , count_( 0 )
+#endif
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+	  , pushpop_count_( 0 )
+	  , pushpop_loop_count_( 0 )
+#endif
+	{
+		if ( p_sentinel != nullptr ) {
+			link_of( p_sentinel )->set_next( nullptr );
+		}
+	}
+
+	/**
+	 * @brief move constructor
+	 *
+	 * @warning
+	 * This move constructor is NOT thread-safe, because this api is not consider the concurrency.
+	 *
+	 * @warning
+	 * src become invalid object. if you would like to reuse src, please call introduce_sentinel_node() with new sentinel node.
+	 */
+	od_lockfree_fifo_engine( od_lockfree_fifo_engine&& src ) noexcept
+	  : hph_head_( std::move( src.hph_head_ ) )
+	  , hph_tail_( std::move( src.hph_tail_ ) )
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+	  , count_( src.count_.exchange( 0, std::memory_order_acq_rel ) )
+#endif
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+	  , pushpop_count_( src.pushpop_count_.exchange( 0, std::memory_order_acq_rel ) )
+	  , pushpop_loop_count_( src.pushpop_loop_count_.exchange( 0, std::memory_order_acq_rel ) )
+#endif
+	{
+	}
+
+	~od_lockfree_fifo_engine()
+	{
+		// 本来は、release_sentinel_node()で、空っぽにしてから、破棄することがこのクラスを使う上での期待値
+		node_pointer p_cur = release_all_nodes();
+		if ( p_cur != nullptr ) {
+			LogOutput( log_type::WARN, "there is no call of release_sentinel_node()." );
+
+			while ( p_cur != nullptr ) {
+				node_pointer p_nxt = node_of( link_of( p_cur )->next() );
+				delete p_cur;
+				p_cur = p_nxt;
+			}
+		}
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+		LogOutput(
+			log_type::DUMP,
+			"node_fifo_lockfree_base statisc: push/pop call count = %zu, loop count = %zu, ratio =%f",
+			pushpop_count_.load(), pushpop_loop_count_.load(),
+			static_cast<double>( pushpop_loop_count_.load() ) / static_cast<double>( pushpop_count_.load() ) );
+#endif
+	}
+
+	od_lockfree_fifo_engine( const od_lockfree_fifo_engine& )            = delete;
+	od_lockfree_fifo_engine& operator=( const od_lockfree_fifo_engine& ) = delete;
+	od_lockfree_fifo_engine& operator=( od_lockfree_fifo_engine&& )      = delete;
+
+	/**
+	 * @brief ノードをFIFOの最後にpushする
+	 *
+	 * @param p_nd pushするノードへのポインタ
+	 */
+	void push_back( node_pointer p_nd ) noexcept
+	{
+		push_back_chain( p_nd, p_nd );
+	}
+
+	/**
+	 * @brief 事前にnext()でつないだノード列を、1回のCASでFIFOの最後にpushする
+	 *
+	 * @param p_first pushするノード列の先頭ノードへのポインタ
+	 * @param p_last pushするノード列の最後のノードへのポインタ。p_firstからnext()をたどってp_lastに到達できること。
+	 */
+	void push_back_chain( node_pointer p_first, node_pointer p_last ) noexcept
+	{
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+		pushpop_count_++;
+#endif
+		link_of( p_last )->set_next( nullptr );
+
+		hazard_pointer hp_tail_node = hph_tail_.get_to_verify_exchange();
+		while ( true ) {
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+			pushpop_loop_count_++;
+#endif
+			if ( !hph_tail_.verify_exchange( hp_tail_node ) ) {
+				continue;
+			}
+			typename hazard_pointer::pointer p_tail_next = hp_tail_node->hazard_handler_of_next().load();
+			if ( p_tail_next != nullptr ) {
+				// tailがまだ最後のノードを指していないので、更新して、やり直す。
+				hph_tail_.compare_exchange_strong_to_verify_exchange1( hp_tail_node, p_tail_next );
+				continue;
+			}
+
+			if ( hp_tail_node->hazard_handler_of_next().compare_exchange_strong( p_tail_next, link_of( p_first ) ) ) {
+				// ここに来た時点で、push_backは成功
+				// hph_tail_を可能であれば、更新する。ここで、更新できなくても、自スレッドを含むどこかのスレッドでのpop/pushの際に、うまく更新される。
+				hph_tail_.compare_exchange_weak( std::move( hp_tail_node ), link_of( p_last ) );
+				break;
+			}
+		}
+
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+		for ( link_pointer p_cur = link_of( p_first ); p_cur != nullptr; p_cur = p_cur->next() ) {
+			count_++;
+			if ( p_cur == link_of( p_last ) ) break;
+		}
+#endif
+	}
+
+	/**
+	 * @brief ノードをFIFOの先頭からpopする
+	 *
+	 * @param pick_up popの成功が確定した後に、値が入っているノードを引数にして1回だけ呼び出されるファンクタ。void( node_type& )として呼び出し可能であること。
+	 * @return popされたノード。なお、このノードが保持している情報に対する参照権を持たない。そのため、中の情報を読み出してはならない。
+	 */
+	template <typename PICKER>
+	ALCC_INTERNAL_NODISCARD_ATTR node_pointer pop_front( PICKER&& pick_up ) noexcept
+	{
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+		pushpop_count_++;
+#endif
+		hazard_slot_set<2> hss;   // head/head_nextの2つのスロットをまとめて確保する
+		hazard_pointer     hp_head_node( hss, hph_head_.load() );
+		hazard_pointer     hp_head_next( hss );
+		while ( true ) {
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+			pushpop_loop_count_++;
+#endif
+			if ( !hph_head_.verify_exchange( hp_head_node ) ) {
+				continue;
+			}
+
+			typename hazard_pointer::pointer p_head_next = hp_head_node->hazard_handler_of_next().load();
+			if ( p_head_next == nullptr ) {
+				// 番兵ノードしかないので、FIFOキューは空。
+				return nullptr;
+			}
+
+			typename hazard_pointer::pointer p_tail_node = hph_tail_.load();
+			if ( hp_head_node == p_tail_node ) {
+				// ここに来た場合、番兵ノードしかないように見えるが、Tailはまだ更新されていないので、tailを更新する。
+				hph_tail_.compare_exchange_strong( p_tail_node, p_head_next );
+			}
+
+			hp_head_next.store( p_head_next );
+			if ( !hp_head_node->hazard_handler_of_next().verify_exchange( hp_head_next ) ) {
+				continue;
+			}
+
+			if ( hph_head_.compare_exchange_strong_to_verify_exchange2( hp_head_node, hp_head_next.get() ) ) {
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+				count_--;
+#endif
+				// hp_head_nextから値を取り出す権利を獲得。かつ、hp_head_nextはハザードポインタとして登録済みのため、参照可能。
+				pick_up( *node_of( hp_head_next.get() ) );
+
+				return node_of( hp_head_node.get() );
+			}
+		}
+	}
+
+	/**
+	 * @brief 最大max_n個のノードを、1回のheadの更新でFIFOの先頭からpopする
+	 *
+	 * 値を保持するノードのうち、最後のノードは新たな番兵ノードとなるため、そのノードの値のみpick_upで渡す。
+	 * それ以外の値を保持するノードは、所有権と共にpopされたノード列として返す。
+	 *
+	 * @param pick_up popの成功が確定した後に、新たな番兵ノードを引数にして1回だけ呼び出されるファンクタ。void( node_type& )として呼び出し可能であること。
+	 * @param max_n popするノードの最大数
+	 * @param pp_popped_head [out] popされたノード列の先頭ノード(古い番兵ノード)。next()でたどれる戻り値の個数分のノードの所有権を持つ。先頭ノード以外は値を保持している。
+	 * @return popされたノードの個数。pick_upで渡された値を含めた、取り出した値の個数と同じ。
+	 */
+	template <typename PICKER>
+	ALCC_INTERNAL_NODISCARD_ATTR size_t pop_front_bulk( PICKER&& pick_up, size_t max_n, node_pointer* pp_popped_head ) noexcept
+	{
+		*pp_popped_head = nullptr;
+		if ( max_n == 0 ) return 0;
+
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+		pushpop_count_++;
+#endif
+		hazard_slot_set<3> hss;   // head/走査中のノード/その次のノードの3つのスロットをまとめて確保する
+		hazard_pointer     hp_head_node( hss, hph_head_.load() );
+		hazard_pointer     hp_cur( hss );
+		hazard_pointer     hp_next( hss );
+		while ( true ) {
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+			pushpop_loop_count_++;
+#endif
+			if ( !hph_head_.verify_exchange( hp_head_node ) ) {
+				continue;
+			}
+
+			typename hazard_pointer::pointer p_head_next = hp_head_node->hazard_handler_of_next().load();
+			if ( p_head_next == nullptr ) {
+				// 番兵ノードしかないので、FIFOキューは空。
+				return 0;
+			}
+
+			typename hazard_pointer::pointer p_tail_node = hph_tail_.load();
+			if ( hp_head_node == p_tail_node ) {
+				// tailを追い越してheadを更新しないように、tailを先に進める。
+				hph_tail_.compare_exchange_strong( p_tail_node, p_head_next );
+			}
+
+			hp_cur.store( p_head_next );
+			if ( hph_head_.load() != hp_head_node.get() ) {
+				continue;
+			}
+
+			// headが変わっていない間は、headより後ろのノードはpopされず、再利用もされない。
+			// そのため、ハザードポインタを登録した後にheadが変わっていないことを確認できれば、そのノードは参照可能。
+			size_t n        = 1;
+			bool   is_retry = false;
+			while ( n < max_n ) {
+				typename hazard_pointer::pointer p_next = hp_cur->hazard_handler_of_next().load();
+				if ( p_next == nullptr ) break;
+
+				p_tail_node = hph_tail_.load();
+				if ( hp_cur == p_tail_node ) {
+					// tailを追い越してheadを更新しないように、tailを先に進める。
+					hph_tail_.compare_exchange_strong( p_tail_node, p_next );
+				}
+
+				hp_next.store( p_next );
+				if ( hph_head_.load() != hp_head_node.get() ) {
+					is_retry = true;
+					break;
+				}
+				hp_cur.swap( hp_next );
+				n++;
+			}
+			if ( is_retry ) {
+				continue;
+			}
+
+			if ( hph_head_.compare_exchange_strong_to_verify_exchange2( hp_head_node, hp_cur.get() ) ) {
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+				count_ -= n;
+#endif
+				// hp_curが新たな番兵ノードとなる。hp_curはハザードポインタとして登録済みのため、参照可能。
+				pick_up( *node_of( hp_cur.get() ) );
+
+				*pp_popped_head = node_of( hp_head_node.get() );
+				return n;
+			}
+		}
+	}
+
+	/**
+	 * @brief ノードをFIFOの先頭にpushする
+	 *
+	 * @param p_node_new_sentinel 新たな番兵ノードへのポインタ
+	 * @param p_node_w_value FIFOに挿入する情報を保持するノードへのポインタ
+	 * @return 不要となったsentinelノードへのポインタ。
+	 */
+	ALCC_INTERNAL_NODISCARD_ATTR node_pointer push_front( node_pointer p_node_new_sentinel, node_pointer p_node_w_value ) noexcept
+	{
+		if ( p_node_new_sentinel == nullptr ) return p_node_w_value;
+		if ( p_node_w_value == nullptr ) return p_node_new_sentinel;
+
+		link_pointer p_new_sentinel = link_of( p_node_new_sentinel );
+		link_pointer p_w_value      = link_of( p_node_w_value );
+		p_new_sentinel->set_next( p_w_value );
+
+		hazard_pointer hp_head_node = hph_head_.get_to_verify_exchange();
+		hazard_pointer hp_head_next;
+		while ( true ) {
+			if ( !hph_head_.verify_exchange( hp_head_node ) ) {
+				continue;
+			}
+
+			typename hazard_pointer::pointer p_head_next = hp_head_node->hazard_handler_of_next().load();
+			if ( p_head_next == nullptr ) {
+				// 番兵ノードしかないので、FIFOキューは空。
+				// push_backしても結果は同じなので、push_backを試みる。
+				hazard_pointer hp_tail_node = hph_tail_.get_to_verify_exchange();
+				if ( !hph_tail_.verify_exchange( hp_tail_node ) ) {
+					continue;
+				}
+				typename hazard_pointer::pointer p_tail_next = hp_tail_node->hazard_handler_of_next().load();
+				if ( p_tail_next != nullptr ) {
+					// 別のスレッドがpush_backしたので、tailがまだ最後のノードを指していない。更新して、やり直す。
+					hph_tail_.compare_exchange_strong_to_verify_exchange2( hp_tail_node, p_tail_next );
+					continue;
+				}
+
+				p_w_value->set_next( nullptr );
+				if ( hp_tail_node->hazard_handler_of_next().compare_exchange_strong( p_tail_next, p_w_value ) ) {
+					// push_backに成功した。使用しなかったp_node_new_sentinelを返す。
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+					count_++;
+#endif
+					return p_node_new_sentinel;
+				}
+
+				// すでにだれかが、push_backかpush_front内のpush_backを成功させたので、最初からやり直す。
+				continue;
+			}
+
+			typename hazard_pointer::pointer p_tail_node = hph_tail_.load();
+			if ( hp_head_node == p_tail_node ) {
+				// ここに来た場合、番兵ノードしかないように見えるが、Tailはまだ更新されていないので、tailを更新する。
+				hph_tail_.compare_exchange_strong( p_tail_node, p_head_next );
+			}
+
+			hp_head_next.store( p_head_next );
+			if ( !hp_head_node->hazard_handler_of_next().verify_exchange( hp_head_next ) ) {
+				continue;
+			}
+
+			p_w_value->set_next( p_head_next );
+			if ( hph_head_.compare_exchange_strong_to_verify_exchange2( hp_head_node, p_new_sentinel ) ) {
+				// push_frontとしてのノードの挿入と、古いsentinelの取り出しと所有権確保が完了
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+				count_++;
+#endif
+				return node_of( hp_head_node.get() );
+			}
+		}
+	}
+
+	ALCC_INTERNAL_NODISCARD_ATTR node_pointer release_sentinel_node( void ) noexcept
+	{
+		if ( !is_empty() ) {
+			LogOutput( log_type::ERR, "ERR: calling condition is not expected. Before calling release_sentinel_node, this instance should be empty. therefore, now leak all remaining nodes." );
+		}
+
+		link_pointer p_ans = hph_head_.load();
+		if ( p_ans == nullptr ) {
+			LogOutput( log_type::WARN, "WARN: sentinel node has already released." );
+			return nullptr;
+		}
+
+		hph_head_.store( nullptr );
+		hph_tail_.store( nullptr );
+
+		return node_of( p_ans );
+	}
+
+	/**
+	 * @brief invalid状態のインスタンスに番兵ノードを追加し、利用可能状態に戻す。
+	 *
+	 * @param p_sentinel
+	 * @return node_pointer if node_pointer is nullptr, success. if node_pointer is not nullptr, fail and return value is same to p_sentinel
+	 */
+	ALCC_INTERNAL_NODISCARD_ATTR node_pointer introduce_sentinel_node( node_pointer p_sentinel ) noexcept
+	{
+		if ( !is_empty() ) {
+			LogOutput( log_type::ERR, "ERR: instance is not empty and also sentinel node is there. Before calling introduce_sentinel_node, instance should be invalid." );
+			return p_sentinel;
+		}
+
+		if ( hph_head_.load() != nullptr ) {
+			LogOutput( log_type::ERR, "ERR: sentinel node is there. Before calling introduce_sentinel_node, instance should be released sentinel node." );
+			return p_sentinel;
+		}
+
+		link_of( p_sentinel )->set_next( nullptr );
+		hph_head_.store( link_of( p_sentinel ) );
+		hph_tail_.store( link_of( p_sentinel ) );
+
+		return nullptr;
+	}
+
+	/**
+	 * @brief 番兵ノードを含む全ノードを、先頭ノードからnext()でたどれるノード列として取り出し、invalid状態にする。
+	 *
+	 * @warning
+	 * This api is NOT thread-safe. This is for the destructor.
+	 *
+	 * @return 取り出したノード列の先頭ノード(番兵ノード)。番兵ノードが解放済みの場合、nullptr
+	 */
+	ALCC_INTERNAL_NODISCARD_ATTR node_pointer release_all_nodes( void ) noexcept
+	{
+		link_pointer p_ans = hph_head_.load();
+		hph_head_.store( nullptr );
+		hph_tail_.store( nullptr );
+		return node_of( p_ans );
+	}
+
+	bool is_empty( void ) const
+	{
+		hazard_pointer hp_head_node = hph_head_.get_to_verify_exchange();
+
+		if ( hp_head_node == nullptr ) {
+			LogOutput( log_type::WARN, "WARN: is_empty() is called, but Sentinel node has been released already." );
+			return true;
+		}
+
+		return hp_head_node->hazard_handler_of_next().load() == nullptr;
+	}
+
+	size_t count_size( void ) const
+	{
+		size_t                      ans       = 0;
+		const hazard_ptr_handler_t* p_hph_cur = &hph_head_;
+		hazard_pointer              hp_pre_node;
+		hazard_pointer              hp_cur_node = p_hph_cur->get_to_verify_exchange();
+		hazard_pointer              hp_nxt_node;
+		while ( true ) {
+			if ( !p_hph_cur->verify_exchange( hp_cur_node ) ) {
+				continue;
+			}
+			if ( hp_cur_node == nullptr ) {
+				// 番兵が解放済みの場合、ここに到達する。
+				break;
+			}
+
+			hp_nxt_node = hp_cur_node->hazard_handler_of_next().get_to_verify_exchange();
+			while ( !hp_cur_node->hazard_handler_of_next().verify_exchange( hp_nxt_node ) ) {}
+			if ( hp_nxt_node == nullptr ) {
+				// 番兵ノード、あるいは末端に到達したので、ループを終了する。
+				break;
+			}
+			ans++;
+
+			// 次のノードに進める
+			hp_pre_node.swap( hp_cur_node );
+			hp_cur_node.swap( hp_nxt_node );
+			p_hph_cur = &( hp_pre_node->hazard_handler_of_next() );
+		}
+
+		return ans;
+	}
+
+	size_t profile_info_count( void ) const
+	{
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+		return count_.load( std::memory_order_acquire );
+#else
+		return 0;
+#endif
+	}
+
+private:
+	using link_pointer         = od_node_link_by_hazard_handler*;
+	using hazard_ptr_handler_t = typename od_node_link_by_hazard_handler::hazard_ptr_handler_t;
+	using hazard_pointer       = typename od_node_link_by_hazard_handler::hazard_pointer;
+
+	static link_pointer link_of( node_pointer p_nd ) noexcept
+	{
+		return static_cast<link_pointer>( p_nd );
+	}
+	static node_pointer node_of( link_pointer p_link ) noexcept
+	{
+		return static_cast<node_pointer>( p_link );   // FIFOに保管されているノードはnode_pointerであることを保証しているため、static_castを使用する。
+	}
+
+	hazard_ptr_handler_t hph_head_;
+	hazard_ptr_handler_t hph_tail_;
+#ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
+	std::atomic<size_t> count_;
+#endif
+#ifdef ALCONCURRENT_CONF_ENABLE_DETAIL_STATISTICS_MESUREMENT
+	std::atomic<size_t> pushpop_count_;
+	std::atomic<size_t> pushpop_loop_count_;
+#endif
+};
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
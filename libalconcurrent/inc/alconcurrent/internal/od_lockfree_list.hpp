@@ -229,6 +229,16 @@ public:
 	 */
 	size_t count_size( void ) const noexcept;
 
+	/**
+	 * @brief 有効なノードがないかを調べる
+	 *
+	 * 先頭から削除マークのついたノードを読み飛ばすだけで、リスト全体の数え上げは行わない。
+	 *
+	 * @return true 有効なノードがない
+	 * @return false 有効なノードがある
+	 */
+	bool is_empty( void ) const;
+
 	/*!
 	 * @brief	インスタンス内で保持している終端ノード（番兵ノード）かどうかを調べる。
 	 *
@@ -99,8 +99,8 @@ private:
 };
 #endif
 
-constexpr size_t scan_check_trial_threshold       = 50;
 constexpr size_t aggressive_aggregation_threshold = 20;
+constexpr size_t scan_check_trial_threshold       = aggressive_aggregation_threshold * 2;   //!< 非対称フェンス使用時は全ノードが一旦ハザードポインタ登録中のリストに入るため、グローバルなリストへ移す閾値と揃える
 
 struct is_member_function_callable_impl {
 	template <typename T>
@@ -132,49 +132,48 @@ public:
 		++node_count_total_;
 #endif
 
-		if ( hazard_ptr_mgr::CheckPtrIsHazardPtr( p_nd->get_pointer_of_hazard_check() ) ) {
-			// スレッドローカルのハザードポインタ登録中のリストが大きくなりすぎていたら、まとめて棚卸をする。
+		tl_od_node_list& tl_odn_list_no_in_hazard = get_tl_odn_list_no_in_hazard();
+		if ( hazard_ptr_mgr::CheckPtrMayBeHazardPtr( p_nd->get_pointer_of_hazard_check() ) ) {
+			// 非対称フェンス使用時のCheckPtrMayBeHazardPtr()はハザードポインタ登録中とみなすため、判定は棚卸時のスキャンにまとめて任せる。
 			tl_od_node_list& tl_odn_list_still_in_hazard = get_tl_odn_list_still_in_hazard();
-			if ( tl_odn_list_still_in_hazard.size() >= scan_check_trial_threshold ) {
-				tl_od_node_list& tl_odn_list_no_in_hazard = get_tl_odn_list_no_in_hazard();
-				node_pointer     p_ans                    = try_pop_from_still_in_hazard_list(
-                    tl_odn_list_still_in_hazard.move_to(),
-                    tl_odn_list_still_in_hazard,
-                    tl_odn_list_no_in_hazard );
-				if ( p_ans != nullptr ) {
-					tl_odn_list_no_in_hazard.push_back( p_ans );
-				}
-			}
 			tl_odn_list_still_in_hazard.push_back( p_nd );
-			return;
-		}
-		reset_value_of_node( p_nd );
-
-		tl_od_node_list& tl_odn_list_no_in_hazard = get_tl_odn_list_no_in_hazard();
-
-		// スレッドローカルな変数に格納されているノードが少なかったら、スレッドローカルな変数に保存する。
-		// 「少ない」の判定を簡単にするために、判定が簡単な1以下で少ないと判定している。
-		// こうすることで、スレッドローカルなノードの再利用の機会が増え、新たなノードの割り当てによるメモリ消費を抑制できる。
-		if ( !tl_odn_list_no_in_hazard.is_more_than_one() ) {
-			tl_odn_list_no_in_hazard.push_back( p_nd );
-			return;
-		}
-
-		auto lk = g_odn_list_no_in_hazard_.try_lock();
-		if ( lk.owns_lock() ) {
-			lk.ref().push_back( p_nd );   // ロック付きリストのロックを取得できたので、ロック付きリストに登録
-			return;
-		}
+			if ( tl_odn_list_still_in_hazard.size() < scan_check_trial_threshold ) {
+				return;
+			}
 
-		if ( tl_odn_list_no_in_hazard.size() >= aggressive_aggregation_threshold ) {
-			g_odn_lockfree_list_no_in_hazard_.push_front( p_nd );
-			g_odn_lockfree_list_no_in_hazard_.push_front( static_cast<node_pointer>( tl_odn_list_no_in_hazard.pop_front() ) );
+			// スレッドローカルのハザードポインタ登録中のリストが大きくなったら、まとめて棚卸をする。
+			node_pointer p_ans = try_pop_from_still_in_hazard_list(
+				tl_odn_list_still_in_hazard.move_to(),
+				tl_odn_list_still_in_hazard,
+				tl_odn_list_no_in_hazard );
+			if ( p_ans != nullptr ) {
+				reset_value_of_node( p_ans );
+				tl_odn_list_no_in_hazard.push_back( p_ans );
+			}
 		} else {
+			reset_value_of_node( p_nd );
 			tl_odn_list_no_in_hazard.push_back( p_nd );   // スレッドローカルな変数に保存する。
 		}
+
+		// スレッドローカルな変数に格納されているノードが多くなったら、まとめてグローバルなリストへ移す。
+		// ノード1つずつではなく、リンク済みのノード群を1回のCASで移すことで、生産専用スレッドと消費専用スレッドの間でのノードの受け渡しのコストを抑える。
+		// 棚卸で一度に複数バッチ分が増えることがあるため、閾値を下回るまで移す。
+		while ( tl_odn_list_no_in_hazard.size() >= ( aggressive_aggregation_threshold * 2 ) ) {
+			g_odn_lockfree_list_no_in_hazard_.push_batch( tl_odn_list_no_in_hazard, aggressive_aggregation_threshold );
+		}
 		return;
 	}
 
+	/**
+	 * @brief 再利用可能なノードを取り出す
+	 *
+	 * グローバルなリストはロックを使わずに切り離して検査する。切り離している間、他スレッドからはグローバルなリストが空に見えるため、
+	 * グローバルなリストから取り出せなかった場合は、他スレッドの切り離しの完了を待ってから、グローバルなリストを再確認する。
+	 * よって、nullptrが返るのは、グローバルなリストに再利用可能なノードが残っていない場合に限られる。
+	 * なお、他スレッドのスレッドローカルなリストにあるノードは、このスレッドからは取り出せない。
+	 *
+	 * @return node_pointer 取り出したノードへのポインタ。nullptrの場合、このスレッドから取り出せるノードがなかったことを示す。
+	 */
 	static node_pointer pop( void )
 	{
 		tl_od_node_list& tl_odn_list_no_in_hazard = get_tl_odn_list_no_in_hazard();
@@ -187,55 +186,68 @@ public:
 			return static_cast<node_pointer>( p_ans_baseclass_node );   // このクラスが保持するノードはnode_typeであることをpush関数が保証しているので、dynamic_cast<>は不要。
 		}
 
-		{
-			auto lk = g_odn_list_no_in_hazard_.try_lock();
-			if ( lk.owns_lock() ) {
-				p_ans_baseclass_node = lk.ref().pop_front();
+		bool is_tl_still_in_hazard_checked = false;
+		while ( true ) {
+			// グローバルなリストから、リンク済みのノード群を1回のCASでまとめて取り出す。
+			if ( g_odn_lockfree_list_no_in_hazard_.pop_batch( tl_odn_list_no_in_hazard ) ) {
+				p_ans_baseclass_node = tl_odn_list_no_in_hazard.pop_front();
 				if ( p_ans_baseclass_node != nullptr ) {
-					if ( lk.ref().size() >= aggressive_aggregation_threshold ) {
-						for ( size_t i = 0; i < aggressive_aggregation_threshold; i++ ) {
-							g_odn_lockfree_list_no_in_hazard_.push_front( static_cast<node_pointer>( lk.ref().pop_front() ) );
-						}
-					}
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
 					--node_count_total_;
 #endif
 					return static_cast<node_pointer>( p_ans_baseclass_node );
 				}
 			}
-		}
 
-		{
-			auto p_baseclass_node = g_odn_lockfree_list_no_in_hazard_.pop_front();
-			if ( p_baseclass_node != nullptr ) {
+			if ( !g_odn_list_no_in_hazard_.is_empty() ) {
+				// 他スレッド終了時に引き受けたノード群を切り離す。切り離したノード群はこのスレッドだけが参照するため、ロックは不要。
+				raw_list tmp_odn_list = g_odn_list_no_in_hazard_.begin_detach();
+				p_ans_baseclass_node  = tmp_odn_list.pop_front();
+				for ( size_t i = 0; i < aggressive_aggregation_threshold; i++ ) {
+					typename tl_od_node_list::node_pointer p_nd = tmp_odn_list.pop_front();
+					if ( p_nd == nullptr ) break;
+					tl_odn_list_no_in_hazard.push_back( p_nd );
+				}
+				// 残りは、他スレッドも1回のCASで取り出せるよう、バッチに分けてロックフリースタックへ移す。
+				while ( !tmp_odn_list.is_empty() ) {
+					g_odn_lockfree_list_no_in_hazard_.push_batch( tmp_odn_list, aggressive_aggregation_threshold );
+				}
+				g_odn_list_no_in_hazard_.end_detach();
+				if ( p_ans_baseclass_node != nullptr ) {
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
-				--node_count_total_;
+					--node_count_total_;
 #endif
-				return static_cast<node_pointer>( p_baseclass_node );
+					return static_cast<node_pointer>( p_ans_baseclass_node );
+				}
 			}
-		}
 
-		{
-			// スレッドローカルのハザードポインタ登録中のリストの中から使えるノードを探す。
-			tl_od_node_list& tl_odn_list_still_in_hazard = get_tl_odn_list_still_in_hazard();
-			node_pointer     p_ans                       = try_pop_from_still_in_hazard_list(
-                tl_odn_list_still_in_hazard.move_to(),
-                tl_odn_list_still_in_hazard,
-                tl_odn_list_no_in_hazard );
-			if ( p_ans != nullptr ) {
+			if ( !is_tl_still_in_hazard_checked ) {
+				// スレッドローカルのハザードポインタ登録中のリストの中から使えるノードを探す。
+				is_tl_still_in_hazard_checked                = true;
+				tl_od_node_list& tl_odn_list_still_in_hazard = get_tl_odn_list_still_in_hazard();
+				node_pointer     p_ans                       = try_pop_from_still_in_hazard_list(
+                    tl_odn_list_still_in_hazard.move_to(),
+                    tl_odn_list_still_in_hazard,
+                    tl_odn_list_no_in_hazard );
+				if ( p_ans != nullptr ) {
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
-				--node_count_total_;
+					--node_count_total_;
 #endif
-				return p_ans;
+					return p_ans;
+				}
+				// 使えるノードがなかった
 			}
-			// 使えるノードがなかった
-		}
 
-		{
-			// グローバルのハザードポインタに登録中リストから使えるノードを探す。
-			auto lk = g_odn_list_still_in_hazard_.try_lock();
-			if ( lk.owns_lock() ) {
-				node_pointer p_ans = try_pop_from_still_in_hazard_list( std::move( lk.ref() ), lk.ref(), tl_odn_list_no_in_hazard );
+			if ( !g_odn_list_still_in_hazard_.is_empty() ) {
+				// グローバルのハザードポインタに登録中リストを切り離してから、ロックを保持せずに使えるノードを探す。
+				raw_list     tmp_still_in_hazard_list;
+				node_pointer p_ans = try_pop_from_still_in_hazard_list( g_odn_list_still_in_hazard_.begin_detach(), tmp_still_in_hazard_list, tl_odn_list_no_in_hazard );
+				g_odn_list_still_in_hazard_.merge_push_front( std::move( tmp_still_in_hazard_list ) );
+				// 見つかったノードをスレッドローカルなリストに溜め込まず、他スレッドも取り出せるようにロックフリースタックへ移す。
+				while ( tl_odn_list_no_in_hazard.size() > aggressive_aggregation_threshold ) {
+					g_odn_lockfree_list_no_in_hazard_.push_batch( tl_odn_list_no_in_hazard, aggressive_aggregation_threshold );
+				}
+				g_odn_list_still_in_hazard_.end_detach();
 				if ( p_ans != nullptr ) {
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
 					--node_count_total_;
@@ -244,9 +256,14 @@ public:
 				}
 				// 使えるノードがなかった
 			}
-		}
 
-		return nullptr;
+			// 他スレッドが切り離し中だった場合は、その完了を待ってから、グローバルなリストを再確認する。
+			bool is_waited_no_in_hazard    = g_odn_list_no_in_hazard_.wait_for_detaching_by_others();
+			bool is_waited_still_in_hazard = g_odn_list_still_in_hazard_.wait_for_detaching_by_others();
+			if ( !is_waited_no_in_hazard && !is_waited_still_in_hazard ) {
+				return nullptr;
+			}
+		}
 	}
 
 	static void clear_as_possible_as( void )
@@ -265,22 +282,17 @@ public:
 		}
 
 		{
-			auto lk = g_odn_list_no_in_hazard_.try_lock();
-			if ( lk.owns_lock() ) {
+			raw_list tmp_odn_list = g_odn_list_no_in_hazard_.detach_all();
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
-				node_count_total_.fetch_sub( lk.ref().size() );
+			node_count_total_.fetch_sub( tmp_odn_list.size() );
 #endif
-				lk.ref().clear();
-			}
+			tmp_odn_list.clear();
 		}
 
 		{
-			auto lk = g_odn_list_still_in_hazard_.try_lock();
-			if ( lk.owns_lock() ) {
-				raw_list check_target_list = std::move( lk.ref() );
-				check_hazard_then_clear( check_target_list );
-				lk.ref().merge_push_back( std::move( check_target_list ) );
-			}
+			raw_list check_target_list = g_odn_list_still_in_hazard_.detach_all();
+			check_hazard_then_clear( check_target_list );
+			g_odn_list_still_in_hazard_.merge_push_front( std::move( check_target_list ) );
 		}
 
 		return;
@@ -303,8 +315,8 @@ public:
 		ans = "Free nodes:";
 		ans += "\ttotal: " + std::to_string( node_count_total_ );
 		ans += "\ttl_odn_list_: " + std::to_string( tl_od_node_list::profile_info_all_tl_count() );
-		ans += "\tg_odn_list_non_hazard_: " + std::to_string( g_odn_list_no_in_hazard_.lock().ref().size() );
-		ans += "\tg_odn_list_still_in_hazard_: " + std::to_string( g_odn_list_still_in_hazard_.lock().ref().size() );
+		ans += "\tg_odn_list_non_hazard_: " + std::to_string( g_odn_list_no_in_hazard_.size() );
+		ans += "\tg_odn_list_still_in_hazard_: " + std::to_string( g_odn_list_still_in_hazard_.size() );
 #else
 		ans = "ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE is not enabled";
 #endif
@@ -315,7 +327,7 @@ public:
 private:
 	using const_node_pointer = const NODE_T*;
 	using raw_list           = od_simple_list;
-	using g_node_list_t      = od_simple_list_lockable;
+	using g_node_list_t      = od_simple_list_detachable;
 	using g_lockfree_list_t  = typename std::conditional<std::is_base_of<od_node_link_by_hazard_handler, NODE_T>::value, od_lockfree_stack, od_lockfree_stack_m>::type;
 
 	class tl_od_node_list
@@ -342,7 +354,7 @@ private:
 			// internal::LogOutput( log_type::DUMP, "this thread local nodes: %zu, current total thread local nodes: %zu", od_list_.size(), node_count_in_tl_odn_list_.load() );
 			node_count_in_tl_odn_list_ -= od_list_.size();
 #endif
-			ref_g_odn_list_.lock().ref().merge_push_back( std::move( od_list_ ) );
+			ref_g_odn_list_.merge_push_front( std::move( od_list_ ) );
 		}
 
 		void push_back( node_pointer p )
@@ -427,6 +439,72 @@ private:
 #endif
 	};
 
+	/**
+	 * @brief lock-free stack of node batches
+	 *
+	 * A batch is a chain of nodes that is linked by od_node_simple_link. Only the head node of a batch is pushed into the lock-free stack.
+	 * Therefore, push and pop of a batch need only one CAS operation.
+	 * The link of od_node_simple_link is not accessed by the lock-free stack, therefore the owner of the popped head node can access the rest of the batch safely.
+	 */
+	class g_lockfree_batch_stack {
+	public:
+		constexpr g_lockfree_batch_stack( void ) noexcept
+		  : lf_stack_()
+		{
+		}
+		~g_lockfree_batch_stack()
+		{
+			raw_list     tmp_odn_list;
+			node_pointer p_head = static_cast<node_pointer>( lf_stack_.pop_front() );
+			while ( p_head != nullptr ) {
+				tmp_odn_list.merge_push_back( static_cast<od_node_simple_link*>( p_head ) );
+				p_head = static_cast<node_pointer>( lf_stack_.pop_front() );
+			}
+		}
+
+		/**
+		 * @brief move num_of_nodes nodes from the front of src as one batch
+		 *
+		 * @tparam LIST_T tl_od_node_list or raw_list
+		 */
+		template <typename LIST_T>
+		void push_batch( LIST_T& src, size_t num_of_nodes )
+		{
+			od_node_simple_link* p_batch_head = src.pop_front();
+			if ( p_batch_head == nullptr ) return;
+
+			od_node_simple_link* p_cur = p_batch_head;
+			for ( size_t i = 1; i < num_of_nodes; i++ ) {
+				od_node_simple_link* p_nxt = src.pop_front();
+				if ( p_nxt == nullptr ) break;
+				p_cur->set_next( p_nxt );
+				p_cur = p_nxt;
+			}
+			p_cur->set_next( nullptr );
+
+			lf_stack_.push_front( static_cast<node_pointer>( p_batch_head ) );
+		}
+
+		/**
+		 * @brief move one batch to dst
+		 *
+		 * @return true: one batch is moved, false: no batch
+		 */
+		bool pop_batch( tl_od_node_list& dst )
+		{
+			node_pointer p_head = static_cast<node_pointer>( lf_stack_.pop_front() );
+			if ( p_head == nullptr ) return false;
+
+			raw_list tmp_odn_list;
+			tmp_odn_list.merge_push_back( static_cast<od_node_simple_link*>( p_head ) );
+			dst.merge_push_back( std::move( tmp_odn_list ) );
+			return true;
+		}
+
+	private:
+		g_lockfree_list_t lf_stack_;
+	};
+
 	template <typename U = NODE_T, typename std::enable_if<is_member_function_callable_reset_value<U>::value>::type* = nullptr>
 	static void reset_value_of_node( node_pointer p_nd )
 	{
@@ -456,12 +534,7 @@ private:
 		raw_list tmp_odn_list = std::move( check_target_list );
 
 		if ( !tmp_odn_list.is_empty() ) {
-			hazard_ptr_mgr::ScanHazardPtrs( [&tmp_odn_list, &check_target_list]( const void* p_in_hazard ) {
-				auto tt_n_list = tmp_odn_list.split_if( [p_in_hazard]( auto p_cur_node ) -> bool {
-					return p_in_hazard == static_cast<const_node_pointer>( p_cur_node )->get_pointer_of_hazard_check();   // pointerが同じならtrueを返す。
-				} );
-				check_target_list.merge_push_back( std::move( tt_n_list ) );
-			} );
+			check_target_list.merge_push_back( split_if_in_hazard( tmp_odn_list ) );
 		}
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
 		node_count_total_.fetch_sub( tmp_odn_list.size() );
@@ -496,16 +569,7 @@ private:
 			output_still_in_hazard_list.push_back( p_ans );
 			// 使えるノードがなかった
 		} else {
-			hazard_ptr_mgr::ScanHazardPtrs( [&tmp_odn_list, &output_still_in_hazard_list]( const void* p_in_hazard ) {
-				auto tt_n_list = tmp_odn_list.split_if( [p_in_hazard]( auto p_cur_node ) -> bool {
-					// cur_nodeの型は、od_node_simple_linkへの参照型で渡される。
-					// cur_nodeの本来の型は、od_node_poolが保持する型node_typeである。
-					// よって、ハザードポインタに登録されているポインタは、od_node_poolが保持する型node_typeへのポインタである。
-					// 従って、比較すべきポインタは、od_node_poolが保持する型node_typeのポインター型である必要がある。
-					return p_in_hazard == static_cast<const_node_pointer>( p_cur_node )->get_pointer_of_hazard_check();   // pointerが同じならtrueを返す。
-				} );
-				output_still_in_hazard_list.merge_push_back( std::move( tt_n_list ) );
-			} );
+			output_still_in_hazard_list.merge_push_back( split_if_in_hazard( tmp_odn_list ) );
 			typename tl_od_node_list::node_pointer p_ans_baseclass_node = tmp_odn_list.pop_front();
 			tmp_odn_list.for_each<node_pointer>( reset_value_of_node_wrap );
 			output_no_hazard_list.merge_push_back( std::move( tmp_odn_list ) );
@@ -528,28 +592,48 @@ private:
 	 */
 	static raw_list laundering_still_in_hazard_list( raw_list& still_in_hazard_list )
 	{
-		raw_list ans_odn_list;
-
-		hazard_ptr_mgr::ScanHazardPtrs( [&ans_odn_list, &still_in_hazard_list]( const void* p_in_hazard ) {
-			ans_odn_list = still_in_hazard_list.split_if( [p_in_hazard]( auto p_cur_node ) -> bool {
-				// cur_nodeの型は、od_node_simple_linkへの参照型で渡される。
-				// cur_nodeの本来の型は、od_node_poolが保持する型node_typeである。
-				// よって、ハザードポインタに登録されているポインタは、od_node_poolが保持する型node_typeへのポインタである。
-				// 従って、比較すべきポインタは、od_node_poolが保持する型node_typeのポインター型である必要がある。
-				return p_in_hazard == static_cast<const_node_pointer>( p_cur_node )->get_pointer_of_hazard_check();   // pointerが同じならtrueを返す。
+		raw_list ans_odn_list = std::move( still_in_hazard_list );
+		still_in_hazard_list  = split_if_in_hazard( ans_odn_list );
+		return ans_odn_list;
+	}
+
+	/**
+	 * @brief target_listから、ハザードポインタ登録中のノードを取り出す。
+	 *
+	 * ハザードポインタのスナップショットを1回だけ取得し、全ノードの検査で共有する。
+	 * そのため、検査コストは(ハザードポインタのスロット数)x(ノード数)に比例しない。
+	 * ただし、ノードが1つだけの場合は、スナップショットを取得せずに直接検査する。
+	 *
+	 * @pre target_listのノードは、すでに共有データ構造から到達不可能であること。
+	 *
+	 * @param target_list 検査対象のリスト。ハザードポインタ登録されていないノードが残る。
+	 * @return raw_list ハザードポインタ登録中のノードのリスト
+	 */
+	static raw_list split_if_in_hazard( raw_list& target_list )
+	{
+		if ( target_list.size() == 1 ) {
+			// ノードが1つだけなら、スナップショットを作るよりも直接検査する方が安い。
+			return target_list.split_if( []( auto p_cur_node ) -> bool {
+				return hazard_ptr_mgr::CheckPtrIsHazardPtr( const_cast<void*>( static_cast<const_node_pointer>( p_cur_node )->get_pointer_of_hazard_check() ) );
 			} );
-			still_in_hazard_list.swap( ans_odn_list );
-		} );
+		}
 
-		return ans_odn_list;
+		hazard_ptr_snapshot hzrd_snapshot = hazard_ptr_mgr::TakeSnapshot();
+		return target_list.split_if( [&hzrd_snapshot]( auto p_cur_node ) -> bool {
+			// cur_nodeの型は、od_node_simple_linkへのポインタ型で渡される。
+			// cur_nodeの本来の型は、od_node_poolが保持する型node_typeである。
+			// よって、ハザードポインタに登録されているポインタは、od_node_poolが保持する型node_typeへのポインタである。
+			// 従って、比較すべきポインタは、od_node_poolが保持する型node_typeのポインター型である必要がある。
+			return hzrd_snapshot.contains( static_cast<const_node_pointer>( p_cur_node )->get_pointer_of_hazard_check() );
+		} );
 	}
 
 	static tl_od_node_list& get_tl_odn_list_still_in_hazard( void );
 	static tl_od_node_list& get_tl_odn_list_no_in_hazard( void );
 
-	static g_lockfree_list_t g_odn_lockfree_list_no_in_hazard_;   //!< ハザードポインタに登録されていないノードを引き受けるためのグローバル変数。
-	static g_node_list_t     g_odn_list_no_in_hazard_;            //!< 他スレッド終了時等、共通プールとしてハザードポインタに登録されていないノードを引き受けるためのグローバル変数。
-	static g_node_list_t     g_odn_list_still_in_hazard_;         //!< 他スレッド終了時等、共通プールとしてハザードポインタに登録されているノードを引き受けるためのグローバル変数。
+	static g_lockfree_batch_stack g_odn_lockfree_list_no_in_hazard_;   //!< ハザードポインタに登録されていないノード群を引き受けるためのグローバル変数。
+	static g_node_list_t          g_odn_list_no_in_hazard_;            //!< 他スレッド終了時等、共通プールとしてハザードポインタに登録されていないノードを引き受けるためのグローバル変数。
+	static g_node_list_t          g_odn_list_still_in_hazard_;         //!< 他スレッド終了時等、共通プールとしてハザードポインタに登録されているノードを引き受けるためのグローバル変数。
 #ifdef ALCONCURRENT_CONF_ENABLE_COUNTERMEASURE_GCC_BUG_66944
 	static thread_local tl_od_node_list* x_tl_p_odn_list_still_in_hazard_;   //!< ハザードポインタに登録されている場合に、一時保管するためのリスト。へのポインタ。下の表現方法の代用。
 	static thread_local tl_od_node_list* x_tl_p_odn_list_no_in_hazard_;      //!< ハザードポインタに登録されている場合に、一時保管するためのリスト。へのポインタ。下の表現方法の代用。
@@ -563,7 +647,7 @@ private:
 };
 
 template <typename NODE_T>
-typename od_node_pool<NODE_T>::g_lockfree_list_t od_node_pool<NODE_T>::g_odn_lockfree_list_no_in_hazard_;
+typename od_node_pool<NODE_T>::g_lockfree_batch_stack od_node_pool<NODE_T>::g_odn_lockfree_list_no_in_hazard_;
 template <typename NODE_T>
 typename od_node_pool<NODE_T>::g_node_list_t od_node_pool<NODE_T>::g_odn_list_no_in_hazard_;
 template <typename NODE_T>
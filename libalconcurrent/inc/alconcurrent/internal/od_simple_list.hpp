@@ -12,6 +12,7 @@
 #ifndef ALCONCURRENT_INC_INTERNAL_OD_SIMPLE_LIST_HPP_
 #define ALCONCURRENT_INC_INTERNAL_OD_SIMPLE_LIST_HPP_
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <stdexcept>
@@ -124,6 +125,79 @@ private:
 	node_pointer p_head_ = nullptr;
 	node_pointer p_tail_ = nullptr;
 	size_t       count_  = 0;
+
+	friend class od_simple_list_detachable;
+};
+
+/**
+ * @brief od_simple_list list that supports lock-free merge and lock-free detach of all nodes
+ *
+ * merge_push_front() splices a list to the head by CAS, and detach_all() takes out all nodes by one exchange.
+ * Because the detached nodes are accessed only by the thread that detached them, this has no ABA problem and needs no hazard pointer.
+ * While a thread detaches the nodes, other threads see this list as empty.
+ * Therefore, a thread that detaches the nodes to check and return them uses begin_detach()/end_detach(),
+ * and a thread that found this list empty can wait for such detaching by wait_for_detaching_by_others() and then check again.
+ */
+class od_simple_list_detachable {
+public:
+	using node_pointer = od_simple_list::node_pointer;
+
+	constexpr od_simple_list_detachable( void ) noexcept
+	  : ap_head_( nullptr )
+	  , count_( 0 )
+	  , detach_begin_count_( 0 )
+	  , detach_end_count_( 0 )
+	{
+	}
+	od_simple_list_detachable( const od_simple_list_detachable& )            = delete;
+	od_simple_list_detachable( od_simple_list_detachable&& )                 = delete;
+	od_simple_list_detachable& operator=( const od_simple_list_detachable& ) = delete;
+	od_simple_list_detachable& operator=( od_simple_list_detachable&& )      = delete;
+	~od_simple_list_detachable();
+
+	void           merge_push_front( od_simple_list&& src ) noexcept;
+	od_simple_list detach_all( void ) noexcept;
+
+	/**
+	 * @brief same to detach_all(), but other threads can wait for end_detach() by wait_for_detaching_by_others()
+	 *
+	 * The caller should call end_detach() after the detached nodes are returned to this list or moved to the other shared list.
+	 */
+	od_simple_list begin_detach( void ) noexcept;
+
+	/**
+	 * @brief notify the end of the detaching that is started by begin_detach()
+	 */
+	void end_detach( void ) noexcept;
+
+	/**
+	 * @brief wait for the end of the detaching by the other threads that have been started before this call
+	 *
+	 * @return true: waited for the detaching by other threads. the caller should check the lists again.
+	 * @return false: there was no detaching by other threads.
+	 */
+	bool wait_for_detaching_by_others( void ) const noexcept;
+
+	bool is_empty( void ) const noexcept
+	{
+		return ap_head_.load( std::memory_order_acquire ) == nullptr;
+	}
+
+	/**
+	 * @brief get the approximate number of nodes
+	 *
+	 * The number of nodes is updated separately from the link of nodes. Therefore, the value may be transiently different from the actual number.
+	 */
+	size_t size( void ) const noexcept
+	{
+		return count_.load( std::memory_order_acquire );
+	}
+
+private:
+	std::atomic<node_pointer> ap_head_;
+	std::atomic<size_t>       count_;
+	std::atomic<size_t>       detach_begin_count_;   //!< number of calls of begin_detach()
+	std::atomic<size_t>       detach_end_count_;     //!< number of calls of end_detach()
 };
 
 /**
@@ -0,0 +1,142 @@
+/**
+ * @file striped_counter.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief counter that is split into cache line aligned stripes to reduce the contention of the update
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * While there is no contention, a thread updates one atomic variable that is embedded in the counter.
+ * When an update detects contention by the failure of CAS, the cache line aligned stripes are allocated lazily, and after that,
+ * each thread updates the stripe that is assigned by round robin at the first call of the thread. A reader sums the embedded variable and all stripes.
+ * Therefore, an instance of the container that is not contended keeps only one pointer and one atomic variable for this counter.
+ */
+
+#ifndef ALCONCURRENT_INC_INTERNAL_STRIPED_COUNTER_HPP_
+#define ALCONCURRENT_INC_INTERNAL_STRIPED_COUNTER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "hazard_ptr_internal.hpp"
+
+#ifndef ALCONCURRENT_CONF_STRIPED_COUNTER_NUM
+#define ALCONCURRENT_CONF_STRIPED_COUNTER_NUM ( 16 )   // configuration value. number of stripes of striped_counter
+#endif
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+class striped_counter {
+public:
+	static constexpr size_t num_of_stripes = ALCONCURRENT_CONF_STRIPED_COUNTER_NUM;
+
+	striped_counter( void ) noexcept
+	  : base_( 0 )
+	  , p_stripes_( nullptr )
+	{
+	}
+
+	~striped_counter()
+	{
+		delete[] p_stripes_.load( std::memory_order_acquire );
+	}
+
+	striped_counter( const striped_counter& )            = delete;
+	striped_counter( striped_counter&& )                 = delete;
+	striped_counter& operator=( const striped_counter& ) = delete;
+	striped_counter& operator=( striped_counter&& )      = delete;
+
+	void add( size_t n ) noexcept
+	{
+		update( static_cast<std::ptrdiff_t>( n ) );
+	}
+
+	void sub( size_t n ) noexcept
+	{
+		update( -static_cast<std::ptrdiff_t>( n ) );
+	}
+
+	/**
+	 * @brief get the approximate value
+	 *
+	 * A value is added by a thread and subtracted by another thread. Therefore, each stripe may be negative, and only the sum is meaningful.
+	 * Because the stripes are not read at once, the sum may be transiently negative. In that case, 0 is returned.
+	 */
+	size_t load( void ) const noexcept
+	{
+		std::ptrdiff_t ans       = base_.load( std::memory_order_relaxed );
+		stripe_type*   p_stripes = p_stripes_.load( std::memory_order_acquire );
+		if ( p_stripes != nullptr ) {
+			for ( size_t i = 0; i < num_of_stripes; i++ ) {
+				ans += p_stripes[i].v_.load( std::memory_order_relaxed );
+			}
+		}
+		return ( ans > 0 ) ? static_cast<size_t>( ans ) : 0;
+	}
+
+private:
+	struct alignas( atomic_variable_align ) stripe_type {
+		stripe_type( void ) noexcept
+		  : v_( 0 )
+		{
+		}
+
+		std::atomic<std::ptrdiff_t> v_;
+	};
+
+	void update( std::ptrdiff_t d ) noexcept
+	{
+		stripe_type* p_stripes = p_stripes_.load( std::memory_order_acquire );
+		if ( p_stripes == nullptr ) {
+			std::ptrdiff_t cur = base_.load( std::memory_order_relaxed );
+			if ( base_.compare_exchange_strong( cur, cur + d, std::memory_order_relaxed, std::memory_order_relaxed ) ) {
+				return;
+			}
+
+			// 競合を検出したので、ストライプを確保する。確保できない場合は、base_の更新を続ける。
+			p_stripes = allocate_stripes();
+			if ( p_stripes == nullptr ) {
+				base_.fetch_add( d, std::memory_order_relaxed );
+				return;
+			}
+		}
+		p_stripes[own_stripe_idx()].v_.fetch_add( d, std::memory_order_relaxed );
+	}
+
+	stripe_type* allocate_stripes( void ) noexcept
+	{
+		stripe_type* p_new = new ( std::nothrow ) stripe_type[num_of_stripes];
+		if ( p_new == nullptr ) return nullptr;
+
+		stripe_type* p_expected = nullptr;
+		if ( !p_stripes_.compare_exchange_strong( p_expected, p_new, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+			// 他スレッドが先に確保したので、そちらを使う。
+			delete[] p_new;
+			return p_expected;
+		}
+		return p_new;
+	}
+
+	static size_t own_stripe_idx( void ) noexcept
+	{
+		static std::atomic<size_t> next_idx( 0 );
+		static thread_local size_t tl_idx_plus1 = 0;   // 0 means that the stripe is not assigned yet
+		if ( tl_idx_plus1 == 0 ) {
+			tl_idx_plus1 = ( next_idx.fetch_add( 1, std::memory_order_relaxed ) % num_of_stripes ) + 1;
+		}
+		return tl_idx_plus1 - 1;
+	}
+
+	std::atomic<std::ptrdiff_t> base_;        //!< value that is updated while there is no contention
+	std::atomic<stripe_type*>   p_stripes_;   //!< stripes that are allocated at the first contention. the sum of base_ and all stripes is the value of this counter
+};
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
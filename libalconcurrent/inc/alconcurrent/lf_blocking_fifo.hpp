@@ -0,0 +1,247 @@
+/**
+ * @file lf_blocking_fifo.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief fifo_list with blocking pop and close
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * push is still lock-free. The waiting consumer is parked by eventcount (futex on Linux), and push does a system call only when a consumer is parked.
+ */
+
+#ifndef ALCONCCURRENT_INC_LF_BLOCKING_FIFO_HPP_
+#define ALCONCCURRENT_INC_LF_BLOCKING_FIFO_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+#include "internal/eventcount.hpp"
+#include "lf_fifo.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief fifo_list that a consumer can wait for a value
+ *
+ * After close(), push() fails, and pop_wait() returns the remaining values and then returns alcc_nullopt without waiting.
+ * A push() that has passed the check of close() before close() is called may complete after close(). pop_wait() waits for such push(),
+ * therefore pop_wait() returns alcc_nullopt only after all values of the succeeded push() are popped.
+ *
+ * @tparam T type of value
+ * @tparam ReclamationPolicy reclamation policy of the internal fifo_list. please refer fifo_list
+ */
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
+class blocking_fifo_list {
+public:
+	using value_type = T;
+
+	blocking_fifo_list( void )
+	  : fifo_()
+	  , ec_()
+	  , closed_( false )
+	  , pushing_count_( 0 )
+	{
+	}
+	explicit blocking_fifo_list( size_t reserve_size )
+	  : fifo_( reserve_size )
+	  , ec_()
+	  , closed_( false )
+	  , pushing_count_( 0 )
+	{
+	}
+
+	blocking_fifo_list( const blocking_fifo_list& )            = delete;
+	blocking_fifo_list( blocking_fifo_list&& )                 = delete;
+	blocking_fifo_list& operator=( const blocking_fifo_list& ) = delete;
+	blocking_fifo_list& operator=( blocking_fifo_list&& )      = delete;
+
+	/**
+	 * @brief push a value, and wake up a waiting consumer if any
+	 *
+	 * @return true success to push
+	 * @return false fail to push, because this fifo is closed
+	 */
+	bool push( const T& v_arg )
+	{
+		return emplace( v_arg );
+	}
+	bool push( T&& v_arg )
+	{
+		return emplace( std::move( v_arg ) );
+	}
+
+	template <typename... Args>
+	bool emplace( Args&&... args )
+	{
+		// close()との競合を検出するため、closed_の確認より先に、push中であることを公開する。
+		pushing_count_.fetch_add( 1, std::memory_order_seq_cst );
+		if ( closed_.load( std::memory_order_seq_cst ) ) {
+			end_push( false );
+			return false;
+		}
+		try {
+			fifo_.emplace( std::forward<Args>( args )... );
+		} catch ( ... ) {
+			end_push( false );
+			throw;
+		}
+		end_push( true );
+		return true;
+	}
+
+	/**
+	 * @brief pop a value without waiting
+	 */
+	alcc_optional<value_type> pop( void )
+	{
+		return fifo_.pop();
+	}
+
+	/**
+	 * @brief pop a value. If fifo is empty, wait until a value is pushed or fifo is closed
+	 *
+	 * @return alcc_optional<value_type> popped value. If fifo is closed and empty, alcc_nullopt.
+	 */
+	alcc_optional<value_type> pop_wait( void )
+	{
+		while ( true ) {
+			auto ans = fifo_.pop();
+			if ( ans.has_value() ) return ans;
+			if ( is_closed_and_no_pushing() ) return fifo_.pop();
+
+			internal::eventcount::key_type key = ec_.prepare_wait();
+			ans                                = fifo_.pop();
+			if ( ans.has_value() ) {
+				ec_.cancel_wait();
+				return ans;
+			}
+			if ( is_closed_and_no_pushing() ) {
+				ec_.cancel_wait();
+				return fifo_.pop();
+			}
+			ec_.commit_wait( key );
+		}
+	}
+
+	/**
+	 * @brief pop a value. If fifo is empty, wait until a value is pushed, fifo is closed or rel_time is passed
+	 *
+	 * @return alcc_optional<value_type> popped value. If timeout, or fifo is closed and empty, alcc_nullopt.
+	 */
+	template <class Rep, class Period>
+	alcc_optional<value_type> pop_wait_for( const std::chrono::duration<Rep, Period>& rel_time )
+	{
+		return pop_wait_until( std::chrono::steady_clock::now() + rel_time );
+	}
+
+	/**
+	 * @brief pop a value. If fifo is empty, wait until a value is pushed, fifo is closed or abs_time is reached
+	 *
+	 * @return alcc_optional<value_type> popped value. If timeout, or fifo is closed and empty, alcc_nullopt.
+	 */
+	template <class Clock, class Duration>
+	alcc_optional<value_type> pop_wait_until( const std::chrono::time_point<Clock, Duration>& abs_time )
+	{
+		while ( true ) {
+			auto ans = fifo_.pop();
+			if ( ans.has_value() ) return ans;
+			if ( is_closed_and_no_pushing() ) return fifo_.pop();
+
+			internal::eventcount::key_type key = ec_.prepare_wait();
+			ans                                = fifo_.pop();
+			if ( ans.has_value() ) {
+				ec_.cancel_wait();
+				return ans;
+			}
+			if ( is_closed_and_no_pushing() ) {
+				ec_.cancel_wait();
+				return fifo_.pop();
+			}
+
+			auto rel_time = std::chrono::duration_cast<std::chrono::nanoseconds>( abs_time - Clock::now() );
+			if ( rel_time.count() <= 0 ) {
+				ec_.cancel_wait();
+				return alcc_nullopt;
+			}
+			ec_.commit_wait_for( key, rel_time );
+		}
+	}
+
+	/**
+	 * @brief close this fifo, and wake up all waiting consumers
+	 *
+	 * The values that are already pushed can be popped after close().
+	 */
+	void close( void )
+	{
+		closed_.store( true, std::memory_order_seq_cst );
+		ec_.notify_all();
+	}
+
+	bool is_closed( void ) const noexcept
+	{
+		return closed_.load( std::memory_order_acquire );
+	}
+
+	bool is_empty( void ) const
+	{
+		return fifo_.is_empty();
+	}
+
+	size_t count_size( void ) const
+	{
+		return fifo_.count_size();
+	}
+
+	size_t approximate_size( void ) const noexcept
+	{
+		return fifo_.approximate_size();
+	}
+
+	/*!
+	 * @brief	get the total number of the allocated internal nodes
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		return fifo_.get_allocated_num();
+	}
+
+private:
+	/**
+	 * @brief finish push, and wake up consumers
+	 *
+	 * If this is the last push that completes after close(), wake up all consumers that wait for the completion of push.
+	 */
+	void end_push( bool is_pushed )
+	{
+		size_t pre_count = pushing_count_.fetch_sub( 1, std::memory_order_seq_cst );
+		if ( ( pre_count == 1 ) && closed_.load( std::memory_order_seq_cst ) ) {
+			ec_.notify_all();
+		} else if ( is_pushed ) {
+			ec_.notify_one();
+		}
+	}
+
+	/**
+	 * @brief check that fifo is closed and there is no push that may complete after close()
+	 *
+	 * If this returns true, the following push() fails. Therefore, after fifo becomes empty, it keeps empty.
+	 */
+	bool is_closed_and_no_pushing( void ) const noexcept
+	{
+		return closed_.load( std::memory_order_seq_cst ) && ( pushing_count_.load( std::memory_order_seq_cst ) == 0 );
+	}
+
+	fifo_list<T, ReclamationPolicy> fifo_;            //!< fifo that keeps values
+	internal::eventcount            ec_;              //!< eventcount to park consumers
+	std::atomic<bool>               closed_;          //!< true after close()
+	std::atomic<size_t>             pushing_count_;   //!< number of push() that is in progress
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
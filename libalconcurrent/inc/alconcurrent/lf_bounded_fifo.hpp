@@ -0,0 +1,262 @@
+/**
+ * @file lf_bounded_fifo.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief bounded fifo that is array based ring buffer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * This is the bounded MPMC queue by Dmitry Vyukov.
+ * Each cell of the ring buffer has a sequence number, and producers/consumers reserve a cell by CAS of the enqueue/dequeue position.
+ * Therefore, push/pop does not allocate any node and does not use hazard pointer.
+ */
+
+#ifndef ALCONCCURRENT_INC_LF_BOUNDED_FIFO_HPP_
+#define ALCONCCURRENT_INC_LF_BOUNDED_FIFO_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "internal/alcc_optional.hpp"
+#include "internal/hazard_ptr_internal.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief bounded fifo
+ *
+ * try_push() returns false when fifo is full, and pop() returns alcc_nullopt when fifo is empty.
+ *
+ * @note
+ * try_pop() and try_push() never wait for other threads.
+ * If a thread stalls after reserving a cell, try_pop() may spuriously return alcc_nullopt while that thread is pushing a value into the head cell,
+ * even if the following cells already have values. Likewise, try_push() may spuriously return false while that thread is popping a value from the tail cell.
+ * If caller needs the value or the space, caller should retry.
+ *
+ * @tparam T type of value. T should be move constructible or copy constructible.
+ * @tparam Capacity capacity of fifo. This should be power of 2. If 0, capacity is given by the constructor.
+ */
+template <typename T, size_t Capacity = 0>
+class bounded_fifo_list {
+public:
+	static_assert( std::is_move_constructible<T>::value || std::is_copy_constructible<T>::value,
+	               "T should be move constructible or copy constructible" );
+	static_assert( ( Capacity & ( Capacity - 1 ) ) == 0, "Capacity should be power of 2" );
+
+	using value_type = T;
+
+	template <size_t N = Capacity, typename std::enable_if<( N != 0 )>::type* = nullptr>
+	bounded_fifo_list( void )
+	  : bounded_fifo_list( Capacity, 0 )
+	{
+	}
+
+	/**
+	 * @brief constructor for runtime capacity
+	 *
+	 * @param capacity capacity of fifo. This is rounded up to power of 2.
+	 */
+	template <size_t N = Capacity, typename std::enable_if<( N == 0 )>::type* = nullptr>
+	explicit bounded_fifo_list( size_t capacity )
+	  : bounded_fifo_list( round_up_to_power_of_2( capacity ), 0 )
+	{
+	}
+
+	~bounded_fifo_list()
+	{
+		auto tmp = pop();
+		while ( tmp.has_value() ) {
+			tmp = pop();
+		}
+	}
+
+	bounded_fifo_list( const bounded_fifo_list& )            = delete;
+	bounded_fifo_list( bounded_fifo_list&& )                 = delete;
+	bounded_fifo_list& operator=( const bounded_fifo_list& ) = delete;
+	bounded_fifo_list& operator=( bounded_fifo_list&& )      = delete;
+
+	/**
+	 * @brief push a value
+	 *
+	 * @return true success to push
+	 * @return false fifo is full
+	 */
+	bool try_push( const T& v_arg )
+	{
+		return try_emplace( v_arg );
+	}
+	bool try_push( T&& v_arg )
+	{
+		return try_emplace( std::move( v_arg ) );
+	}
+
+	template <typename... Args>
+	bool try_emplace( Args&&... args )
+	{
+		size_t pos;
+		if ( !reserve_pos_to_push( pos ) ) return false;
+
+		cell_type& cur_cell = cells_[pos & mask_];
+		new ( cur_cell.storage_ ) T( std::forward<Args>( args )... );
+		cur_cell.seq_.store( pos + 1, std::memory_order_release );
+		return true;
+	}
+
+	/**
+	 * @brief same to try_push(). This is for the compatibility with fifo_list.
+	 */
+	bool push( const T& v_arg )
+	{
+		return try_push( v_arg );
+	}
+	bool push( T&& v_arg )
+	{
+		return try_push( std::move( v_arg ) );
+	}
+	template <typename... Args>
+	bool emplace( Args&&... args )
+	{
+		return try_emplace( std::forward<Args>( args )... );
+	}
+
+	/**
+	 * @brief pop a value
+	 *
+	 * @return alcc_optional<value_type> popped value. If fifo is empty, alcc_nullopt.
+	 */
+	alcc_optional<value_type> try_pop( void )
+	{
+		size_t pos = dequeue_pos_.load( std::memory_order_relaxed );
+		while ( true ) {
+			cell_type&    cur_cell = cells_[pos & mask_];
+			size_t        seq      = cur_cell.seq_.load( std::memory_order_acquire );
+			std::intptr_t diff     = static_cast<std::intptr_t>( seq ) - static_cast<std::intptr_t>( pos + 1 );
+			if ( diff == 0 ) {
+				if ( dequeue_pos_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed ) ) {
+					T*                        p_value = reinterpret_cast<T*>( cur_cell.storage_ );
+					alcc_optional<value_type> ans( alcc_in_place, std::move_if_noexcept( *p_value ) );
+					p_value->~T();
+					cur_cell.seq_.store( pos + mask_ + 1, std::memory_order_release );
+					return ans;
+				}
+			} else if ( diff < 0 ) {
+				// 空。他スレッドがセルを予約済みで値を書き込み中の場合も、完了を待たずに空として扱う
+				return alcc_nullopt;
+			} else {
+				// 他スレッドがpopしたため、位置を読み直す
+				pos = dequeue_pos_.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	/**
+	 * @brief same to try_pop(). This is for the compatibility with fifo_list.
+	 */
+	alcc_optional<value_type> pop( void )
+	{
+		return try_pop();
+	}
+
+	/**
+	 * @brief get the number of values in fifo
+	 *
+	 * @warning
+	 * This fifo will be access by several thread concurrently. So, true number of this fifo may be changed when caller uses the returned value.
+	 */
+	size_t count_size( void ) const noexcept
+	{
+		size_t deq_pos = dequeue_pos_.load( std::memory_order_acquire );
+		size_t enq_pos = enqueue_pos_.load( std::memory_order_acquire );
+		if ( enq_pos <= deq_pos ) return 0;
+		size_t ans = enq_pos - deq_pos;
+		return ( ans > capacity() ) ? capacity() : ans;
+	}
+
+	bool is_empty( void ) const noexcept
+	{
+		return count_size() == 0;
+	}
+
+	size_t capacity( void ) const noexcept
+	{
+		return mask_ + 1;
+	}
+
+	/*!
+	 * @brief	get the number of the allocated cells
+	 *
+	 * This is for the compatibility with fifo_list. Cells are allocated by constructor only.
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		return capacity();
+	}
+
+private:
+	struct cell_type {
+		std::atomic<size_t>        seq_;                    //!< sequence number of this cell
+		alignas( T ) unsigned char storage_[sizeof( T )];   //!< storage of value
+	};
+
+	bounded_fifo_list( size_t capacity, int )
+	  : mask_( capacity - 1 )
+	  , up_cells_( new cell_type[capacity] )
+	  , cells_( up_cells_.get() )
+	  , enqueue_pos_( 0 )
+	  , dequeue_pos_( 0 )
+	{
+		for ( size_t i = 0; i < capacity; i++ ) {
+			cells_[i].seq_.store( i, std::memory_order_relaxed );
+		}
+		std::atomic_thread_fence( std::memory_order_release );
+	}
+
+	static size_t round_up_to_power_of_2( size_t n ) noexcept
+	{
+		size_t ans = 1;
+		while ( ans < n ) {
+			ans <<= 1;
+		}
+		return ans;
+	}
+
+	bool reserve_pos_to_push( size_t& pos )
+	{
+		pos = enqueue_pos_.load( std::memory_order_relaxed );
+		while ( true ) {
+			cell_type&    cur_cell = cells_[pos & mask_];
+			size_t        seq      = cur_cell.seq_.load( std::memory_order_acquire );
+			std::intptr_t diff     = static_cast<std::intptr_t>( seq ) - static_cast<std::intptr_t>( pos );
+			if ( diff == 0 ) {
+				if ( enqueue_pos_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed ) ) {
+					return true;
+				}
+			} else if ( diff < 0 ) {
+				// 満杯。他スレッドがセルを予約済みで値を取り出し中の場合も、完了を待たずに満杯として扱う
+				return false;
+			} else {
+				// 他スレッドがpushしたため、位置を読み直す
+				pos = enqueue_pos_.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	const size_t                 mask_;       //!< capacity - 1
+	std::unique_ptr<cell_type[]> up_cells_;   //!< owner of cells
+	cell_type* const             cells_;      //!< ring buffer
+
+	alignas( internal::atomic_variable_align ) std::atomic<size_t> enqueue_pos_;   //!< next position to push
+	alignas( internal::atomic_variable_align ) std::atomic<size_t> dequeue_pos_;   //!< next position to pop
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
@@ -18,16 +18,18 @@
 
 #include "hazard_ptr.hpp"
 #include "internal/alcc_optional.hpp"
-#include "internal/od_lockfree_fifo.hpp"
+#include "internal/ebr_domain.hpp"
+#include "internal/od_lockfree_fifo_engine.hpp"
 #include "internal/od_node_essence.hpp"
 #include "internal/od_node_pool.hpp"
+#include "internal/striped_counter.hpp"
 
 namespace alpha {
 namespace concurrent {
 
 namespace internal {
 
-template <typename T>
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
 class x_lockfree_fifo {
 public:
 	static_assert( ( !std::is_class<T>::value ) ||
@@ -39,8 +41,9 @@ public:
 	using value_type = T;
 
 	x_lockfree_fifo( void )
-	  : lf_fifo_impl_()
+	  : lf_fifo_impl_( allocate_node_as_sentinel() )
 	  , allocated_node_count_( 0 )
+	  , approx_size_()
 	{
 	}
 	x_lockfree_fifo( size_t reserve_size )
@@ -74,6 +77,7 @@ public:
 	void push( const T& v_arg )
 	{
 		lf_fifo_impl_.push_back( allocate_node( v_arg ) );
+		approx_size_.add( 1 );
 	}
 
 	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
@@ -83,12 +87,48 @@ public:
 	void push( T&& v_arg )
 	{
 		lf_fifo_impl_.push_back( allocate_node( std::move( v_arg ) ) );
+		approx_size_.add( 1 );
 	}
 
 	template <typename... Args>
 	void emplace( Args&&... args )
 	{
 		lf_fifo_impl_.push_back( allocate_node_emplace( std::forward<Args>( args )... ) );
+		approx_size_.add( 1 );
+	}
+
+	/**
+	 * @brief push values of [first, last)
+	 *
+	 * Nodes are linked privately at first, and then the linked nodes are appended to the tail by one CAS.
+	 */
+	template <typename InputIt>
+	void push_range( InputIt first, InputIt last )
+	{
+		if ( first == last ) return;
+
+		size_t       n             = 1;
+		node_pointer p_chain_first = allocate_node( *first );
+		node_pointer p_chain_last  = p_chain_first;
+		try {
+			for ( ++first; first != last; ++first ) {
+				node_pointer p_new_nd = allocate_node( *first );
+				p_chain_last->od_node_link_by_hazard_handler::set_next( p_new_nd );
+				p_chain_last = p_new_nd;
+				n++;
+			}
+		} catch ( ... ) {
+			// 公開前のノード列は他スレッドから参照されていないため、ノードプールへ戻してから例外を伝える。
+			node_pointer p_cur = p_chain_first;
+			for ( size_t i = 0; i < n; i++ ) {
+				node_pointer p_next = static_cast<node_pointer>( p_cur->od_node_link_by_hazard_handler::next() );
+				node_pool_t::push( p_cur );
+				p_cur = p_next;
+			}
+			throw;
+		}
+		lf_fifo_impl_.push_back_chain( p_chain_first, p_chain_last );
+		approx_size_.add( n );
 	}
 
 	template <bool IsCopyConstructible = std::is_copy_constructible<value_type>::value,
@@ -99,6 +139,7 @@ public:
 	{
 		node_pointer p_old_sentinel = lf_fifo_impl_.push_front( allocate_node(), allocate_node( v_arg ) );
 		node_pool_t::push( p_old_sentinel );
+		approx_size_.add( 1 );
 	}
 
 	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
@@ -109,6 +150,7 @@ public:
 	{
 		node_pointer p_old_sentinel = lf_fifo_impl_.push_front( allocate_node(), allocate_node( std::move( v_arg ) ) );
 		node_pool_t::push( p_old_sentinel );
+		approx_size_.add( 1 );
 	}
 
 	template <typename... Args>
@@ -116,36 +158,61 @@ public:
 	{
 		node_pointer p_old_sentinel = lf_fifo_impl_.push_front( allocate_node(), allocate_node_emplace( std::forward<Args>( args )... ) );
 		node_pool_t::push( p_old_sentinel );
+		approx_size_.add( 1 );
 	}
 
-	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
-	          bool IsMoveAssignable    = std::is_move_assignable<value_type>::value,
-	          typename std::enable_if<
-				  IsMoveConstructible && IsMoveAssignable>::type* = nullptr>
+	/**
+	 * @brief pop a value
+	 *
+	 * The popped value is constructed directly in the returned alcc_optional. Therefore, T is not required to be default constructible.
+	 */
 	alcc_optional<value_type> pop( void )
 	{
-		value_type   popped_value_storage;
-		node_pointer p_popped_node = lf_fifo_impl_.pop_front( &popped_value_storage );
-		if ( p_popped_node == nullptr ) return alcc_nullopt;
-
+		alcc_optional<value_type> ans;
+		node_pointer              p_popped_node = lf_fifo_impl_.pop_front(
+			[&ans]( node_type& node_stored_value ) {
+				ans.emplace( pick_up_value( node_stored_value ) );
+			} );
+		if ( p_popped_node == nullptr ) return ans;
+
+		approx_size_.sub( 1 );
 		node_pool_t::push( p_popped_node );
-		return alcc_optional<value_type> { std::move( popped_value_storage ) };
+		return ans;
 	}
 
-	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
-	          bool IsMoveAssignable    = std::is_move_assignable<value_type>::value,
-	          bool IsCopyConstructible = std::is_copy_constructible<value_type>::value,
-	          bool IsCopyAssignable    = std::is_copy_assignable<value_type>::value,
-	          typename std::enable_if<
-				  !( IsMoveConstructible && IsMoveAssignable ) && ( IsCopyConstructible && IsCopyAssignable )>::type* = nullptr>
-	alcc_optional<value_type> pop( void )
+	/**
+	 * @brief pop up to max_n values by one update of head
+	 *
+	 * @return size_t the number of popped values that are written to d_first
+	 */
+	template <typename OutputIt>
+	size_t pop_bulk( OutputIt d_first, size_t max_n )
 	{
-		value_type   popped_value_storage;
-		node_pointer p_popped_node = lf_fifo_impl_.pop_front( &popped_value_storage );
-		if ( p_popped_node == nullptr ) return alcc_nullopt;
+		alcc_optional<value_type> last_value;
+		node_pointer              p_popped_head = nullptr;
+		size_t                    ans           = lf_fifo_impl_.pop_front_bulk(
+			[&last_value]( node_type& node_stored_value ) {
+				last_value.emplace( pick_up_value( node_stored_value ) );
+			},
+			max_n, &p_popped_head );
+		if ( ans == 0 ) return 0;
+		approx_size_.sub( ans );
+
+		// 先頭は古い番兵ノードで値を持たない。最後の値は、新たな番兵ノードからlast_valueに取り出されている。
+		node_pointer p_cur = p_popped_head;
+		for ( size_t i = 0; i < ans; i++ ) {
+			node_pointer p_next = static_cast<node_pointer>( p_cur->od_node_link_by_hazard_handler::next() );
+			if ( i > 0 ) {
+				*d_first = pick_up_value( *p_cur );
+				++d_first;
+			}
+			node_pool_t::push( p_cur );
+			p_cur = p_next;
+		}
+		*d_first = std::move( last_value.value() );
+		++d_first;
 
-		node_pool_t::push( p_popped_node );
-		return alcc_optional<value_type> { popped_value_storage };
+		return ans;
 	}
 
 	size_t count_size( void ) const
@@ -153,6 +220,17 @@ public:
 		return lf_fifo_impl_.count_size();
 	}
 
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * This does not traverse the nodes, and sums the striped counters that are updated by push/pop. Therefore, this is cheap enough to be called frequently.
+	 * The values that are being pushed or popped concurrently may or may not be counted.
+	 */
+	size_t approximate_size( void ) const noexcept
+	{
+		return approx_size_.load();
+	}
+
 	bool is_empty( void ) const
 	{
 		return lf_fifo_impl_.is_empty();
@@ -178,6 +256,17 @@ private:
 	using node_type    = od_node_type1<T>;
 	using node_pointer = od_node_type1<T>*;
 
+	template <bool IsMovable = std::is_move_constructible<T>::value && std::is_move_assignable<T>::value, typename std::enable_if<IsMovable>::type* = nullptr>
+	static value_type&& pick_up_value( node_type& node_stored_value )
+	{
+		return std::move( node_stored_value.get_value() );
+	}
+	template <bool IsMovable = std::is_move_constructible<T>::value && std::is_move_assignable<T>::value, typename std::enable_if<!IsMovable>::type* = nullptr>
+	static const value_type& pick_up_value( node_type& node_stored_value )
+	{
+		return node_stored_value.get_value();
+	}
+
 	void pre_allocate_nodes( size_t n )
 	{
 		for ( size_t i = 0; i < n; i++ ) {
@@ -207,10 +296,15 @@ private:
 	{
 		node_pointer p_new_nd = node_pool_t::pop();
 		if ( p_new_nd != nullptr ) {
-			p_new_nd->set_value( v_arg );
+			try {
+				p_new_nd->set_value( v_arg );
+			} catch ( ... ) {
+				node_pool_t::push( p_new_nd );
+				throw;
+			}
 		} else {
-			allocated_node_count_++;
 			p_new_nd = new node_type( v_arg );
+			allocated_node_count_++;   // 値の構築で例外がスローされた場合に数えないよう、確保後に数える
 		}
 		return p_new_nd;
 	}
@@ -218,10 +312,15 @@ private:
 	{
 		node_pointer p_new_nd = node_pool_t::pop();
 		if ( p_new_nd != nullptr ) {
-			p_new_nd->set_value( std::move( v_arg ) );
+			try {
+				p_new_nd->set_value( std::move( v_arg ) );
+			} catch ( ... ) {
+				node_pool_t::push( p_new_nd );
+				throw;
+			}
 		} else {
-			allocated_node_count_++;
 			p_new_nd = new node_type( std::move( v_arg ) );
+			allocated_node_count_++;   // 値の構築で例外がスローされた場合に数えないよう、確保後に数える
 		}
 		return p_new_nd;
 	}
@@ -230,114 +329,374 @@ private:
 	{
 		node_pointer p_new_nd = node_pool_t::pop();
 		if ( p_new_nd != nullptr ) {
-			p_new_nd->emplace_value( std::forward<Args>( args )... );
+			try {
+				p_new_nd->emplace_value( std::forward<Args>( args )... );
+			} catch ( ... ) {
+				node_pool_t::push( p_new_nd );
+				throw;
+			}
 		} else {
-			allocated_node_count_++;
 			p_new_nd = new node_type( alcc_in_place, std::forward<Args>( args )... );
+			allocated_node_count_++;   // 値の構築で例外がスローされた場合に数えないよう、確保後に数える
 		}
 		return p_new_nd;
 	}
 
-	class node_fifo_lockfree_t : private od_lockfree_fifo {
-	public:
-		node_fifo_lockfree_t( void )
-		  : od_lockfree_fifo( x_lockfree_fifo::allocate_node_as_sentinel() )
-		{
-		}
+	using node_pool_t = od_node_pool<node_type>;
 
-		void push_back( x_lockfree_fifo::node_pointer p_nd ) noexcept
-		{
-			od_lockfree_fifo::push_back( p_nd );
+	od_lockfree_fifo_engine<node_type> lf_fifo_impl_;           //!< lock-free fifo
+	std::atomic<size_t>                allocated_node_count_;   //!< allocated nodes count
+	striped_counter                    approx_size_;            //!< approximate number of the values
+};
+
+/**
+ * @brief lock-free fifo that uses epoch based reclamation
+ *
+ * This is Michael & Scott queue. A node is allocated for each push, and the old sentinel node is released via ebr_domain::Retire() after pop.
+ * Because a node is not released while any thread is in critical section, ABA problem does not happen.
+ *
+ * @note push_head() is not supported.
+ */
+template <typename T>
+class x_lockfree_fifo<T, epoch_based_reclamation> {
+public:
+	static_assert( ( !std::is_class<T>::value ) ||
+	                   ( std::is_class<T>::value &&
+	                     ( ( std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value ) ||
+	                       ( std::is_move_constructible<T>::value && std::is_move_assignable<T>::value ) ) ),
+	               "T should be copy constructible and copy assignable, or, move constructible and move assignable" );
+
+	using value_type = T;
+
+	x_lockfree_fifo( void )
+	  : ap_head_( nullptr )
+	  , ap_tail_( nullptr )
+	  , allocated_node_count_( 1 )
+	  , approx_size_()
+	{
+		node_pointer p_sentinel = new node_type;
+		ap_head_.store( p_sentinel, std::memory_order_release );
+		ap_tail_.store( p_sentinel, std::memory_order_release );
+	}
+	x_lockfree_fifo( size_t reserve_size )
+	  : x_lockfree_fifo()
+	{
+		static_cast<void>( reserve_size );   // ノードはpush毎に確保するため、予約は行わない。
+	}
+
+	~x_lockfree_fifo()
+	{
+		node_pointer p_cur = ap_head_.load( std::memory_order_acquire );
+		while ( p_cur != nullptr ) {
+			node_pointer p_next = p_cur->ap_next_.load( std::memory_order_acquire );
+			delete p_cur;
+			p_cur = p_next;
 		}
-		x_lockfree_fifo::node_pointer push_front( x_lockfree_fifo::node_pointer p_sentinel, x_lockfree_fifo::node_pointer p_nd_w_value ) noexcept
-		{
-			od_lockfree_fifo::node_pointer p_old_sentinel = od_lockfree_fifo::push_front( p_sentinel, p_nd_w_value );
-			if ( p_old_sentinel == nullptr ) return nullptr;
-			return static_cast<x_lockfree_fifo::node_pointer>( p_old_sentinel );
+	}
+
+	template <bool IsCopyConstructible = std::is_copy_constructible<value_type>::value,
+	          bool IsCopyAssignable    = std::is_copy_assignable<value_type>::value,
+	          typename std::enable_if<
+				  IsCopyConstructible && IsCopyAssignable>::type* = nullptr>
+	void push( const T& v_arg )
+	{
+		push_node( new node_type( alcc_in_place, v_arg ) );
+	}
+
+	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
+	          bool IsMoveAssignable    = std::is_move_assignable<value_type>::value,
+	          typename std::enable_if<
+				  IsMoveConstructible && IsMoveAssignable>::type* = nullptr>
+	void push( T&& v_arg )
+	{
+		push_node( new node_type( alcc_in_place, std::move( v_arg ) ) );
+	}
+
+	template <typename... Args>
+	void emplace( Args&&... args )
+	{
+		push_node( new node_type( alcc_in_place, std::forward<Args>( args )... ) );
+	}
+
+	/**
+	 * @brief push values of [first, last)
+	 *
+	 * Nodes are linked privately at first, and then the linked nodes are appended to the tail by one CAS.
+	 */
+	template <typename InputIt>
+	void push_range( InputIt first, InputIt last )
+	{
+		if ( first == last ) return;
+
+		size_t       n             = 1;
+		node_pointer p_chain_first = new node_type( alcc_in_place, *first );
+		node_pointer p_chain_last  = p_chain_first;
+		try {
+			for ( ++first; first != last; ++first ) {
+				node_pointer p_new_nd = new node_type( alcc_in_place, *first );
+				p_chain_last->ap_next_.store( p_new_nd, std::memory_order_relaxed );
+				p_chain_last = p_new_nd;
+				n++;
+			}
+		} catch ( ... ) {
+			// 公開前のノード列は他スレッドから参照されていないため、直ちに解放してから例外を伝える。
+			node_pointer p_cur = p_chain_first;
+			while ( p_cur != nullptr ) {
+				node_pointer p_next = p_cur->ap_next_.load( std::memory_order_relaxed );
+				delete p_cur;
+				p_cur = p_next;
+			}
+			throw;
 		}
-		x_lockfree_fifo::node_pointer pop_front( x_lockfree_fifo::value_type* p_context_local_data ) noexcept
+		push_chain( p_chain_first, p_chain_last, n );
+	}
+
+	alcc_optional<value_type> pop( void )
+	{
+		node_pointer              p_old_sentinel = nullptr;
+		alcc_optional<value_type> ans;
 		{
-			od_lockfree_fifo::node_pointer p_node = od_lockfree_fifo::pop_front( p_context_local_data );
-			if ( p_node == nullptr ) return nullptr;
-			return static_cast<x_lockfree_fifo::node_pointer>( p_node );
+			ebr_domain::critical_section cs;
+
+			while ( true ) {
+				node_pointer p_head = ap_head_.load( std::memory_order_acquire );
+				node_pointer p_tail = ap_tail_.load( std::memory_order_acquire );
+				node_pointer p_next = p_head->ap_next_.load( std::memory_order_acquire );
+				if ( p_head != ap_head_.load( std::memory_order_acquire ) ) continue;
+
+				if ( p_next == nullptr ) return alcc_nullopt;
+				if ( p_head == p_tail ) {
+					// tailが遅れているので、進める
+					ap_tail_.compare_exchange_weak( p_tail, p_next, std::memory_order_acq_rel, std::memory_order_relaxed );
+					continue;
+				}
+				if ( ap_head_.compare_exchange_weak( p_head, p_next, std::memory_order_acq_rel, std::memory_order_relaxed ) ) {
+					// p_nextが新しい番兵ノードになる。p_nextの値にアクセスするのは、CASに成功したスレッドのみ。
+					ans.emplace( std::move( p_next->value_.value() ) );
+					p_next->value_.reset();
+					p_old_sentinel = p_head;
+					break;
+				}
+			}
 		}
 
-		x_lockfree_fifo::node_pointer release_sentinel_node( void ) noexcept
+		allocated_node_count_--;
+		approx_size_.sub( 1 );
+		ebr_domain::Retire( p_old_sentinel, &node_type::deleter );
+		return ans;
+	}
+
+	/**
+	 * @brief pop up to max_n values by one update of head
+	 *
+	 * @return size_t the number of popped values that are written to d_first
+	 */
+	template <typename OutputIt>
+	size_t pop_bulk( OutputIt d_first, size_t max_n )
+	{
+		if ( max_n == 0 ) return 0;
+
+		node_pointer p_old_sentinel = nullptr;
+		size_t       ans            = 0;
 		{
-			od_lockfree_fifo::node_pointer p_node = od_lockfree_fifo::release_sentinel_node();
-			if ( p_node == nullptr ) return nullptr;
-			return static_cast<x_lockfree_fifo::node_pointer>( p_node );
+			ebr_domain::critical_section cs;
+
+			while ( true ) {
+				node_pointer p_head = ap_head_.load( std::memory_order_acquire );
+				node_pointer p_tail = ap_tail_.load( std::memory_order_acquire );
+				node_pointer p_last = p_head->ap_next_.load( std::memory_order_acquire );
+				if ( p_head != ap_head_.load( std::memory_order_acquire ) ) continue;
+
+				if ( p_last == nullptr ) return 0;
+				if ( p_head == p_tail ) {
+					// tailが遅れているので、進める
+					ap_tail_.compare_exchange_weak( p_tail, p_last, std::memory_order_acq_rel, std::memory_order_relaxed );
+					continue;
+				}
+
+				ans = 1;
+				while ( ans < max_n ) {
+					node_pointer p_next = p_last->ap_next_.load( std::memory_order_acquire );
+					if ( p_next == nullptr ) break;
+
+					p_tail = ap_tail_.load( std::memory_order_acquire );
+					if ( p_last == p_tail ) {
+						// tailを追い越してheadを更新しないように、tailを先に進める。
+						ap_tail_.compare_exchange_strong( p_tail, p_next, std::memory_order_acq_rel, std::memory_order_relaxed );
+					}
+					p_last = p_next;
+					ans++;
+				}
+
+				if ( ap_head_.compare_exchange_weak( p_head, p_last, std::memory_order_acq_rel, std::memory_order_relaxed ) ) {
+					// p_lastが新しい番兵ノードになる。p_headの次からp_lastまでの値にアクセスするのは、CASに成功したスレッドのみ。
+					p_old_sentinel = p_head;
+					node_pointer p_cur = p_head->ap_next_.load( std::memory_order_acquire );
+					for ( size_t i = 0; i < ans; i++ ) {
+						*d_first = std::move( p_cur->value_.value() );
+						++d_first;
+						p_cur->value_.reset();
+						p_cur = p_cur->ap_next_.load( std::memory_order_acquire );
+					}
+					break;
+				}
+			}
 		}
 
-		size_t count_size( void ) const
-		{
-			return od_lockfree_fifo::count_size();
+		// 古い番兵ノードから、新たな番兵ノードの手前までのノードを開放する。
+		allocated_node_count_ -= ans;
+		approx_size_.sub( ans );
+		node_pointer p_cur = p_old_sentinel;
+		for ( size_t i = 0; i < ans; i++ ) {
+			node_pointer p_next = p_cur->ap_next_.load( std::memory_order_acquire );
+			ebr_domain::Retire( p_cur, &node_type::deleter );
+			p_cur = p_next;
 		}
+		return ans;
+	}
 
-		bool is_empty( void ) const
-		{
-			return od_lockfree_fifo::is_empty();
+	size_t count_size( void ) const
+	{
+		ebr_domain::critical_section cs;
+
+		size_t       ans   = 0;
+		node_pointer p_cur = ap_head_.load( std::memory_order_acquire )->ap_next_.load( std::memory_order_acquire );
+		while ( p_cur != nullptr ) {
+			ans++;
+			p_cur = p_cur->ap_next_.load( std::memory_order_acquire );
 		}
+		return ans;
+	}
 
-	private:
-		template <bool IsMovable = std::is_move_assignable<T>::value, typename std::enable_if<IsMovable>::type* = nullptr>
-		void callback_to_pick_up_value_impl( x_lockfree_fifo::node_type& node_stored_value, x_lockfree_fifo::value_type& context_local_data )
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * This does not traverse the nodes, and sums the striped counters that are updated by push/pop. Therefore, this is cheap enough to be called frequently.
+	 * The values that are being pushed or popped concurrently may or may not be counted.
+	 */
+	size_t approximate_size( void ) const noexcept
+	{
+		return approx_size_.load();
+	}
+
+	bool is_empty( void ) const
+	{
+		ebr_domain::critical_section cs;
+
+		return ap_head_.load( std::memory_order_acquire )->ap_next_.load( std::memory_order_acquire ) == nullptr;
+	}
+
+	/*!
+	 * @brief	get the number of the nodes that are allocated and are not retired yet
+	 *
+	 * @warning
+	 * This List will be access by several thread concurrently. So, true number of this List may be changed when caller uses the returned value.
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		return allocated_node_count_.load();
+	}
+
+	static void clear_node_pool_as_possible_as( void )
+	{
+		ebr_domain::DrainRetired();
+	}
+
+private:
+	struct node_type {
+		node_type( void )
+		  : ap_next_( nullptr )
+		  , value_()
 		{
-			context_local_data = std::move( node_stored_value ).get_value();
 		}
-		template <bool IsCopyable                                          = std::is_copy_assignable<T>::value,
-		          bool IsMovable                                           = std::is_move_assignable<T>::value,
-		          typename std::enable_if<!IsMovable && IsCopyable>::type* = nullptr>
-		void callback_to_pick_up_value_impl( x_lockfree_fifo::node_type& node_stored_value, x_lockfree_fifo::value_type& context_local_data )
+		template <typename... Args>
+		node_type( alcc_in_place_t, Args&&... args )
+		  : ap_next_( nullptr )
+		  , value_( alcc_in_place, std::forward<Args>( args )... )
 		{
-			context_local_data = node_stored_value.get_value();
 		}
 
-		void callback_to_pick_up_value( od_lockfree_fifo::node_pointer p_node_stored_value, void* p_context_local_data ) override
+		static void deleter( void* p )
 		{
-			x_lockfree_fifo::node_type& node_stored_value = *( static_cast<x_lockfree_fifo::node_pointer>( p_node_stored_value ) );   // od_lockfree_fifoに保管されているノードはnode_pointerであることを保証しているため、static_castを使用する。
-
-			x_lockfree_fifo::value_type* p_storage_for_popped_value_ = reinterpret_cast<x_lockfree_fifo::value_type*>( p_context_local_data );
-			callback_to_pick_up_value_impl( node_stored_value, *p_storage_for_popped_value_ );
+			delete static_cast<node_type*>( p );
 		}
-	};   // namespace internal
 
-	using node_pool_t = od_node_pool<node_type>;
+		std::atomic<node_type*>   ap_next_;
+		alcc_optional<value_type> value_;   //!< 番兵ノードは値を持たない
+	};
+	using node_pointer = node_type*;
+
+	void push_node( node_pointer p_new_nd )
+	{
+		push_chain( p_new_nd, p_new_nd, 1 );
+	}
+
+	void push_chain( node_pointer p_first, node_pointer p_last, size_t n )
+	{
+		allocated_node_count_ += n;
+
+		ebr_domain::critical_section cs;
+
+		while ( true ) {
+			node_pointer p_tail = ap_tail_.load( std::memory_order_acquire );
+			node_pointer p_next = p_tail->ap_next_.load( std::memory_order_acquire );
+			if ( p_tail != ap_tail_.load( std::memory_order_acquire ) ) continue;
+
+			if ( p_next != nullptr ) {
+				// tailが遅れているので、進める
+				ap_tail_.compare_exchange_weak( p_tail, p_next, std::memory_order_acq_rel, std::memory_order_relaxed );
+				continue;
+			}
+			if ( p_tail->ap_next_.compare_exchange_weak( p_next, p_first, std::memory_order_acq_rel, std::memory_order_relaxed ) ) {
+				ap_tail_.compare_exchange_strong( p_tail, p_last, std::memory_order_acq_rel, std::memory_order_relaxed );
+				approx_size_.add( n );
+				return;
+			}
+		}
+	}
 
-	node_fifo_lockfree_t lf_fifo_impl_;           //!< lock-free fifo
-	std::atomic<size_t>  allocated_node_count_;   //!< allocated nodes count
+	std::atomic<node_pointer> ap_head_;                //!< sentinel node
+	std::atomic<node_pointer> ap_tail_;                //!< last node
+	std::atomic<size_t>       allocated_node_count_;   //!< number of nodes that are allocated and are not retired yet
+	striped_counter           approx_size_;            //!< approximate number of the values
 };
 
 }   // namespace internal
 
-template <typename T>
-class fifo_list : public internal::x_lockfree_fifo<T> {
+/**
+ * @brief semi lock-free fifo
+ *
+ * @tparam T type of value
+ * @tparam ReclamationPolicy hazard_ptr_reclamation(default) or epoch_based_reclamation
+ */
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
+class fifo_list : public internal::x_lockfree_fifo<T, ReclamationPolicy> {
 public:
 	fifo_list( void ) noexcept = default;
 	fifo_list( size_t reserve_size )
-	  : internal::x_lockfree_fifo<T>( reserve_size )
+	  : internal::x_lockfree_fifo<T, ReclamationPolicy>( reserve_size )
 	{
 	}
 };
-template <typename T>
-class fifo_list<T[]> : public internal::x_lockfree_fifo<T*> {
+template <typename T, typename ReclamationPolicy>
+class fifo_list<T[], ReclamationPolicy> : public internal::x_lockfree_fifo<T*, ReclamationPolicy> {
 public:
 	using value_type = T[];
 
 	fifo_list( void ) noexcept = default;
 	fifo_list( size_t reserve_size )
-	  : internal::x_lockfree_fifo<T*>( reserve_size )
+	  : internal::x_lockfree_fifo<T*, ReclamationPolicy>( reserve_size )
 	{
 	}
 };
-template <typename T, size_t N>
-class fifo_list<T[N]> : public internal::x_lockfree_fifo<std::array<T, N>> {
+template <typename T, size_t N, typename ReclamationPolicy>
+class fifo_list<T[N], ReclamationPolicy> : public internal::x_lockfree_fifo<std::array<T, N>, ReclamationPolicy> {
 public:
 	using value_type = T[N];
 
 	fifo_list( void ) = default;
 	fifo_list( size_t reserve_size )
-	  : internal::x_lockfree_fifo<std::array<T, N>>( reserve_size )
+	  : internal::x_lockfree_fifo<std::array<T, N>, ReclamationPolicy>( reserve_size )
 	{
 	}
 
@@ -350,7 +709,7 @@ public:
 			tmp[i] = cont_arg[i];
 		}
 
-		internal::x_lockfree_fifo<std::array<T, N>>::push( std::move( tmp ) );
+		internal::x_lockfree_fifo<std::array<T, N>, ReclamationPolicy>::push( std::move( tmp ) );
 	}
 	void push(
 		value_type&& cont_arg   //!< [in]	a value to push this FIFO queue
@@ -361,12 +720,12 @@ public:
 			tmp[i] = std::move( cont_arg[i] );
 		}
 
-		internal::x_lockfree_fifo<std::array<T, N>>::push( std::move( tmp ) );
+		internal::x_lockfree_fifo<std::array<T, N>, ReclamationPolicy>::push( std::move( tmp ) );
 	}
 
 	bool pop( value_type& a )
 	{
-		alcc_optional<std::array<T, N>> ret = internal::x_lockfree_fifo<std::array<T, N>>::pop();
+		alcc_optional<std::array<T, N>> ret = internal::x_lockfree_fifo<std::array<T, N>, ReclamationPolicy>::pop();
 		if ( !ret.has_value() ) {
 			return false;
 		}
@@ -11,15 +11,19 @@
 #ifndef ALCONCCURRENT_INC_LF_LIST_HPP_
 #define ALCONCCURRENT_INC_LF_LIST_HPP_
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <tuple>
 
 #include "hazard_ptr.hpp"
 #include "internal/alcc_optional.hpp"
+#include "internal/ebr_domain.hpp"
 #include "internal/od_lockfree_list.hpp"
 #include "internal/od_node_pool.hpp"
+#include "internal/striped_counter.hpp"
 
 namespace alpha {
 namespace concurrent {
@@ -29,7 +33,7 @@ namespace internal {
 /*!
  * @brief	ロックフリー方式用の単方向型リスト
  */
-template <typename T>
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
 class x_lockfree_list {
 public:
 	static_assert( ( !std::is_class<T>::value ) ||
@@ -46,6 +50,7 @@ public:
 	constexpr x_lockfree_list( void ) noexcept
 	  : lf_list_impl_()
 	  , allocated_node_count_( 0 )
+	  , approx_size_()
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
 	  , call_count_push_front_( 0 )
 	  , call_count_pop_front_( 0 )
@@ -160,6 +165,7 @@ public:
 				ans++;
 			}
 		}
+		approx_size_.sub( ans );
 
 		return ans;
 	}
@@ -310,6 +316,7 @@ public:
 		alcc_optional<od_lockfree_list::hazard_pointer_w_mark> ret = lf_list_impl_.remove_mark_head();
 		if ( !ret.has_value() ) return alcc_nullopt;
 		if ( ret.value().hp_.get() == nullptr ) return alcc_nullopt;
+		approx_size_.sub( 1 );
 
 		node_pointer p = static_cast<node_pointer>( ret.value().hp_.get() );
 		return alcc_optional<value_type> { std::move( p->get_value() ) };
@@ -325,6 +332,7 @@ public:
 		alcc_optional<od_lockfree_list::hazard_pointer_w_mark> ret = lf_list_impl_.remove_mark_head();
 		if ( !ret.has_value() ) return alcc_nullopt;
 		if ( ret.value().hp_.get() == nullptr ) return alcc_nullopt;
+		approx_size_.sub( 1 );
 
 		node_pointer p = static_cast<node_pointer>( ret.value().hp_.get() );
 		return alcc_optional<value_type> { p->get_value() };
@@ -395,6 +403,7 @@ public:
 		alcc_optional<od_lockfree_list::hazard_pointer_w_mark> ret = lf_list_impl_.remove_mark_tail();
 		if ( !ret.has_value() ) return alcc_nullopt;
 		if ( ret.value().hp_.get() == nullptr ) return alcc_nullopt;
+		approx_size_.sub( 1 );
 
 		node_pointer p = static_cast<node_pointer>( ret.value().hp_.get() );
 		return alcc_optional<value_type> { std::move( p->get_value() ) };
@@ -410,6 +419,7 @@ public:
 		alcc_optional<od_lockfree_list::hazard_pointer_w_mark> ret = lf_list_impl_.remove_mark_tail();
 		if ( !ret.has_value() ) return alcc_nullopt;
 		if ( ret.value().hp_.get() == nullptr ) return alcc_nullopt;
+		approx_size_.sub( 1 );
 
 		node_pointer p = static_cast<node_pointer>( ret.value().hp_.get() );
 		return alcc_optional<value_type> { p->get_value() };
@@ -426,6 +436,27 @@ public:
 		return lf_list_impl_.count_size();
 	}
 
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * This does not traverse the nodes, and sums the striped counters that are updated by insert/push/pop/remove. Therefore, this is cheap enough to be called frequently.
+	 * The values that are being inserted or removed concurrently may or may not be counted.
+	 */
+	size_t approximate_size( void ) const noexcept
+	{
+		return approx_size_.load();
+	}
+
+	/*!
+	 * @brief	check whether this list has no value
+	 *
+	 * This skips the nodes that are marked as deleted from the head, and does not traverse whole of this list.
+	 */
+	bool is_empty( void ) const
+	{
+		return lf_list_impl_.is_empty();
+	}
+
 	/*!
 	 * @brief	get the total number of the allocated internal nodes
 	 *
@@ -486,6 +517,7 @@ private:
 		do {
 			ret = find_if_impl( pred );
 		} while ( !lf_list_impl_.insert_to_next_of_prev( p_in, ret.first, ret.second ) );
+		approx_size_.add( 1 );
 	}
 	void insert_to_next_of_prev_impl( node_pointer p_in, predicate_t&& pred )
 	{
@@ -497,6 +529,7 @@ private:
 		do {
 			ret = find_if_impl( pred );
 		} while ( !lf_list_impl_.insert_to_before_of_curr( p_in, ret.first, ret.second ) );
+		approx_size_.add( 1 );
 	}
 	void insert_to_before_of_curr_impl( node_pointer p_in, predicate_t&& pred )
 	{
@@ -514,6 +547,7 @@ private:
 				return alcc_nullopt;
 			}
 		} while ( !lf_list_impl_.remove_mark( ret.second ) );
+		approx_size_.sub( 1 );
 
 		return alcc_optional<std::pair<od_lockfree_list::hazard_pointer_w_mark, od_lockfree_list::hazard_pointer_w_mark>> { std::move( ret ) };
 	}
@@ -528,6 +562,7 @@ private:
 
 	node_list_lockfree_t lf_list_impl_;           //!< lock free list
 	std::atomic<size_t>  allocated_node_count_;   //!< number of allocated node count
+	striped_counter      approx_size_;            //!< approximate number of the values
 
 #ifdef ALCONCURRENT_CONF_ENABLE_OD_NODE_PROFILE
 	std::atomic<size_t> call_count_push_front_;
@@ -537,36 +572,529 @@ private:
 #endif
 };
 
+/*!
+ * @brief	ロックフリー方式用の単方向型リスト(epoch based reclamation版)
+ *
+ * Harris-Michael方式のリスト。ノードのnextポインタの最下位ビットを削除マークとして使う。
+ * 各APIの先頭で1回だけエポックをアナウンスするため、find_ifやfor_eachのようにノードをたどる処理で、ノード毎のハザードポインタの登録と再検証が不要になる。
+ * ノードはpush毎に確保し、リストから外したスレッドがebr_domain::Retire()で破棄を依頼する。
+ */
+template <typename T>
+class x_lockfree_list<T, epoch_based_reclamation> {
+public:
+	static_assert( ( !std::is_class<T>::value ) ||
+	                   ( std::is_class<T>::value &&
+	                     ( ( std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value ) ||
+	                       ( std::is_move_constructible<T>::value && std::is_move_assignable<T>::value ) ) ),
+	               "T should be copy constructible and copy assignable, or, move constructible and move assignable" );
+
+	using value_type            = T;
+	using predicate_t           = std::function<bool( const value_type& )>;   //!< find_if関数で使用する述語関数を保持するfunction型
+	using for_each_func_t       = std::function<void( value_type& )>;         //!< for_each関数で各要素の処理を実行するための関数を保持するfunction型
+	using for_each_const_func_t = std::function<void( const value_type& )>;   //!< for_each関数で各要素の処理を実行するための関数を保持するfunction型
+
+	constexpr x_lockfree_list( void ) noexcept
+	  : head_( 0 )
+	  , allocated_node_count_( 0 )
+	  , approx_size_()
+	{
+	}
+	x_lockfree_list( size_t reserve_size )
+	  : x_lockfree_list()
+	{
+		static_cast<void>( reserve_size );   // ノードはpush毎に確保するため、予約は行わない。
+	}
+
+	~x_lockfree_list()
+	{
+		// 削除マーク済みでまだリストから外されていないノードも、ここで破棄する。
+		node_pointer p_cur = to_node_pointer( head_.load( std::memory_order_acquire ) );
+		while ( p_cur != nullptr ) {
+			node_pointer p_next = to_node_pointer( p_cur->next_.load( std::memory_order_acquire ) );
+			delete p_cur;
+			p_cur = p_next;
+		}
+	}
+
+	void find_if( predicate_t& f )
+	{
+		ebr_domain::critical_section cs;
+		find_if_impl( f );
+	}
+	void find_if( predicate_t&& f )
+	{
+		find_if( f );
+	}
+
+	/**
+	 * @brief 値を挿入する
+	 *
+	 * predがtrueを返すノードを見つけられなかった場合、リストの最後に挿入される。
+	 *
+	 * @param cont_arg 挿入する値
+	 * @param pred 挿入個所を見つけるための関数オブジェクト
+	 */
+	template <bool IsMovable = std::is_move_assignable<value_type>::value, typename std::enable_if<IsMovable>::type* = nullptr>
+	void insert(
+		predicate_t& pred,      //!< [in]	A predicate function to specify the insertion position. const value_type& is passed as an argument
+		value_type&& cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( std::move( cont_arg ) ), pred );
+	}
+	template <bool IsCopyable = std::is_copy_assignable<value_type>::value, typename std::enable_if<IsCopyable>::type* = nullptr>
+	void insert(
+		predicate_t&      pred,      //!< [in]	A predicate function to specify the insertion position. const value_type& is passed as an argument
+		const value_type& cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( cont_arg ), pred );
+	}
+	template <bool IsMovable = std::is_move_assignable<value_type>::value, typename std::enable_if<IsMovable>::type* = nullptr>
+	void insert(
+		predicate_t&& pred,      //!< [in]	A predicate function to specify the insertion position. const value_type& is passed as an argument
+		value_type&&  cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( std::move( cont_arg ) ), pred );
+	}
+	template <bool IsCopyable = std::is_copy_assignable<value_type>::value, typename std::enable_if<IsCopyable>::type* = nullptr>
+	void insert(
+		predicate_t&&     pred,      //!< [in]	A predicate function to specify the insertion position. const value_type& is passed as an argument
+		const value_type& cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( cont_arg ), pred );
+	}
+
+	/*!
+	 * @brief	remove all of nodes that pred return true from this list
+	 */
+	size_t remove_all_if(
+		predicate_t& pred   //!< [in]	A predicate function to specify the deletion target. const value_type& is passed as an argument
+	)
+	{
+		ebr_domain::critical_section cs;
+
+		size_t ans = 0;
+		while ( mark_one_if( pred ) != nullptr ) {
+			ans++;
+		}
+		return ans;
+	}
+	size_t remove_all_if(
+		predicate_t&& pred   //!< [in]	A predicate function to specify the deletion target. const value_type& is passed as an argument
+	)
+	{
+		return remove_all_if( pred );
+	}
+
+	/*!
+	 * @brief	remove a first node that pred return true from this list
+	 */
+	alcc_optional<value_type> remove_one_if(
+		predicate_t& pred   //!< [in]	A predicate function to specify the deletion target. const value_type& is passed as an argument
+	)
+	{
+		ebr_domain::critical_section cs;
+
+		node_pointer p = mark_one_if( pred );
+		if ( p == nullptr ) return alcc_nullopt;
+
+		// 削除マークに成功したスレッドだけが値を取り出す。ノードの破棄はクリティカルセクションを抜けるまで行われない。
+		return alcc_optional<value_type> { std::move( p->value_ ) };
+	}
+	alcc_optional<value_type> remove_one_if(
+		predicate_t&& pred   //!< [in]	A predicate function to specify the deletion target. const value_type& is passed as an argument
+	)
+	{
+		return remove_one_if( pred );
+	}
+
+	/*!
+	 * @brief	Applies the specified function to all elements.
+	 *
+	 * @warning
+	 * Due to the lock-free nature, it is possible that the element being processed may be deleted or modified.
+	 * Therefore, when changing an element, it is necessary to perform access control such as exclusive control in Function f.
+	 */
+	void for_each(
+		for_each_func_t& f   //!< [in]	A function f is passed value_type& as an argument
+	)
+	{
+		ebr_domain::critical_section cs;
+
+		node_pointer p_cur = to_node_pointer( head_.load( std::memory_order_acquire ) );
+		while ( p_cur != nullptr ) {
+			std::uintptr_t next_v = p_cur->next_.load( std::memory_order_acquire );
+			if ( !is_marked( next_v ) ) {
+				f( p_cur->value_ );
+			}
+			p_cur = to_node_pointer( next_v );
+		}
+	}
+	void for_each(
+		for_each_func_t&& f   //!< [in]	A function f is passed value_type& as an argument
+	)
+	{
+		for_each( f );
+	}
+
+	/*!
+	 * @brief	push a value to the front of this list
+	 */
+	template <bool IsCopyable = std::is_copy_assignable<value_type>::value, typename std::enable_if<IsCopyable>::type* = nullptr>
+	void push_front(
+		const value_type& cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( cont_arg ), []( const value_type& ) -> bool { return true; } );
+	}
+	template <bool IsMovable = std::is_move_assignable<value_type>::value, typename std::enable_if<IsMovable>::type* = nullptr>
+	void push_front(
+		value_type&& cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( std::move( cont_arg ) ), []( const value_type& ) -> bool { return true; } );
+	}
+
+	template <typename... Args>
+	void emplace_front(
+		Args&&... args   //!< [in]	a value to insert to front of this list
+	)
+	{
+		insert_impl( alloc_node_impl( std::forward<Args>( args )... ), []( const value_type& ) -> bool { return true; } );
+	}
+
+	/*!
+	 * @brief	pop a value from the front of this list
+	 */
+	alcc_optional<value_type> pop_front( void )
+	{
+		return remove_one_if( []( const value_type& ) -> bool { return true; } );
+	}
+
+	/*!
+	 * @brief	append a value to the end of this list
+	 */
+	template <bool IsCopyable = std::is_copy_assignable<value_type>::value, typename std::enable_if<IsCopyable>::type* = nullptr>
+	void push_back(
+		const value_type& cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( cont_arg ), []( const value_type& ) -> bool { return false; } );
+	}
+	template <bool IsMovable = std::is_move_assignable<value_type>::value, typename std::enable_if<IsMovable>::type* = nullptr>
+	void push_back(
+		value_type&& cont_arg   //!< [in]	a value to insert this list
+	)
+	{
+		insert_impl( alloc_node_impl( std::move( cont_arg ) ), []( const value_type& ) -> bool { return false; } );
+	}
+	template <typename... Args>
+	void emplace_back(
+		Args&&... args   //!< [in]	a value to insert to back of this list
+	)
+	{
+		insert_impl( alloc_node_impl( std::forward<Args>( args )... ), []( const value_type& ) -> bool { return false; } );
+	}
+
+	/*!
+	 * @brief	pop a value from the end of this list
+	 */
+	alcc_optional<value_type> pop_back( void )
+	{
+		ebr_domain::critical_section cs;
+
+		while ( true ) {
+			// 削除マークされていない最後のノードを探す。
+			std::atomic<std::uintptr_t>* p_last_prev_link = nullptr;
+			node_pointer                 p_last           = nullptr;
+			std::uintptr_t               last_next_v      = 0;
+
+			std::atomic<std::uintptr_t>* p_prev_link = &head_;
+			node_pointer                 p_cur       = to_node_pointer( head_.load( std::memory_order_acquire ) );
+			while ( p_cur != nullptr ) {
+				std::uintptr_t next_v = p_cur->next_.load( std::memory_order_acquire );
+				if ( !is_marked( next_v ) ) {
+					p_last_prev_link = p_prev_link;
+					p_last           = p_cur;
+					last_next_v      = next_v;
+				}
+				p_prev_link = &( p_cur->next_ );
+				p_cur       = to_node_pointer( next_v );
+			}
+			if ( p_last == nullptr ) return alcc_nullopt;
+
+			// 削除マークされたノードのnextは変更されないため、p_lastのnextが変わっていなければ、後ろには削除マーク済みのノードしかない。
+			if ( !p_last->next_.compare_exchange_strong( last_next_v, last_next_v | mark_bit, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+				continue;
+			}
+			approx_size_.sub( 1 );
+			try_unlink( p_last_prev_link, p_last, last_next_v );
+
+			return alcc_optional<value_type> { std::move( p_last->value_ ) };
+		}
+	}
+
+	/*!
+	 * @brief	get the total number of the nodes
+	 *
+	 * @warning
+	 * This List will be access by several thread concurrently. So, true number of this List may be changed when caller uses the returned value.
+	 */
+	size_t count_size( void ) const
+	{
+		ebr_domain::critical_section cs;
+
+		size_t       ans   = 0;
+		node_pointer p_cur = to_node_pointer( head_.load( std::memory_order_acquire ) );
+		while ( p_cur != nullptr ) {
+			std::uintptr_t next_v = p_cur->next_.load( std::memory_order_acquire );
+			if ( !is_marked( next_v ) ) {
+				ans++;
+			}
+			p_cur = to_node_pointer( next_v );
+		}
+		return ans;
+	}
+
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * This does not traverse the nodes, and sums the striped counters that are updated by insert/push/pop/remove. Therefore, this is cheap enough to be called frequently.
+	 * The values that are being inserted or removed concurrently may or may not be counted.
+	 */
+	size_t approximate_size( void ) const noexcept
+	{
+		return approx_size_.load();
+	}
+
+	/*!
+	 * @brief	check whether this list has no value
+	 *
+	 * This skips the nodes that are marked as deleted from the head, and does not traverse whole of this list.
+	 */
+	bool is_empty( void ) const
+	{
+		ebr_domain::critical_section cs;
+
+		node_pointer p_cur = to_node_pointer( head_.load( std::memory_order_acquire ) );
+		while ( p_cur != nullptr ) {
+			std::uintptr_t next_v = p_cur->next_.load( std::memory_order_acquire );
+			if ( !is_marked( next_v ) ) {
+				return false;
+			}
+			p_cur = to_node_pointer( next_v );
+		}
+		return true;
+	}
+
+	/*!
+	 * @brief	get the number of the nodes that are allocated and are not retired yet
+	 *
+	 * @warning
+	 * This List will be access by several thread concurrently. So, true number of this List may be changed when caller uses the returned value.
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		return allocated_node_count_.load();
+	}
+
+	static void clear_node_pool_as_possible_as( void )
+	{
+		ebr_domain::DrainRetired();
+	}
+
+private:
+	struct node_type {
+		template <typename... Args>
+		node_type( Args&&... args )
+		  : value_( std::forward<Args>( args )... )
+		  , next_( 0 )
+		{
+		}
+
+		static void deleter( void* p )
+		{
+			delete static_cast<node_type*>( p );
+		}
+
+		value_type                  value_;
+		std::atomic<std::uintptr_t> next_;   //!< 次のノードへのポインタ。最下位ビットは、このノードの削除マーク
+	};
+	using node_pointer = node_type*;
+
+	static constexpr std::uintptr_t mark_bit = 1U;
+
+	static bool is_marked( std::uintptr_t v ) noexcept
+	{
+		return ( v & mark_bit ) != 0;
+	}
+	static node_pointer to_node_pointer( std::uintptr_t v ) noexcept
+	{
+		return reinterpret_cast<node_pointer>( v & ~mark_bit );
+	}
+	static std::uintptr_t to_link_value( node_pointer p ) noexcept
+	{
+		return reinterpret_cast<std::uintptr_t>( p );
+	}
+
+	/*!
+	 * @brief	find_if_implの結果。p_curr_がnullptrの場合、p_prev_link_はリストの最後のリンクを指す。
+	 */
+	struct find_result {
+		std::atomic<std::uintptr_t>* p_prev_link_;   //!< p_curr_を指しているリンク
+		node_pointer                 p_curr_;        //!< predがtrueを返した最初のノード
+	};
+
+	template <typename... Args>
+	node_pointer alloc_node_impl( Args&&... args )
+	{
+		node_pointer p_new_node = new node_type( std::forward<Args>( args )... );
+		allocated_node_count_++;
+		return p_new_node;
+	}
+
+	/*!
+	 * @brief	predがtrueを返す削除マークのない最初のノードを探す
+	 *
+	 * 探索の途中で見つけた削除マーク済みのノードはリストから外し、破棄を依頼する。
+	 *
+	 * @pre	クリティカルセクション内で呼び出すこと
+	 */
+	template <typename Pred>
+	find_result find_if_impl( Pred& pred )
+	{
+		while ( true ) {
+			std::atomic<std::uintptr_t>* p_prev_link = &head_;
+			node_pointer                 p_cur       = to_node_pointer( head_.load( std::memory_order_acquire ) );
+			bool                         is_retry    = false;
+			while ( p_cur != nullptr ) {
+				std::uintptr_t next_v = p_cur->next_.load( std::memory_order_acquire );
+				if ( is_marked( next_v ) ) {
+					// 前のノードが削除マークされていたり、前のノードのリンクが変わっていたら、CASが失敗するので先頭からやり直す。
+					std::uintptr_t expected = to_link_value( p_cur );
+					if ( !p_prev_link->compare_exchange_strong( expected, next_v & ~mark_bit, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+						is_retry = true;
+						break;
+					}
+					retire_node( p_cur );
+					p_cur = to_node_pointer( next_v );
+					continue;
+				}
+				if ( pred( p_cur->value_ ) ) {
+					return find_result { p_prev_link, p_cur };
+				}
+				p_prev_link = &( p_cur->next_ );
+				p_cur       = to_node_pointer( next_v );
+			}
+			if ( !is_retry ) {
+				return find_result { p_prev_link, nullptr };
+			}
+		}
+	}
+
+	template <typename Pred>
+	void insert_impl( node_pointer p_in, Pred&& pred )
+	{
+		ebr_domain::critical_section cs;
+
+		while ( true ) {
+			find_result ret = find_if_impl( pred );
+			p_in->next_.store( to_link_value( ret.p_curr_ ), std::memory_order_relaxed );
+			std::uintptr_t expected = to_link_value( ret.p_curr_ );
+			if ( ret.p_prev_link_->compare_exchange_strong( expected, to_link_value( p_in ), std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+				break;
+			}
+		}
+		approx_size_.add( 1 );
+	}
+
+	/*!
+	 * @brief	predがtrueを返す最初のノードに削除マークを付ける
+	 *
+	 * @pre	クリティカルセクション内で呼び出すこと
+	 *
+	 * @return	削除マークを付けたノード。nullptrの場合、predがtrueを返すノードはなかった。
+	 */
+	node_pointer mark_one_if( predicate_t& pred )
+	{
+		while ( true ) {
+			find_result ret = find_if_impl( pred );
+			if ( ret.p_curr_ == nullptr ) return nullptr;
+
+			std::uintptr_t next_v = ret.p_curr_->next_.load( std::memory_order_acquire );
+			if ( is_marked( next_v ) ) continue;
+			if ( !ret.p_curr_->next_.compare_exchange_strong( next_v, next_v | mark_bit, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+				continue;
+			}
+			approx_size_.sub( 1 );
+			try_unlink( ret.p_prev_link_, ret.p_curr_, next_v );
+			return ret.p_curr_;
+		}
+	}
+
+	/*!
+	 * @brief	削除マークを付けたノードをリストから外すことを1回だけ試みる
+	 *
+	 * 失敗した場合は、次にノードをたどったスレッドがリストから外す。
+	 */
+	void try_unlink( std::atomic<std::uintptr_t>* p_prev_link, node_pointer p_marked, std::uintptr_t next_v )
+	{
+		std::uintptr_t expected = to_link_value( p_marked );
+		if ( p_prev_link->compare_exchange_strong( expected, next_v, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+			retire_node( p_marked );
+		}
+	}
+
+	void retire_node( node_pointer p_nd )
+	{
+		allocated_node_count_--;
+		ebr_domain::Retire( p_nd, &node_type::deleter );
+	}
+
+	std::atomic<std::uintptr_t> head_;                   //!< 先頭のノードへのリンク。削除マークは付かない
+	std::atomic<size_t>         allocated_node_count_;   //!< number of nodes that are allocated and are not retired yet
+	striped_counter             approx_size_;            //!< approximate number of the values
+};
+
 }   // namespace internal
 
-template <typename T>
-class lockfree_list : public internal::x_lockfree_list<T> {
+/**
+ * @brief semi lock-free list
+ *
+ * @tparam T type of value
+ * @tparam ReclamationPolicy hazard_ptr_reclamation(default) or epoch_based_reclamation
+ */
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
+class lockfree_list : public internal::x_lockfree_list<T, ReclamationPolicy> {
 public:
 	lockfree_list( void ) noexcept = default;
 	lockfree_list( size_t reserve_size )
-	  : internal::x_lockfree_list<T>( reserve_size )
+	  : internal::x_lockfree_list<T, ReclamationPolicy>( reserve_size )
 	{
 	}
 };
-template <typename T>
-class lockfree_list<T[]> : public internal::x_lockfree_list<T*> {
+template <typename T, typename ReclamationPolicy>
+class lockfree_list<T[], ReclamationPolicy> : public internal::x_lockfree_list<T*, ReclamationPolicy> {
 public:
 	using value_type = T[];
 
 	lockfree_list( void ) noexcept = default;
 	lockfree_list( size_t reserve_size )
-	  : internal::x_lockfree_list<T*>( reserve_size )
+	  : internal::x_lockfree_list<T*, ReclamationPolicy>( reserve_size )
 	{
 	}
 };
-template <typename T, size_t N>
-class lockfree_list<T[N]> : public internal::x_lockfree_list<std::array<T, N>> {
+template <typename T, size_t N, typename ReclamationPolicy>
+class lockfree_list<T[N], ReclamationPolicy> : public internal::x_lockfree_list<std::array<T, N>, ReclamationPolicy> {
 public:
 	using value_type = T[N];
 
 	lockfree_list( void ) noexcept = default;
 	lockfree_list( size_t reserve_size )
-	  : internal::x_lockfree_list<std::array<T, N>>( reserve_size )
+	  : internal::x_lockfree_list<std::array<T, N>, ReclamationPolicy>( reserve_size )
 	{
 	}
 };
@@ -0,0 +1,336 @@
+/**
+ * @file lf_mpsc_fifo.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief fifo for multiple producers and single consumer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * This is the intrusive MPSC queue by Dmitry Vyukov.
+ * push is one atomic exchange and one store. pop is done by only one consumer thread, therefore pop does not need CAS and hazard pointer.
+ */
+
+#ifndef ALCONCCURRENT_INC_LF_MPSC_FIFO_HPP_
+#define ALCONCCURRENT_INC_LF_MPSC_FIFO_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "internal/alcc_optional.hpp"
+#include "internal/od_node_essence.hpp"
+#include "internal/od_node_pool.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief link for intrusive_mpsc_fifo
+ *
+ * A value type of intrusive_mpsc_fifo should be a derived class of this class.
+ */
+class mpsc_fifo_hook {
+public:
+	constexpr mpsc_fifo_hook( void ) noexcept
+	  : ap_mpsc_next_( nullptr )
+	{
+	}
+	mpsc_fifo_hook( const mpsc_fifo_hook& ) noexcept
+	  : ap_mpsc_next_( nullptr )
+	{
+	}
+	mpsc_fifo_hook& operator=( const mpsc_fifo_hook& ) noexcept
+	{
+		return *this;   // リンクはコピーしない
+	}
+
+	mpsc_fifo_hook* next( void ) const noexcept
+	{
+		return ap_mpsc_next_.load( std::memory_order_acquire );
+	}
+
+	void set_next( mpsc_fifo_hook* p_n ) noexcept
+	{
+		ap_mpsc_next_.store( p_n, std::memory_order_release );
+	}
+
+private:
+	std::atomic<mpsc_fifo_hook*> ap_mpsc_next_;
+};
+
+namespace internal {
+
+/**
+ * @brief core logic of the intrusive MPSC queue
+ *
+ * @tparam LINK_T link type that has next() and set_next()
+ */
+template <typename LINK_T>
+class x_mpsc_fifo_core {
+public:
+	using link_pointer = LINK_T*;
+
+	x_mpsc_fifo_core( void )
+	  : ap_head_( &stub_ )
+	  , p_tail_( &stub_ )
+	  , stub_()
+	{
+	}
+
+	x_mpsc_fifo_core( const x_mpsc_fifo_core& )            = delete;
+	x_mpsc_fifo_core( x_mpsc_fifo_core&& )                 = delete;
+	x_mpsc_fifo_core& operator=( const x_mpsc_fifo_core& ) = delete;
+	x_mpsc_fifo_core& operator=( x_mpsc_fifo_core&& )      = delete;
+
+	/**
+	 * @brief push a node
+	 *
+	 * This can be called by any thread.
+	 */
+	void push( link_pointer p_nd ) noexcept
+	{
+		p_nd->set_next( nullptr );
+		link_pointer p_prev = ap_head_.exchange( p_nd, std::memory_order_acq_rel );
+		// ここで中断すると、p_prevより後ろのノードは、set_next()が完了するまでpopできない。
+		p_prev->set_next( p_nd );
+	}
+
+	/**
+	 * @brief pop a node
+	 *
+	 * This should be called by the consumer thread only.
+	 *
+	 * @return link_pointer popped node. If fifo is empty, or a producer does not complete push yet, nullptr.
+	 */
+	link_pointer pop( void ) noexcept
+	{
+		link_pointer p_tail = p_tail_;
+		link_pointer p_next = p_tail->next();
+		if ( p_tail == &stub_ ) {
+			if ( p_next == nullptr ) return nullptr;
+			p_tail_ = p_next;
+			p_tail  = p_next;
+			p_next  = p_next->next();
+		}
+		if ( p_next != nullptr ) {
+			p_tail_ = p_next;
+			return p_tail;
+		}
+
+		if ( p_tail != ap_head_.load( std::memory_order_acquire ) ) {
+			// producerがpushの途中
+			return nullptr;
+		}
+
+		// 最後のノードを取り出すために、stubを末尾につなぐ
+		push( &stub_ );
+		p_next = p_tail->next();
+		if ( p_next == nullptr ) return nullptr;
+
+		p_tail_ = p_next;
+		return p_tail;
+	}
+
+	bool is_empty( void ) const noexcept
+	{
+		return ap_head_.load( std::memory_order_acquire ) == &stub_;
+	}
+
+private:
+	alignas( atomic_variable_align ) std::atomic<link_pointer> ap_head_;   //!< last pushed node. updated by producers
+	alignas( atomic_variable_align ) link_pointer p_tail_;                 //!< next node to pop. accessed by consumer only
+	LINK_T stub_;                                                          //!< dummy node to keep the list non-empty
+};
+
+}   // namespace internal
+
+/**
+ * @brief intrusive fifo for multiple producers and single consumer, e.g. mailbox of an actor
+ *
+ * This fifo does not own the pushed object. The consumer gets the pointer to the pushed object by pop() or consume_all().
+ * An object should not be pushed again until it is popped.
+ *
+ * pop()とconsume_all()は、1つのスレッドからのみ呼び出すこと。push()は、任意のスレッドから呼び出してよい。
+ *
+ * @tparam T value type that is a derived class of mpsc_fifo_hook
+ */
+template <typename T>
+class intrusive_mpsc_fifo {
+public:
+	static_assert( std::is_base_of<mpsc_fifo_hook, T>::value, "T should be a derived class of mpsc_fifo_hook" );
+
+	using value_type = T;
+
+	void push( T* p_obj ) noexcept
+	{
+		core_.push( static_cast<mpsc_fifo_hook*>( p_obj ) );
+	}
+
+	/**
+	 * @brief pop an object
+	 *
+	 * @return T* popped object. If fifo is empty, or a producer does not complete push yet, nullptr.
+	 */
+	T* pop( void ) noexcept
+	{
+		return static_cast<T*>( core_.pop() );
+	}
+
+	/**
+	 * @brief pop all objects that can be popped, and call f( T* ) for each object in fifo order
+	 *
+	 * @return size_t the number of popped objects
+	 */
+	template <typename F>
+	size_t consume_all( F&& f )
+	{
+		size_t ans = 0;
+		for ( T* p = pop(); p != nullptr; p = pop() ) {
+			f( p );
+			ans++;
+		}
+		return ans;
+	}
+
+	bool is_empty( void ) const noexcept
+	{
+		return core_.is_empty();
+	}
+
+private:
+	internal::x_mpsc_fifo_core<mpsc_fifo_hook> core_;
+};
+
+/**
+ * @brief fifo for multiple producers and single consumer that carries a value
+ *
+ * The node to carry a value is got from od_node_pool that is shared with fifo_list<T>.
+ *
+ * pop()とconsume_all()は、1つのスレッドからのみ呼び出すこと。push()は、任意のスレッドから呼び出してよい。
+ *
+ * @tparam T type of value
+ */
+template <typename T>
+class mpsc_fifo {
+public:
+	static_assert( std::is_move_assignable<T>::value || std::is_copy_assignable<T>::value,
+	               "T should be move assignable or copy assignable" );
+
+	using value_type = T;
+
+	mpsc_fifo( void )
+	  : core_()
+	  , allocated_node_count_( 0 )
+	{
+	}
+
+	~mpsc_fifo()
+	{
+		consume_all( []( value_type&& ) {} );
+
+		for ( size_t i = 0; i < allocated_node_count_.load(); i++ ) {   // allocateしたノードをすべて開放する
+			delete node_pool_t::pop();
+		}
+	}
+
+	mpsc_fifo( const mpsc_fifo& )            = delete;
+	mpsc_fifo( mpsc_fifo&& )                 = delete;
+	mpsc_fifo& operator=( const mpsc_fifo& ) = delete;
+	mpsc_fifo& operator=( mpsc_fifo&& )      = delete;
+
+	void push( const T& v_arg )
+	{
+		emplace( v_arg );
+	}
+	void push( T&& v_arg )
+	{
+		emplace( std::move( v_arg ) );
+	}
+
+	template <typename... Args>
+	void emplace( Args&&... args )
+	{
+		node_pointer p_new_nd = node_pool_t::pop();
+		if ( p_new_nd != nullptr ) {
+			p_new_nd->emplace_value( std::forward<Args>( args )... );
+		} else {
+			allocated_node_count_++;
+			p_new_nd = new node_type( alcc_in_place, std::forward<Args>( args )... );
+		}
+		core_.push( static_cast<link_pointer>( p_new_nd ) );
+	}
+
+	/**
+	 * @brief pop a value
+	 *
+	 * @return alcc_optional<value_type> popped value. If fifo is empty, or a producer does not complete push yet, alcc_nullopt.
+	 */
+	alcc_optional<value_type> pop( void )
+	{
+		link_pointer p_link = core_.pop();
+		if ( p_link == nullptr ) return alcc_nullopt;
+
+		node_pointer              p_nd = static_cast<node_pointer>( p_link );
+		alcc_optional<value_type> ans( alcc_in_place, take_value( p_nd ) );
+		node_pool_t::push( p_nd );
+		return ans;
+	}
+
+	/**
+	 * @brief pop all values that can be popped, and call f( value_type&& ) for each value in fifo order
+	 *
+	 * @return size_t the number of popped values
+	 */
+	template <typename F>
+	size_t consume_all( F&& f )
+	{
+		size_t ans = 0;
+		for ( link_pointer p_link = core_.pop(); p_link != nullptr; p_link = core_.pop() ) {
+			node_pointer p_nd = static_cast<node_pointer>( p_link );
+			f( take_value( p_nd ) );
+			node_pool_t::push( p_nd );
+			ans++;
+		}
+		return ans;
+	}
+
+	bool is_empty( void ) const noexcept
+	{
+		return core_.is_empty();
+	}
+
+	/*!
+	 * @brief	get the total number of the allocated internal nodes
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		return allocated_node_count_.load();
+	}
+
+private:
+	using node_type    = internal::od_node_type1<T>;
+	using node_pointer = internal::od_node_type1<T>*;
+	using link_pointer = internal::od_node_link_by_hazard_handler*;
+	using node_pool_t  = internal::od_node_pool<node_type>;
+
+	template <bool IsMovable = std::is_move_assignable<T>::value, typename std::enable_if<IsMovable>::type* = nullptr>
+	static value_type take_value( node_pointer p_nd )
+	{
+		return std::move( *p_nd ).get_value();
+	}
+	template <bool IsMovable = std::is_move_assignable<T>::value, typename std::enable_if<!IsMovable>::type* = nullptr>
+	static value_type take_value( node_pointer p_nd )
+	{
+		return p_nd->get_value();
+	}
+
+	internal::x_mpsc_fifo_core<internal::od_node_link_by_hazard_handler> core_;
+	std::atomic<size_t>                                                   allocated_node_count_;   //!< allocated nodes count
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
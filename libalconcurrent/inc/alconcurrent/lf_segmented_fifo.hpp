@@ -0,0 +1,365 @@
+/**
+ * @file lf_segmented_fifo.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief unbounded fifo that consists of array segments, and a cell is claimed by fetch_add
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * This is the FAA array queue by Pedro Ramalhete and Andreia Correia, that is the simplified form of LCRQ.
+ * A producer and a consumer claim a cell of the segment by fetch_add of the enqueue/dequeue index.
+ * Therefore, CAS of head/tail is done only once per segment, instead of once per push/pop like fifo_list.
+ * A segment is protected by hazard pointer, and recycled by od_node_pool.
+ */
+
+#ifndef ALCONCCURRENT_INC_LF_SEGMENTED_FIFO_HPP_
+#define ALCONCCURRENT_INC_LF_SEGMENTED_FIFO_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "hazard_ptr.hpp"
+#include "internal/alcc_optional.hpp"
+#include "internal/od_node_essence.hpp"
+#include "internal/od_node_pool.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief unbounded fifo for high throughput under many producers and consumers
+ *
+ * This has the same push/pop interface of fifo_list. push_head() is not supported.
+ *
+ * @note
+ * If a consumer claims a cell before the producer of that cell writes a value, the consumer abandons that cell, and the producer retries on other cell.
+ * Therefore, a value is not lost, but a cell may be wasted.
+ *
+ * @tparam T type of value. T should be move constructible and move assignable, or, copy constructible and copy assignable.
+ * @tparam SegmentSize number of cells in one segment
+ */
+template <typename T, size_t SegmentSize = 256>
+class segmented_fifo_list {
+public:
+	static_assert( ( std::is_move_constructible<T>::value && std::is_move_assignable<T>::value ) ||
+	                   ( std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value ),
+	               "T should be move constructible and move assignable, or, copy constructible and copy assignable" );
+	static_assert( SegmentSize > 0, "SegmentSize should be greater than 0" );
+
+	using value_type = T;
+
+	segmented_fifo_list( void )
+	  : hph_head_( nullptr )
+	  , hph_tail_( nullptr )
+	  , allocated_segment_count_( 0 )
+	{
+		link_pointer p_sentinel = link_of( allocate_segment() );
+		hph_head_.store( p_sentinel );
+		hph_tail_.store( p_sentinel );
+	}
+	/**
+	 * @brief constructor with reservation
+	 *
+	 * @param reserve_size number of values to reserve the segments
+	 */
+	explicit segmented_fifo_list( size_t reserve_size )
+	  : segmented_fifo_list()
+	{
+		size_t n = ( reserve_size + SegmentSize - 1 ) / SegmentSize;
+		for ( size_t i = 0; i < n; i++ ) {
+			segment_pool_t::push( new segment_type );
+		}
+		allocated_segment_count_ += n;
+	}
+
+	~segmented_fifo_list()
+	{
+		auto tmp = pop();
+		while ( tmp.has_value() ) {
+			tmp = pop();
+		}
+
+		link_pointer p_cur = hph_head_.load();
+		hph_head_.store( nullptr );
+		hph_tail_.store( nullptr );
+		while ( p_cur != nullptr ) {
+			link_pointer p_next = p_cur->next();
+			segment_pool_t::push( segment_of( p_cur ) );
+			p_cur = p_next;
+		}
+
+		for ( size_t i = 0; i < allocated_segment_count_.load(); i++ ) {   // allocateしたセグメントをすべて開放する
+			delete segment_pool_t::pop();
+		}
+	}
+
+	segmented_fifo_list( const segmented_fifo_list& )            = delete;
+	segmented_fifo_list( segmented_fifo_list&& )                 = delete;
+	segmented_fifo_list& operator=( const segmented_fifo_list& ) = delete;
+	segmented_fifo_list& operator=( segmented_fifo_list&& )      = delete;
+
+	void push( const T& v_arg )
+	{
+		value_type v( v_arg );
+		push_impl( v );
+	}
+	void push( T&& v_arg )
+	{
+		push_impl( v_arg );
+	}
+
+	template <typename... Args>
+	void emplace( Args&&... args )
+	{
+		value_type v( std::forward<Args>( args )... );
+		push_impl( v );
+	}
+
+	alcc_optional<value_type> pop( void )
+	{
+		hazard_pointer hp_head = hph_head_.get_to_verify_exchange();
+		while ( true ) {
+			if ( !hph_head_.verify_exchange( hp_head ) ) {
+				continue;
+			}
+			segment_pointer p_head = segment_of( hp_head.get() );
+
+			if ( ( p_head->deq_idx_.load( std::memory_order_acquire ) >= p_head->enq_idx_.load( std::memory_order_acquire ) ) &&
+			     ( hp_head->hazard_handler_of_next().load() == nullptr ) ) {
+				// 値が書き込まれる可能性のあるセルがない
+				return alcc_nullopt;
+			}
+
+			size_t idx = p_head->deq_idx_.fetch_add( 1, std::memory_order_acq_rel );
+			if ( idx >= SegmentSize ) {
+				// このセグメントは取り出し済み。次のセグメントへ進める。
+				link_pointer p_next = hp_head->hazard_handler_of_next().load();
+				if ( p_next == nullptr ) return alcc_nullopt;
+
+				// tailを追い越してheadを更新しないように、tailを先に進める。
+				link_pointer p_tail = hph_tail_.load();
+				if ( p_tail == hp_head ) {
+					hph_tail_.compare_exchange_strong( p_tail, p_next );
+				}
+
+				link_pointer p_expect = hp_head.get();
+				if ( hph_head_.compare_exchange_strong( p_expect, p_next ) ) {
+					// ハザードポインタとして登録中の間は、od_node_poolから再利用されない。
+					segment_pool_t::push( p_head );
+				}
+				continue;
+			}
+
+			cell_type& cell = p_head->cells_[idx];
+			if ( cell.state_.exchange( cell_taken, std::memory_order_acq_rel ) != cell_ready ) {
+				// producerがまだ書き込んでいないセルなので、放棄する。producerは別のセルでやり直す。
+				continue;
+			}
+
+			alcc_optional<value_type> ans( alcc_in_place, std::move( *cell.value_pointer() ) );
+			cell.value_pointer()->~value_type();
+			return ans;
+		}
+	}
+
+	bool is_empty( void ) const
+	{
+		hazard_pointer hp_head = hph_head_.get_to_verify_exchange();
+		while ( !hph_head_.verify_exchange( hp_head ) ) {}
+
+		const_segment_pointer p_head  = segment_of( hp_head.get() );
+		size_t                enq_idx = p_head->enq_idx_.load( std::memory_order_acquire );
+		size_t                deq_idx = p_head->deq_idx_.load( std::memory_order_acquire );
+		if ( enq_idx > SegmentSize ) enq_idx = SegmentSize;
+		return ( deq_idx >= enq_idx ) && ( hp_head->hazard_handler_of_next().load() == nullptr );
+	}
+
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * The cells that are claimed by a producer or a consumer but are not completed yet are counted as a value.
+	 */
+	size_t count_size( void ) const
+	{
+		size_t             ans = 0;
+		hazard_slot_set<2> hss;
+		hazard_pointer     hp_cur( hss, hph_head_.load() );
+		hazard_pointer     hp_next( hss );
+		while ( !hph_head_.verify_exchange( hp_cur ) ) {}
+		while ( hp_cur != nullptr ) {
+			const_segment_pointer p_cur   = segment_of( hp_cur.get() );
+			size_t                enq_idx = p_cur->enq_idx_.load( std::memory_order_acquire );
+			size_t                deq_idx = p_cur->deq_idx_.load( std::memory_order_acquire );
+			if ( enq_idx > SegmentSize ) enq_idx = SegmentSize;
+			if ( enq_idx > deq_idx ) ans += enq_idx - deq_idx;
+
+			hp_next.store( hp_cur->hazard_handler_of_next().load() );
+			while ( !hp_cur->hazard_handler_of_next().verify_exchange( hp_next ) ) {}
+			hp_cur.swap( hp_next );
+		}
+		return ans;
+	}
+
+	/*!
+	 * @brief	get the total number of the allocated internal segments
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		return allocated_segment_count_.load();
+	}
+
+	static constexpr size_t segment_size( void ) noexcept
+	{
+		return SegmentSize;
+	}
+
+private:
+	static constexpr int cell_empty = 0;   //!< no value is written yet
+	static constexpr int cell_ready = 1;   //!< value is written by producer
+	static constexpr int cell_taken = 2;   //!< value is taken, or cell is abandoned by consumer
+
+	struct cell_type {
+		std::atomic<int> state_;
+		alignas( T ) unsigned char storage_[sizeof( T )];
+
+		value_type* value_pointer( void ) noexcept
+		{
+			return reinterpret_cast<value_type*>( storage_ );
+		}
+	};
+
+	struct segment_type : public internal::od_node_simple_link, public internal::od_node_link_by_hazard_handler {
+		segment_type( void )
+		  : internal::od_node_simple_link()
+		  , internal::od_node_link_by_hazard_handler()
+		  , enq_idx_( 0 )
+		  , deq_idx_( 0 )
+		{
+			for ( auto& e : cells_ ) {
+				e.state_.store( cell_empty, std::memory_order_relaxed );
+			}
+		}
+
+		void reinitialize( void ) noexcept
+		{
+			internal::od_node_link_by_hazard_handler::set_next( nullptr );
+			enq_idx_.store( 0, std::memory_order_relaxed );
+			deq_idx_.store( 0, std::memory_order_relaxed );
+			for ( auto& e : cells_ ) {
+				e.state_.store( cell_empty, std::memory_order_relaxed );
+			}
+		}
+
+		alignas( internal::atomic_variable_align ) std::atomic<size_t> enq_idx_;   //!< next cell index to push. updated by producers
+		alignas( internal::atomic_variable_align ) std::atomic<size_t> deq_idx_;   //!< next cell index to pop. updated by consumers
+		alignas( internal::atomic_variable_align ) cell_type cells_[SegmentSize];
+	};
+
+	using segment_pointer       = segment_type*;
+	using const_segment_pointer = const segment_type*;
+	using link_pointer          = internal::od_node_link_by_hazard_handler*;
+	using hazard_ptr_handler_t  = typename internal::od_node_link_by_hazard_handler::hazard_ptr_handler_t;
+	using hazard_pointer        = typename internal::od_node_link_by_hazard_handler::hazard_pointer;
+	using segment_pool_t        = internal::od_node_pool<segment_type>;
+
+	static link_pointer link_of( segment_pointer p_seg ) noexcept
+	{
+		return static_cast<link_pointer>( p_seg );
+	}
+	static segment_pointer segment_of( link_pointer p_link ) noexcept
+	{
+		return static_cast<segment_pointer>( p_link );
+	}
+
+	segment_pointer allocate_segment( void )
+	{
+		segment_pointer p_seg = segment_pool_t::pop();
+		if ( p_seg == nullptr ) {
+			allocated_segment_count_++;
+			return new segment_type;
+		}
+		p_seg->reinitialize();
+		return p_seg;
+	}
+
+	/**
+	 * @brief push v
+	 *
+	 * v is moved into a cell. If the cell is abandoned by a consumer, v is moved back and retried with other cell.
+	 */
+	void push_impl( value_type& v )
+	{
+		segment_pointer p_spare_seg = nullptr;
+		hazard_pointer  hp_tail     = hph_tail_.get_to_verify_exchange();
+		while ( true ) {
+			if ( !hph_tail_.verify_exchange( hp_tail ) ) {
+				continue;
+			}
+			segment_pointer p_tail = segment_of( hp_tail.get() );
+
+			size_t idx = p_tail->enq_idx_.fetch_add( 1, std::memory_order_acq_rel );
+			if ( idx >= SegmentSize ) {
+				// このセグメントは満杯。次のセグメントへ進めるか、新たなセグメントを追加する。
+				link_pointer p_next = hp_tail->hazard_handler_of_next().load();
+				if ( p_next != nullptr ) {
+					link_pointer p_expect = hp_tail.get();
+					hph_tail_.compare_exchange_strong( p_expect, p_next );
+					continue;
+				}
+
+				if ( p_spare_seg == nullptr ) {
+					p_spare_seg = allocate_segment();
+				}
+				// 新たなセグメントの最初のセルに値を書き込んでから、セグメントを公開する。
+				::new ( p_spare_seg->cells_[0].value_pointer() ) value_type( std::move( v ) );
+				p_spare_seg->cells_[0].state_.store( cell_ready, std::memory_order_relaxed );
+				p_spare_seg->enq_idx_.store( 1, std::memory_order_relaxed );
+
+				link_pointer p_expect_next = nullptr;
+				if ( hp_tail->hazard_handler_of_next().compare_exchange_strong( p_expect_next, link_of( p_spare_seg ) ) ) {
+					link_pointer p_expect = hp_tail.get();
+					hph_tail_.compare_exchange_strong( p_expect, link_of( p_spare_seg ) );
+					return;
+				}
+
+				// 他のスレッドが先にセグメントを追加したので、値を戻してやり直す。
+				move_back( p_spare_seg->cells_[0], v );
+				p_spare_seg->reinitialize();
+				continue;
+			}
+
+			cell_type& cell = p_tail->cells_[idx];
+			::new ( cell.value_pointer() ) value_type( std::move( v ) );
+			int expect = cell_empty;
+			if ( cell.state_.compare_exchange_strong( expect, cell_ready, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+				break;
+			}
+
+			// consumerがこのセルを放棄したので、値を戻してやり直す。
+			move_back( cell, v );
+		}
+
+		if ( p_spare_seg != nullptr ) {
+			segment_pool_t::push( p_spare_seg );
+		}
+	}
+
+	static void move_back( cell_type& cell, value_type& v )
+	{
+		v = std::move( *cell.value_pointer() );
+		cell.value_pointer()->~value_type();
+	}
+
+	hazard_ptr_handler_t hph_head_;                  //!< segment to pop
+	hazard_ptr_handler_t hph_tail_;                  //!< segment to push
+	std::atomic<size_t>  allocated_segment_count_;   //!< allocated segments count
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
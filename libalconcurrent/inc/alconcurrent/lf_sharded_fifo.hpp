@@ -0,0 +1,213 @@
+/**
+ * @file lf_sharded_fifo.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief fifo that consists of several fifo_list lanes, and keeps only per-producer order
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * A producer pushes to the lane that is assigned to the calling thread. A consumer pops from the lane of the calling thread at first,
+ * then pops from the larger lane of two randomly chosen lanes (power of two choices), and at last scans all lanes.
+ * Therefore, push/pop of the different threads are distributed to the different head/tail pairs.
+ */
+
+#ifndef ALCONCCURRENT_INC_LF_SHARDED_FIFO_HPP_
+#define ALCONCCURRENT_INC_LF_SHARDED_FIFO_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "lf_fifo.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief relaxed order fifo for work distribution
+ *
+ * The values that are pushed by one thread are popped in the pushed order. But there is no order between the values that are pushed by the different threads.
+ * pop() returns alcc_nullopt only after all lanes are checked. Therefore, a value in a lane that no thread is assigned to is also popped.
+ *
+ * @tparam T type of value
+ * @tparam ReclamationPolicy reclamation policy of the lanes. please refer fifo_list
+ */
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
+class sharded_fifo {
+public:
+	using value_type = T;
+
+	/**
+	 * @brief constructor
+	 *
+	 * @param num_of_lanes number of lanes. If 0, std::thread::hardware_concurrency() is used.
+	 */
+	explicit sharded_fifo( size_t num_of_lanes = 0 )
+	  : num_of_lanes_( decide_num_of_lanes( num_of_lanes ) )
+	  , up_lanes_( new lane_type[num_of_lanes_] )
+	{
+	}
+
+	sharded_fifo( const sharded_fifo& )            = delete;
+	sharded_fifo( sharded_fifo&& )                 = delete;
+	sharded_fifo& operator=( const sharded_fifo& ) = delete;
+	sharded_fifo& operator=( sharded_fifo&& )      = delete;
+
+	void push( const T& v_arg )
+	{
+		up_lanes_[own_lane_idx()].fifo_.push( v_arg );
+	}
+	void push( T&& v_arg )
+	{
+		up_lanes_[own_lane_idx()].fifo_.push( std::move( v_arg ) );
+	}
+
+	template <typename... Args>
+	void emplace( Args&&... args )
+	{
+		up_lanes_[own_lane_idx()].fifo_.emplace( std::forward<Args>( args )... );
+	}
+
+	/**
+	 * @brief pop a value
+	 *
+	 * @return alcc_optional<value_type> popped value. If all lanes are empty, alcc_nullopt.
+	 */
+	alcc_optional<value_type> pop( void )
+	{
+		size_t own_idx = own_lane_idx();
+		auto   ans     = up_lanes_[own_idx].fifo_.pop();
+		if ( ans.has_value() || ( num_of_lanes_ == 1 ) ) return ans;
+
+		// power of two choices: ランダムに選んだ2つのレーンのうち、値が多そうなレーンから取り出す。
+		size_t idx1 = next_random() % num_of_lanes_;
+		size_t idx2 = next_random() % num_of_lanes_;
+		if ( up_lanes_[idx2].fifo_.approximate_size() > up_lanes_[idx1].fifo_.approximate_size() ) {
+			std::swap( idx1, idx2 );
+		}
+		bool is_idx1_tried = false;   // idx1から実際にpopを試みたかどうか
+		if ( ( idx1 != own_idx ) && ( up_lanes_[idx1].fifo_.approximate_size() > 0 ) ) {
+			ans = up_lanes_[idx1].fifo_.pop();
+			if ( ans.has_value() ) return ans;
+			is_idx1_tried = true;
+		}
+
+		// 取り残される値がないように、カウンタに頼らずに全レーンを確認する。
+		// 値の数が0に見えたためにidx1からのpopを試みていない場合は、idx1も確認する。
+		for ( size_t i = 1; i < num_of_lanes_; i++ ) {
+			size_t idx = ( own_idx + i ) % num_of_lanes_;
+			if ( is_idx1_tried && ( idx == idx1 ) ) continue;
+			ans = up_lanes_[idx].fifo_.pop();
+			if ( ans.has_value() ) return ans;
+		}
+		return alcc_nullopt;
+	}
+
+	bool is_empty( void ) const
+	{
+		for ( size_t i = 0; i < num_of_lanes_; i++ ) {
+			if ( !up_lanes_[i].fifo_.is_empty() ) return false;
+		}
+		return true;
+	}
+
+	size_t count_size( void ) const
+	{
+		size_t ans = 0;
+		for ( size_t i = 0; i < num_of_lanes_; i++ ) {
+			ans += up_lanes_[i].fifo_.count_size();
+		}
+		return ans;
+	}
+
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * This is the sum of fifo_list::approximate_size() of the lanes, and does not traverse the lanes.
+	 */
+	size_t approximate_size( void ) const noexcept
+	{
+		size_t ans = 0;
+		for ( size_t i = 0; i < num_of_lanes_; i++ ) {
+			ans += up_lanes_[i].fifo_.approximate_size();
+		}
+		return ans;
+	}
+
+	/*!
+	 * @brief	get the total number of the allocated internal nodes of all lanes
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		size_t ans = 0;
+		for ( size_t i = 0; i < num_of_lanes_; i++ ) {
+			ans += up_lanes_[i].fifo_.get_allocated_num();
+		}
+		return ans;
+	}
+
+	size_t num_of_lanes( void ) const noexcept
+	{
+		return num_of_lanes_;
+	}
+
+private:
+	struct alignas( internal::atomic_variable_align ) lane_type {
+		lane_type( void )
+		  : fifo_()
+		{
+		}
+
+		fifo_list<T, ReclamationPolicy> fifo_;   //!< lane
+	};
+
+	static size_t decide_num_of_lanes( size_t num_of_lanes )
+	{
+		if ( num_of_lanes > 0 ) return num_of_lanes;
+		size_t hw_num = static_cast<size_t>( std::thread::hardware_concurrency() );
+		return ( hw_num > 0 ) ? hw_num : 1;
+	}
+
+	/**
+	 * @brief get the seed of the calling thread. the seed is assigned by round robin at the first call of each thread.
+	 */
+	static std::uint64_t& tl_seed( void )
+	{
+		static std::atomic<std::uint64_t> next_seed( 0 );
+		static thread_local std::uint64_t tl_seed_value = 0;
+		if ( tl_seed_value == 0 ) {
+			tl_seed_value = next_seed.fetch_add( 1, std::memory_order_relaxed ) + 1;
+		}
+		return tl_seed_value;
+	}
+
+	size_t own_lane_idx( void ) const
+	{
+		return static_cast<size_t>( ( tl_seed() - 1 ) % num_of_lanes_ );
+	}
+
+	static size_t next_random( void )
+	{
+		static thread_local std::uint64_t tl_random_state = 0;
+		if ( tl_random_state == 0 ) {
+			tl_random_state = tl_seed() * 0x9E3779B97F4A7C15ULL;
+		}
+		// xorshift64
+		tl_random_state ^= tl_random_state << 13;
+		tl_random_state ^= tl_random_state >> 7;
+		tl_random_state ^= tl_random_state << 17;
+		return static_cast<size_t>( tl_random_state );
+	}
+
+	const size_t                 num_of_lanes_;   //!< number of lanes
+	std::unique_ptr<lane_type[]> up_lanes_;       //!< lanes
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
@@ -0,0 +1,453 @@
+/**
+ * @file lf_spsc_fifo.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief fifo for single producer and single consumer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * If only one thread pushes and only one thread pops, CAS is not needed.
+ * Each side updates its own index by plain store, and reads the index of the other side only when its cached copy is not enough.
+ */
+
+#ifndef ALCONCCURRENT_INC_LF_SPSC_FIFO_HPP_
+#define ALCONCCURRENT_INC_LF_SPSC_FIFO_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "internal/alcc_optional.hpp"
+#include "internal/hazard_ptr_internal.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief bounded fifo for single producer and single consumer
+ *
+ * push側のAPI(try_push(), try_emplace(), push_bulk())は1つのスレッドからのみ呼び出すこと。
+ * pop側のAPI(try_pop(), pop_bulk())も1つのスレッドからのみ呼び出すこと。
+ * push側とpop側は、異なるスレッドであってよい。
+ *
+ * @tparam T type of value. T should be move constructible or copy constructible.
+ * @tparam Capacity capacity of fifo. This should be power of 2. If 0, capacity is given by the constructor.
+ */
+template <typename T, size_t Capacity = 0>
+class spsc_fifo {
+public:
+	static_assert( std::is_move_constructible<T>::value || std::is_copy_constructible<T>::value,
+	               "T should be move constructible or copy constructible" );
+	static_assert( ( Capacity & ( Capacity - 1 ) ) == 0, "Capacity should be power of 2" );
+
+	using value_type = T;
+
+	template <size_t N = Capacity, typename std::enable_if<( N != 0 )>::type* = nullptr>
+	spsc_fifo( void )
+	  : spsc_fifo( Capacity, 0 )
+	{
+	}
+
+	/**
+	 * @brief constructor for runtime capacity
+	 *
+	 * @param capacity capacity of fifo. This is rounded up to power of 2.
+	 */
+	template <size_t N = Capacity, typename std::enable_if<( N == 0 )>::type* = nullptr>
+	explicit spsc_fifo( size_t capacity )
+	  : spsc_fifo( round_up_to_power_of_2( capacity ), 0 )
+	{
+	}
+
+	~spsc_fifo()
+	{
+		size_t h = head_.load( std::memory_order_acquire );
+		size_t t = tail_.load( std::memory_order_acquire );
+		for ( ; h != t; h++ ) {
+			slot( h )->~T();
+		}
+	}
+
+	spsc_fifo( const spsc_fifo& )            = delete;
+	spsc_fifo( spsc_fifo&& )                 = delete;
+	spsc_fifo& operator=( const spsc_fifo& ) = delete;
+	spsc_fifo& operator=( spsc_fifo&& )      = delete;
+
+	/**
+	 * @brief push a value
+	 *
+	 * @return true success to push
+	 * @return false fifo is full
+	 */
+	bool try_push( const T& v_arg )
+	{
+		return try_emplace( v_arg );
+	}
+	bool try_push( T&& v_arg )
+	{
+		return try_emplace( std::move( v_arg ) );
+	}
+
+	template <typename... Args>
+	bool try_emplace( Args&&... args )
+	{
+		size_t t = tail_.load( std::memory_order_relaxed );
+		if ( free_size_to_push( t, 1 ) == 0 ) return false;
+
+		new ( slot( t ) ) T( std::forward<Args>( args )... );
+		tail_.store( t + 1, std::memory_order_release );
+		return true;
+	}
+
+	/**
+	 * @brief push values of [first, first + n), and publish them at once
+	 *
+	 * @return size_t the number of pushed values. If fifo does not have enough space, this is less than n.
+	 */
+	template <typename InputIt>
+	size_t push_bulk( InputIt first, size_t n )
+	{
+		size_t t   = tail_.load( std::memory_order_relaxed );
+		size_t ans = free_size_to_push( t, n );
+		if ( ans > n ) ans = n;
+
+		for ( size_t i = 0; i < ans; i++, ++first ) {
+			new ( slot( t + i ) ) T( *first );
+		}
+		tail_.store( t + ans, std::memory_order_release );
+		return ans;
+	}
+
+	/**
+	 * @brief pop a value
+	 *
+	 * @return alcc_optional<value_type> popped value. If fifo is empty, alcc_nullopt.
+	 */
+	alcc_optional<value_type> try_pop( void )
+	{
+		size_t h = head_.load( std::memory_order_relaxed );
+		if ( available_size_to_pop( h, 1 ) == 0 ) return alcc_nullopt;
+
+		T*                        p_value = slot( h );
+		alcc_optional<value_type> ans( alcc_in_place, std::move_if_noexcept( *p_value ) );
+		p_value->~T();
+		head_.store( h + 1, std::memory_order_release );
+		return ans;
+	}
+	alcc_optional<value_type> pop( void )
+	{
+		return try_pop();
+	}
+
+	/**
+	 * @brief pop values to [d_first, d_first + max_n), and release the cells at once
+	 *
+	 * @return size_t the number of popped values
+	 */
+	template <typename OutputIt>
+	size_t pop_bulk( OutputIt d_first, size_t max_n )
+	{
+		size_t h   = head_.load( std::memory_order_relaxed );
+		size_t ans = available_size_to_pop( h, max_n );
+		if ( ans > max_n ) ans = max_n;
+
+		for ( size_t i = 0; i < ans; i++, ++d_first ) {
+			T* p_value = slot( h + i );
+			*d_first   = std::move_if_noexcept( *p_value );
+			p_value->~T();
+		}
+		head_.store( h + ans, std::memory_order_release );
+		return ans;
+	}
+
+	/**
+	 * @brief get the number of values in fifo
+	 *
+	 * @warning
+	 * This fifo will be access by the other thread concurrently. So, true number of this fifo may be changed when caller uses the returned value.
+	 */
+	size_t count_size( void ) const noexcept
+	{
+		size_t h = head_.load( std::memory_order_acquire );
+		size_t t = tail_.load( std::memory_order_acquire );
+		return t - h;
+	}
+
+	bool is_empty( void ) const noexcept
+	{
+		return count_size() == 0;
+	}
+
+	size_t capacity( void ) const noexcept
+	{
+		return mask_ + 1;
+	}
+
+private:
+	struct cell_type {
+		alignas( T ) unsigned char storage_[sizeof( T )];   //!< storage of value
+	};
+
+	spsc_fifo( size_t capacity, int )
+	  : mask_( capacity - 1 )
+	  , up_cells_( new cell_type[capacity] )
+	  , tail_( 0 )
+	  , cached_head_( 0 )
+	  , head_( 0 )
+	  , cached_tail_( 0 )
+	{
+	}
+
+	static size_t round_up_to_power_of_2( size_t n ) noexcept
+	{
+		size_t ans = 1;
+		while ( ans < n ) {
+			ans <<= 1;
+		}
+		return ans;
+	}
+
+	T* slot( size_t pos ) const noexcept
+	{
+		return reinterpret_cast<T*>( up_cells_[pos & mask_].storage_ );
+	}
+
+	size_t free_size_to_push( size_t t, size_t required_n ) noexcept
+	{
+		size_t ans = capacity() - ( t - cached_head_ );
+		if ( ans < required_n ) {
+			// キャッシュでは足りないため、pop側のインデックスを読み直す
+			cached_head_ = head_.load( std::memory_order_acquire );
+			ans          = capacity() - ( t - cached_head_ );
+		}
+		return ans;
+	}
+
+	size_t available_size_to_pop( size_t h, size_t required_n ) noexcept
+	{
+		size_t ans = cached_tail_ - h;
+		if ( ans < required_n ) {
+			// キャッシュでは足りないため、push側のインデックスを読み直す
+			cached_tail_ = tail_.load( std::memory_order_acquire );
+			ans          = cached_tail_ - h;
+		}
+		return ans;
+	}
+
+	const size_t                 mask_;       //!< capacity - 1
+	std::unique_ptr<cell_type[]> up_cells_;   //!< ring buffer
+
+	alignas( internal::atomic_variable_align ) std::atomic<size_t> tail_;   //!< next position to push. written by producer only
+	size_t cached_head_;                                                    //!< copy of head_. accessed by producer only
+
+	alignas( internal::atomic_variable_align ) std::atomic<size_t> head_;   //!< next position to pop. written by consumer only
+	size_t cached_tail_;                                                    //!< copy of tail_. accessed by consumer only
+};
+
+/**
+ * @brief unbounded fifo for single producer and single consumer
+ *
+ * Values are stored in the linked list of the segments that have SegmentSize cells.
+ * When a segment becomes full, the producer links a new segment. When the consumer drains a segment, it keeps the segment as a spare for the producer.
+ * Therefore, operator new is called only when the spare segment is not available.
+ *
+ * push側のAPI(push(), emplace(), push_bulk())は1つのスレッドからのみ呼び出すこと。
+ * pop側のAPI(try_pop(), pop_bulk())も1つのスレッドからのみ呼び出すこと。
+ *
+ * @tparam T type of value. T should be move constructible or copy constructible.
+ * @tparam SegmentSize number of cells in a segment
+ */
+template <typename T, size_t SegmentSize = 256>
+class spsc_unbounded_fifo {
+public:
+	static_assert( std::is_move_constructible<T>::value || std::is_copy_constructible<T>::value,
+	               "T should be move constructible or copy constructible" );
+	static_assert( SegmentSize > 0, "SegmentSize should be greater than 0" );
+
+	using value_type = T;
+
+	spsc_unbounded_fifo( void )
+	  : p_tail_seg_( new segment_type )
+	  , write_idx_( 0 )
+	  , p_head_seg_( p_tail_seg_ )
+	  , read_idx_( 0 )
+	  , cached_write_idx_( 0 )
+	  , ap_spare_seg_( nullptr )
+	{
+	}
+
+	~spsc_unbounded_fifo()
+	{
+		auto tmp = try_pop();
+		while ( tmp.has_value() ) {
+			tmp = try_pop();
+		}
+		delete p_head_seg_;
+		delete ap_spare_seg_.load( std::memory_order_acquire );
+	}
+
+	spsc_unbounded_fifo( const spsc_unbounded_fifo& )            = delete;
+	spsc_unbounded_fifo( spsc_unbounded_fifo&& )                 = delete;
+	spsc_unbounded_fifo& operator=( const spsc_unbounded_fifo& ) = delete;
+	spsc_unbounded_fifo& operator=( spsc_unbounded_fifo&& )      = delete;
+
+	void push( const T& v_arg )
+	{
+		emplace( v_arg );
+	}
+	void push( T&& v_arg )
+	{
+		emplace( std::move( v_arg ) );
+	}
+
+	template <typename... Args>
+	void emplace( Args&&... args )
+	{
+		if ( write_idx_ == SegmentSize ) {
+			link_new_segment();
+		}
+		new ( p_tail_seg_->slot( write_idx_ ) ) T( std::forward<Args>( args )... );
+		write_idx_++;
+		p_tail_seg_->a_write_idx_.store( write_idx_, std::memory_order_release );
+	}
+
+	/**
+	 * @brief push values of [first, first + n). The values are published once per segment.
+	 */
+	template <typename InputIt>
+	void push_bulk( InputIt first, size_t n )
+	{
+		while ( n > 0 ) {
+			if ( write_idx_ == SegmentSize ) {
+				link_new_segment();
+			}
+			size_t cur_n = SegmentSize - write_idx_;
+			if ( cur_n > n ) cur_n = n;
+
+			for ( size_t i = 0; i < cur_n; i++, ++first ) {
+				new ( p_tail_seg_->slot( write_idx_ + i ) ) T( *first );
+			}
+			write_idx_ += cur_n;
+			p_tail_seg_->a_write_idx_.store( write_idx_, std::memory_order_release );
+			n -= cur_n;
+		}
+	}
+
+	/**
+	 * @brief pop a value
+	 *
+	 * @return alcc_optional<value_type> popped value. If fifo is empty, alcc_nullopt.
+	 */
+	alcc_optional<value_type> try_pop( void )
+	{
+		if ( !prepare_to_pop() ) return alcc_nullopt;
+
+		T*                        p_value = p_head_seg_->slot( read_idx_ );
+		alcc_optional<value_type> ans( alcc_in_place, std::move_if_noexcept( *p_value ) );
+		p_value->~T();
+		read_idx_++;
+		return ans;
+	}
+	alcc_optional<value_type> pop( void )
+	{
+		return try_pop();
+	}
+
+	/**
+	 * @brief pop values to [d_first, d_first + max_n)
+	 *
+	 * @return size_t the number of popped values
+	 */
+	template <typename OutputIt>
+	size_t pop_bulk( OutputIt d_first, size_t max_n )
+	{
+		size_t ans = 0;
+		while ( ( ans < max_n ) && prepare_to_pop() ) {
+			size_t cur_n = cached_write_idx_ - read_idx_;
+			if ( cur_n > ( max_n - ans ) ) cur_n = max_n - ans;
+
+			for ( size_t i = 0; i < cur_n; i++, ++d_first ) {
+				T* p_value = p_head_seg_->slot( read_idx_ + i );
+				*d_first   = std::move_if_noexcept( *p_value );
+				p_value->~T();
+			}
+			read_idx_ += cur_n;
+			ans += cur_n;
+		}
+		return ans;
+	}
+
+private:
+	struct segment_type {
+		struct cell_type {
+			alignas( T ) unsigned char storage_[sizeof( T )];   //!< storage of value
+		};
+
+		segment_type( void )
+		  : a_write_idx_( 0 )
+		  , ap_next_( nullptr )
+		{
+		}
+
+		T* slot( size_t idx ) noexcept
+		{
+			return reinterpret_cast<T*>( cells_[idx].storage_ );
+		}
+
+		std::atomic<size_t>        a_write_idx_;   //!< number of published values in this segment
+		std::atomic<segment_type*> ap_next_;       //!< next segment. after this is set, producer does not access this segment
+		cell_type                  cells_[SegmentSize];
+	};
+
+	void link_new_segment( void )
+	{
+		segment_type* p_new_seg = ap_spare_seg_.exchange( nullptr, std::memory_order_acq_rel );
+		if ( p_new_seg == nullptr ) {
+			p_new_seg = new segment_type;
+		} else {
+			p_new_seg->a_write_idx_.store( 0, std::memory_order_relaxed );
+			p_new_seg->ap_next_.store( nullptr, std::memory_order_relaxed );
+		}
+
+		p_tail_seg_->ap_next_.store( p_new_seg, std::memory_order_release );
+		p_tail_seg_ = p_new_seg;
+		write_idx_  = 0;
+	}
+
+	bool prepare_to_pop( void )
+	{
+		if ( read_idx_ < cached_write_idx_ ) return true;
+
+		cached_write_idx_ = p_head_seg_->a_write_idx_.load( std::memory_order_acquire );
+		if ( read_idx_ < cached_write_idx_ ) return true;
+		if ( read_idx_ < SegmentSize ) return false;
+
+		// 現在のセグメントを読み切ったため、次のセグメントへ移る
+		segment_type* p_next_seg = p_head_seg_->ap_next_.load( std::memory_order_acquire );
+		if ( p_next_seg == nullptr ) return false;
+
+		delete ap_spare_seg_.exchange( p_head_seg_, std::memory_order_acq_rel );
+		p_head_seg_       = p_next_seg;
+		read_idx_         = 0;
+		cached_write_idx_ = p_head_seg_->a_write_idx_.load( std::memory_order_acquire );
+		return read_idx_ < cached_write_idx_;
+	}
+
+	alignas( internal::atomic_variable_align ) segment_type* p_tail_seg_;   //!< accessed by producer only
+	size_t write_idx_;                                                      //!< accessed by producer only
+
+	alignas( internal::atomic_variable_align ) segment_type* p_head_seg_;   //!< accessed by consumer only
+	size_t read_idx_;                                                       //!< accessed by consumer only
+	size_t cached_write_idx_;                                               //!< copy of p_head_seg_->a_write_idx_. accessed by consumer only
+
+	alignas( internal::atomic_variable_align ) std::atomic<segment_type*> ap_spare_seg_;   //!< drained segment for reuse
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
@@ -18,14 +18,16 @@
 
 #include "hazard_ptr.hpp"
 #include "internal/alcc_optional.hpp"
+#include "internal/ebr_domain.hpp"
 #include "internal/od_lockfree_stack.hpp"
 #include "internal/od_node_pool.hpp"
+#include "internal/striped_counter.hpp"
 
 namespace alpha {
 namespace concurrent {
 namespace internal {
 
-template <typename T>
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
 class x_lockfree_stack {
 public:
 	static_assert( ( !std::is_class<T>::value ) ||
@@ -39,6 +41,7 @@ public:
 	constexpr x_lockfree_stack( void ) noexcept
 	  : lf_stack_impl_()
 	  , allocated_node_count_( 0 )
+	  , approx_size_()
 	{
 	}
 	x_lockfree_stack( size_t reserve_size )
@@ -81,6 +84,7 @@ public:
 			p_new_nd = new node_type( v_arg );
 		}
 		lf_stack_impl_.push_front( p_new_nd );
+		approx_size_.add( 1 );
 	}
 
 	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
@@ -97,6 +101,7 @@ public:
 			p_new_nd = new node_type( std::move( v_arg ) );
 		}
 		lf_stack_impl_.push_front( p_new_nd );
+		approx_size_.add( 1 );
 	}
 
 	template <typename... Args>
@@ -110,6 +115,7 @@ public:
 			p_new_nd = new node_type( alcc_in_place, std::forward<Args>( args )... );
 		}
 		lf_stack_impl_.push_front( p_new_nd );
+		approx_size_.add( 1 );
 	}
 
 	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
@@ -121,6 +127,7 @@ public:
 		// TがMove可能である場合に選択されるAPI実装
 		auto p_poped_node_orig = lf_stack_impl_.pop_front();
 		if ( p_poped_node_orig == nullptr ) return alcc_nullopt;
+		approx_size_.sub( 1 );
 
 		node_pointer              p_poped_node = static_cast<node_pointer>( p_poped_node_orig );   // このクラスが保持するノードは、すべてnode_pointerであることをpush関数で保証しているので、dynamic_castは不要。
 		alcc_optional<value_type> ans { std::move( p_poped_node->get_value() ) };
@@ -141,6 +148,7 @@ public:
 		// TがMove不可能であるが、Copy可能である場合に選択されるAPI実装
 		auto p_poped_node_orig = lf_stack_impl_.pop_front();
 		if ( p_poped_node_orig == nullptr ) return alcc_nullopt;
+		approx_size_.sub( 1 );
 
 		node_pointer              p_poped_node = static_cast<node_pointer>( p_poped_node_orig );   // このクラスが保持するノードは、すべてnode_pointerであることをpush関数で保証しているので、dynamic_castは不要。
 		alcc_optional<value_type> ans { p_poped_node->get_value() };
@@ -155,6 +163,17 @@ public:
 		return lf_stack_impl_.count_size();
 	}
 
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * This does not traverse the nodes, and sums the striped counters that are updated by push/pop. Therefore, this is cheap enough to be called frequently.
+	 * The values that are being pushed or popped concurrently may or may not be counted.
+	 */
+	size_t approximate_size( void ) const noexcept
+	{
+		return approx_size_.load();
+	}
+
 	bool is_empty( void ) const
 	{
 		return lf_stack_impl_.is_empty();
@@ -193,38 +212,212 @@ private:
 
 	node_stack_lockfree_t lf_stack_impl_;          //!< lock free stack
 	std::atomic<size_t>   allocated_node_count_;   //!< number of allocated nodes
+	striped_counter       approx_size_;            //!< approximate number of the values
+};
+
+/**
+ * @brief lock-free stack that uses epoch based reclamation
+ *
+ * A node is allocated for each push, and is released via ebr_domain::Retire() after pop.
+ * Because a node is not released while any thread is in critical section, ABA problem does not happen.
+ */
+template <typename T>
+class x_lockfree_stack<T, epoch_based_reclamation> {
+public:
+	static_assert( ( !std::is_class<T>::value ) ||
+	                   ( std::is_class<T>::value &&
+	                     ( ( std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value ) ||
+	                       ( std::is_move_constructible<T>::value && std::is_move_assignable<T>::value ) ) ),
+	               "T should be copy constructible and copy assignable, or, move constructible and move assignable" );
+
+	using value_type = T;
+
+	constexpr x_lockfree_stack( void ) noexcept
+	  : ap_head_( nullptr )
+	  , allocated_node_count_( 0 )
+	  , approx_size_()
+	{
+	}
+	x_lockfree_stack( size_t reserve_size )
+	  : x_lockfree_stack()
+	{
+		static_cast<void>( reserve_size );   // ノードはpush毎に確保するため、予約は行わない。
+	}
+
+	~x_lockfree_stack()
+	{
+		node_pointer p_cur = ap_head_.load( std::memory_order_acquire );
+		while ( p_cur != nullptr ) {
+			node_pointer p_next = p_cur->p_next_;
+			delete p_cur;
+			p_cur = p_next;
+		}
+	}
+
+	template <bool IsCopyConstructible = std::is_copy_constructible<value_type>::value,
+	          bool IsCopyAssignable    = std::is_copy_assignable<value_type>::value,
+	          typename std::enable_if<
+				  IsCopyConstructible && IsCopyAssignable>::type* = nullptr>
+	void push( const T& v_arg )
+	{
+		push_node( new node_type( v_arg ) );
+	}
+
+	template <bool IsMoveConstructible = std::is_move_constructible<value_type>::value,
+	          bool IsMoveAssignable    = std::is_move_assignable<value_type>::value,
+	          typename std::enable_if<
+				  IsMoveConstructible && IsMoveAssignable>::type* = nullptr>
+	void push( T&& v_arg )
+	{
+		push_node( new node_type( std::move( v_arg ) ) );
+	}
+
+	template <typename... Args>
+	void emplace( Args&&... args )
+	{
+		push_node( new node_type( std::forward<Args>( args )... ) );
+	}
+
+	alcc_optional<value_type> pop( void )
+	{
+		node_pointer p_poped_node = nullptr;
+		{
+			ebr_domain::critical_section cs;
+
+			p_poped_node = ap_head_.load( std::memory_order_acquire );
+			while ( p_poped_node != nullptr ) {
+				if ( ap_head_.compare_exchange_weak( p_poped_node, p_poped_node->p_next_, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+					break;
+				}
+			}
+		}
+		if ( p_poped_node == nullptr ) return alcc_nullopt;
+
+		// p_poped_nodeの値にアクセスするのは、CASに成功したスレッドのみ。他のスレッドはp_next_のみを参照する。
+		alcc_optional<value_type> ans { std::move( p_poped_node->value_ ) };
+		allocated_node_count_--;
+		approx_size_.sub( 1 );
+		ebr_domain::Retire( p_poped_node, &node_type::deleter );
+
+		return ans;
+	}
+
+	size_t count_size( void ) const
+	{
+		ebr_domain::critical_section cs;
+
+		size_t       ans   = 0;
+		node_pointer p_cur = ap_head_.load( std::memory_order_acquire );
+		while ( p_cur != nullptr ) {
+			ans++;
+			p_cur = p_cur->p_next_;
+		}
+		return ans;
+	}
+
+	/*!
+	 * @brief	get the approximate number of the values
+	 *
+	 * This does not traverse the nodes, and sums the striped counters that are updated by push/pop. Therefore, this is cheap enough to be called frequently.
+	 * The values that are being pushed or popped concurrently may or may not be counted.
+	 */
+	size_t approximate_size( void ) const noexcept
+	{
+		return approx_size_.load();
+	}
+
+	bool is_empty( void ) const
+	{
+		return ap_head_.load( std::memory_order_acquire ) == nullptr;
+	}
+
+	/*!
+	 * @brief	get the number of the nodes that are allocated and are not retired yet
+	 *
+	 * @warning
+	 * This List will be access by several thread concurrently. So, true number of this List may be changed when caller uses the returned value.
+	 */
+	size_t get_allocated_num( void ) const noexcept
+	{
+		return allocated_node_count_.load();
+	}
+
+	static void clear_node_pool_as_possible_as( void )
+	{
+		ebr_domain::DrainRetired();
+	}
+
+private:
+	struct node_type {
+		template <typename... Args>
+		node_type( Args&&... args )
+		  : value_( std::forward<Args>( args )... )
+		  , p_next_( nullptr )
+		{
+		}
+
+		static void deleter( void* p )
+		{
+			delete static_cast<node_type*>( p );
+		}
+
+		value_type value_;
+		node_type* p_next_;   //!< スタックにつながれた後は変更されないため、atomicである必要はない。
+	};
+	using node_pointer = node_type*;
+
+	void push_node( node_pointer p_new_nd )
+	{
+		allocated_node_count_++;
+
+		// pushはノードの参照を行わないため、クリティカルセクションは不要。
+		p_new_nd->p_next_ = ap_head_.load( std::memory_order_acquire );
+		while ( !ap_head_.compare_exchange_weak( p_new_nd->p_next_, p_new_nd, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+		}
+		approx_size_.add( 1 );
+	}
+
+	std::atomic<node_pointer> ap_head_;                //!< top of stack
+	std::atomic<size_t>       allocated_node_count_;   //!< number of nodes that are allocated and are not retired yet
+	striped_counter           approx_size_;            //!< approximate number of the values
 };
 
 }   // namespace internal
 
-template <typename T>
-class stack_list : public internal::x_lockfree_stack<T> {
+/**
+ * @brief semi lock-free stack
+ *
+ * @tparam T type of value
+ * @tparam ReclamationPolicy hazard_ptr_reclamation(default) or epoch_based_reclamation
+ */
+template <typename T, typename ReclamationPolicy = hazard_ptr_reclamation>
+class stack_list : public internal::x_lockfree_stack<T, ReclamationPolicy> {
 public:
 	stack_list( void ) noexcept = default;
 	stack_list( size_t reserve_size )
-	  : internal::x_lockfree_stack<T>( reserve_size )
+	  : internal::x_lockfree_stack<T, ReclamationPolicy>( reserve_size )
 	{
 	}
 };
-template <typename T>
-class stack_list<T[]> : public internal::x_lockfree_stack<T*> {
+template <typename T, typename ReclamationPolicy>
+class stack_list<T[], ReclamationPolicy> : public internal::x_lockfree_stack<T*, ReclamationPolicy> {
 public:
 	using value_type = T[];
 
 	stack_list( void ) noexcept = default;
 	stack_list( size_t reserve_size )
-	  : internal::x_lockfree_stack<T*>( reserve_size )
+	  : internal::x_lockfree_stack<T*, ReclamationPolicy>( reserve_size )
 	{
 	}
 };
-template <typename T, size_t N>
-class stack_list<T[N]> : public internal::x_lockfree_stack<std::array<T, N>> {
+template <typename T, size_t N, typename ReclamationPolicy>
+class stack_list<T[N], ReclamationPolicy> : public internal::x_lockfree_stack<std::array<T, N>, ReclamationPolicy> {
 public:
 	using value_type = T[N];
 
 	stack_list( void ) noexcept = default;
 	stack_list( size_t reserve_size )
-	  : internal::x_lockfree_stack<std::array<T, N>>( reserve_size )
+	  : internal::x_lockfree_stack<std::array<T, N>, ReclamationPolicy>( reserve_size )
 	{
 	}
 
@@ -237,7 +430,7 @@ public:
 			tmp[i] = cont_arg[i];
 		}
 
-		internal::x_lockfree_stack<std::array<T, N>>::push( std::move( tmp ) );
+		internal::x_lockfree_stack<std::array<T, N>, ReclamationPolicy>::push( std::move( tmp ) );
 	}
 	void push(
 		value_type&& cont_arg   //!< [in]	a value to push this FIFO queue
@@ -248,12 +441,12 @@ public:
 			tmp[i] = std::move( cont_arg[i] );
 		}
 
-		internal::x_lockfree_stack<std::array<T, N>>::push( std::move( tmp ) );
+		internal::x_lockfree_stack<std::array<T, N>, ReclamationPolicy>::push( std::move( tmp ) );
 	}
 
 	bool pop( value_type& a )
 	{
-		alcc_optional<std::array<T, N>> ret = internal::x_lockfree_stack<std::array<T, N>>::pop();
+		alcc_optional<std::array<T, N>> ret = internal::x_lockfree_stack<std::array<T, N>, ReclamationPolicy>::pop();
 		if ( !ret.has_value() ) {
 			return false;
 		}
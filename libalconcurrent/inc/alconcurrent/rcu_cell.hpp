@@ -0,0 +1,141 @@
+/**
+ * @file rcu_cell.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief read-mostly cell with read-copy-update by hazard pointer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * rcu_cell<T> holds a pointer to T that is allocated in heap.
+ * A reader gets a const view that is protected by one hazard pointer slot.
+ * A writer installs a new T by one exchange, and retires the old T by hazard_ptr_mgr::Retire().
+ */
+
+#ifndef ALCONCCURRENT_INC_RCU_CELL_HPP_
+#define ALCONCCURRENT_INC_RCU_CELL_HPP_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "hazard_ptr.hpp"
+
+namespace alpha {
+namespace concurrent {
+
+/**
+ * @brief read-mostly cell for the data that is hot-swapped like a routing table or a config
+ *
+ * read() publishes the current pointer to a hazard pointer slot and checks that the pointer is not changed.
+ * If a writer changes the pointer at the same time, read() retries. Therefore, read() is lock-free, and it does not wait for any writer.
+ * A T that is read by read() is not released until the returned view is destructed.
+ *
+ * @tparam T type of data. T should be copy constructible to use update().
+ */
+template <typename T>
+class rcu_cell {
+public:
+	using value_type = T;
+	using const_view = hazard_ptr<const T>;   //!< const view of T. T is kept alive while this view is alive.
+
+	rcu_cell( void )
+	  : hph_( new T() )
+	{
+	}
+	explicit rcu_cell( const T& init_value )
+	  : hph_( new T( init_value ) )
+	{
+	}
+	explicit rcu_cell( T&& init_value )
+	  : hph_( new T( std::move( init_value ) ) )
+	{
+	}
+	~rcu_cell()
+	{
+		// read()が返したビューが残っていないことが前提。
+		delete hph_.load( std::memory_order_acquire );
+	}
+
+	rcu_cell( const rcu_cell& )            = delete;
+	rcu_cell( rcu_cell&& )                 = delete;
+	rcu_cell& operator=( const rcu_cell& ) = delete;
+	rcu_cell& operator=( rcu_cell&& )      = delete;
+
+	/**
+	 * @brief get the const view of current T
+	 */
+	const_view read( void ) const noexcept
+	{
+		const_view hp( hph_.load( std::memory_order_acquire ) );
+		while ( true ) {
+			const T* p_cur = hph_.load( std::memory_order_acquire );
+			if ( p_cur == hp.get() ) break;
+			hp.store( p_cur );
+		}
+		return hp;
+	}
+
+	/**
+	 * @brief install new T, and retire the old T
+	 */
+	void store( const T& desired )
+	{
+		install( std::unique_ptr<T>( new T( desired ) ) );
+	}
+	void store( T&& desired )
+	{
+		install( std::unique_ptr<T>( new T( std::move( desired ) ) ) );
+	}
+
+	/**
+	 * @brief construct new T by args, and install it
+	 */
+	template <typename... Args>
+	void emplace( Args&&... args )
+	{
+		install( std::unique_ptr<T>( new T( std::forward<Args>( args )... ) ) );
+	}
+
+	/**
+	 * @brief read-copy-update
+	 *
+	 * Copy current T, apply f to the copy, and install the copy if current T is not changed by other writer.
+	 * If current T is changed by other writer, retry from copy. Therefore, f may be called more than once.
+	 *
+	 * @tparam F callable type that is called as f( T& )
+	 * @return size_t the number of retries
+	 */
+	template <typename F>
+	size_t update( F&& f )
+	{
+		size_t retry_count = 0;
+		while ( true ) {
+			const_view         hp_cur = read();
+			std::unique_ptr<T> up_new( new T( *hp_cur ) );
+			f( *up_new );
+
+			T* p_expect = const_cast<T*>( hp_cur.get() );
+			if ( hph_.compare_exchange_strong( p_expect, up_new.get(), std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+				up_new.release();
+				internal::hazard_ptr_mgr::Retire( p_expect );
+				return retry_count;
+			}
+			retry_count++;
+		}
+	}
+
+private:
+	void install( std::unique_ptr<T>&& up_desired )
+	{
+		T* p_old = hph_.exchange( up_desired.release(), std::memory_order_acq_rel );
+		internal::hazard_ptr_mgr::Retire( p_old );
+	}
+
+	hazard_ptr_handler<T> hph_;
+};
+
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
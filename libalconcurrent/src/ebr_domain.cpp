@@ -0,0 +1,294 @@
+/**
+ * @file ebr_domain.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief epoch based reclamation
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "alconcurrent/conf_logger.hpp"
+#include "alconcurrent/internal/ebr_domain.hpp"
+#include "alconcurrent/internal/hazard_ptr_internal.hpp"
+
+#include "hazard_ptr_impl.hpp"
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+// configuration value
+constexpr size_t conf_ebr_reclaim_threshold = 64;   //!< the number of retired pointers in a thread to try to advance the epoch
+constexpr size_t conf_ebr_drain_try_count   = 3;    //!< the number of trials to advance the epoch in DrainRetired()
+
+struct ebr_retired_ptr {
+	void*                        p_;         //!< retired pointer
+	ebr_domain::retire_deleter_t deleter_;   //!< deleter of p_
+	std::uint64_t                epoch_;     //!< global epoch when p_ was retired
+};
+
+/**
+ * @brief record of a thread that participates in epoch based reclamation
+ *
+ * A record is not released until the process exits, and is reused by other thread after the owner thread exits.
+ */
+struct ALIGNAS_ATOMIC_VARIABLE_ALIGN ebr_thread_record {
+	std::atomic<std::uint64_t>   announced_epoch_;   //!< ( epoch << 1 ) | ( 1: in critical section, 0: not in critical section )
+	std::atomic<bool>            is_used_;           //!< true: owned by a thread
+	ebr_thread_record*           p_next_;            //!< next record. this is immutable after registration to the global list
+	size_t                       nest_count_;        //!< nest count of critical section. this is accessed by the owner thread only
+	bool                         is_reclaiming_;     //!< true: in reclaim(). this is to avoid recursive reclaim() from deleter
+	std::vector<ebr_retired_ptr> retired_;           //!< retired pointers. this is accessed by the owner thread only
+
+	ebr_thread_record( void )
+	  : announced_epoch_( 0 )
+	  , is_used_( true )
+	  , p_next_( nullptr )
+	  , nest_count_( 0 )
+	  , is_reclaiming_( false )
+	  , retired_()
+	{
+	}
+};
+
+static std::atomic<std::uint64_t>      g_ebr_global_epoch( 0 );
+static std::atomic<ebr_thread_record*> g_ebr_record_list_top( nullptr );
+
+static std::mutex                   g_ebr_orphan_mtx;
+static std::vector<ebr_retired_ptr> g_ebr_orphan_retired;   //!< retired pointers that are left by exited threads
+
+static ebr_thread_record* acquire_ebr_thread_record( void )
+{
+	ebr_thread_record* p_cur = g_ebr_record_list_top.load( std::memory_order_acquire );
+	while ( p_cur != nullptr ) {
+		bool expected = false;
+		if ( !p_cur->is_used_.load( std::memory_order_acquire ) ) {
+			if ( p_cur->is_used_.compare_exchange_strong( expected, true, std::memory_order_acq_rel ) ) {
+				return p_cur;
+			}
+		}
+		p_cur = p_cur->p_next_;
+	}
+
+	ebr_thread_record* p_new = new ebr_thread_record;
+	p_new->p_next_           = g_ebr_record_list_top.load( std::memory_order_acquire );
+	while ( !g_ebr_record_list_top.compare_exchange_weak( p_new->p_next_, p_new, std::memory_order_acq_rel, std::memory_order_acquire ) ) {
+	}
+	return p_new;
+}
+
+/**
+ * @brief try to advance the global epoch
+ *
+ * @return true the global epoch was advanced by this thread or other thread
+ * @return false there is a thread that has not announced the current global epoch yet
+ */
+static bool try_advance_ebr_global_epoch( void ) noexcept
+{
+	std::uint64_t cur_epoch = g_ebr_global_epoch.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );   // Enter()のフェンスと対になる。
+
+	ebr_thread_record* p_cur = g_ebr_record_list_top.load( std::memory_order_acquire );
+	while ( p_cur != nullptr ) {
+		std::uint64_t announced = p_cur->announced_epoch_.load( std::memory_order_acquire );
+		if ( ( ( announced & 1U ) != 0 ) && ( ( announced >> 1 ) != cur_epoch ) ) {
+			return false;
+		}
+		p_cur = p_cur->p_next_;
+	}
+
+	g_ebr_global_epoch.compare_exchange_strong( cur_epoch, cur_epoch + 1, std::memory_order_acq_rel, std::memory_order_acquire );
+	return true;
+}
+
+/**
+ * @brief call deleter for the retired pointers that are retired before 2 epochs or more
+ *
+ * @return size_t the number of retired pointers that could not be reclaimed yet
+ */
+static size_t reclaim_ebr_retired( ebr_thread_record* p_rec )
+{
+	if ( p_rec->is_reclaiming_ ) return p_rec->retired_.size();
+	if ( p_rec->retired_.empty() ) return 0;
+
+	p_rec->is_reclaiming_ = true;
+
+	try_advance_ebr_global_epoch();
+	std::uint64_t cur_epoch = g_ebr_global_epoch.load( std::memory_order_acquire );
+
+	// deleterからRetire()が呼ばれても、処理中のリストが変更されないように、リストを取り出してから処理する。
+	std::vector<ebr_retired_ptr> cur_retired;
+	cur_retired.swap( p_rec->retired_ );
+
+	auto it_not_yet_end = std::partition( cur_retired.begin(), cur_retired.end(), [cur_epoch]( const ebr_retired_ptr& e ) {
+		return ( e.epoch_ + 2 ) > cur_epoch;
+	} );
+	for ( auto it = it_not_yet_end; it != cur_retired.end(); it++ ) {
+		it->deleter_( it->p_ );
+	}
+	cur_retired.erase( it_not_yet_end, cur_retired.end() );
+
+	// deleterから追加されたものを後ろにつなぐ
+	cur_retired.insert( cur_retired.end(), p_rec->retired_.begin(), p_rec->retired_.end() );
+	p_rec->retired_.swap( cur_retired );
+
+	p_rec->is_reclaiming_ = false;
+	return p_rec->retired_.size();
+}
+
+static void adopt_ebr_orphans( ebr_thread_record* p_rec, bool is_try_lock )
+{
+	std::unique_lock<std::mutex> lk( g_ebr_orphan_mtx, std::defer_lock );
+	if ( is_try_lock ) {
+		if ( !lk.try_lock() ) return;
+	} else {
+		lk.lock();
+	}
+	if ( g_ebr_orphan_retired.empty() ) return;
+
+	p_rec->retired_.insert( p_rec->retired_.end(), g_ebr_orphan_retired.begin(), g_ebr_orphan_retired.end() );
+	g_ebr_orphan_retired.clear();
+}
+
+class ebr_thread_record_binder {
+public:
+	constexpr ebr_thread_record_binder( void ) noexcept
+	  : p_rec_( nullptr )
+	{
+	}
+	~ebr_thread_record_binder()
+	{
+		if ( p_rec_ == nullptr ) return;
+
+		if ( p_rec_->nest_count_ != 0 ) {
+			LogOutput( log_type::WARN, "thread exits in critical section of epoch based reclamation" );
+			p_rec_->nest_count_ = 0;
+			p_rec_->announced_epoch_.store( p_rec_->announced_epoch_.load( std::memory_order_relaxed ) & ~static_cast<std::uint64_t>( 1U ), std::memory_order_release );
+		}
+
+		reclaim_ebr_retired( p_rec_ );
+		if ( !p_rec_->retired_.empty() ) {
+			std::lock_guard<std::mutex> lk( g_ebr_orphan_mtx );
+			g_ebr_orphan_retired.insert( g_ebr_orphan_retired.end(), p_rec_->retired_.begin(), p_rec_->retired_.end() );
+			p_rec_->retired_.clear();
+		}
+
+		p_rec_->is_used_.store( false, std::memory_order_release );
+		p_rec_ = nullptr;
+	}
+
+	ebr_thread_record* get( void )
+	{
+		if ( p_rec_ == nullptr ) {
+			p_rec_ = acquire_ebr_thread_record();
+		}
+		return p_rec_;
+	}
+
+	ebr_thread_record* get_if_acquired( void ) const noexcept
+	{
+		return p_rec_;
+	}
+
+private:
+	ebr_thread_record* p_rec_;
+};
+
+thread_local ebr_thread_record_binder tl_ebr_binder;
+
+//////////////////////////////////////////////////////////////////////////////
+void ebr_domain::Enter( void )
+{
+	ebr_thread_record* p_rec = tl_ebr_binder.get();
+	if ( p_rec->nest_count_++ != 0 ) return;
+
+	std::uint64_t cur_epoch = g_ebr_global_epoch.load( std::memory_order_acquire );
+	p_rec->announced_epoch_.store( ( cur_epoch << 1 ) | 1U, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );   // 共有データ構造からのロードが、アナウンスより前に行われないようにする。
+}
+
+void ebr_domain::Leave( void ) noexcept
+{
+	ebr_thread_record* p_rec = tl_ebr_binder.get();
+	if ( p_rec->nest_count_ == 0 ) {
+		LogOutput( log_type::ERR, "ebr_domain::Leave() is called without ebr_domain::Enter()" );
+		return;
+	}
+	if ( --( p_rec->nest_count_ ) != 0 ) return;
+
+	p_rec->announced_epoch_.store( p_rec->announced_epoch_.load( std::memory_order_relaxed ) & ~static_cast<std::uint64_t>( 1U ), std::memory_order_release );
+}
+
+void ebr_domain::Retire( void* p, retire_deleter_t deleter )
+{
+	if ( p == nullptr ) return;
+
+	ebr_thread_record* p_rec = tl_ebr_binder.get();
+	p_rec->retired_.push_back( ebr_retired_ptr { p, deleter, g_ebr_global_epoch.load( std::memory_order_acquire ) } );
+	if ( p_rec->is_reclaiming_ ) return;
+	if ( p_rec->retired_.size() < conf_ebr_reclaim_threshold ) return;
+
+	adopt_ebr_orphans( p_rec, true );
+	reclaim_ebr_retired( p_rec );
+}
+
+size_t ebr_domain::DrainRetired( void )
+{
+	ebr_thread_record* p_rec = tl_ebr_binder.get();
+	adopt_ebr_orphans( p_rec, false );
+
+	size_t ans = 0;
+	for ( size_t i = 0; i < conf_ebr_drain_try_count; i++ ) {
+		ans = reclaim_ebr_retired( p_rec );
+		if ( ans == 0 ) break;
+	}
+	return ans;
+}
+
+std::uint64_t ebr_domain::GetGlobalEpoch( void ) noexcept
+{
+	return g_ebr_global_epoch.load( std::memory_order_acquire );
+}
+
+void ebr_lock_orphan_for_fork( void ) noexcept
+{
+	g_ebr_orphan_mtx.lock();
+}
+
+void ebr_unlock_orphan_for_fork( void ) noexcept
+{
+	g_ebr_orphan_mtx.unlock();
+}
+
+void ebr_release_other_thread_records_in_child( void ) noexcept
+{
+	// 子プロセスには、fork()を呼び出したスレッドしか存在しない。
+	// 他スレッドのレコードがクリティカルセクション中のまま残ると、グローバルエポックが進まなくなるため、未使用に戻す。
+	ebr_thread_record* p_self = tl_ebr_binder.get_if_acquired();
+	ebr_thread_record* p_cur  = g_ebr_record_list_top.load( std::memory_order_acquire );
+	while ( p_cur != nullptr ) {
+		if ( ( p_cur != p_self ) && p_cur->is_used_.load( std::memory_order_acquire ) ) {
+			p_cur->announced_epoch_.store( 0, std::memory_order_relaxed );
+			p_cur->nest_count_    = 0;
+			p_cur->is_reclaiming_ = false;
+			// fork()の時点で所有スレッドが更新中だった可能性があるため、退避済みのポインタは解放せずに手放す。
+			new ( &( p_cur->retired_ ) ) std::vector<ebr_retired_ptr>();
+			p_cur->is_used_.store( false, std::memory_order_release );
+		}
+		p_cur = p_cur->p_next_;
+	}
+}
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
@@ -0,0 +1,114 @@
+/**
+ * @file eventcount.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <climits>
+
+#include "alconcurrent/internal/eventcount.hpp"
+
+#ifdef ALCC_INTERNAL_EVENTCOUNT_USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+#ifdef ALCC_INTERNAL_EVENTCOUNT_USE_FUTEX
+namespace {
+
+static_assert( sizeof( std::atomic<eventcount::key_type> ) == sizeof( std::uint32_t ), "futex word should be 32bit" );
+
+long futex_wait( std::atomic<eventcount::key_type>* p_word, eventcount::key_type expected, const struct timespec* p_rel_timeout )
+{
+	// FUTEX_WAITのタイムアウトは、CLOCK_MONOTONICでの相対時間
+	return syscall( SYS_futex, reinterpret_cast<std::uint32_t*>( p_word ), FUTEX_WAIT_PRIVATE, expected, p_rel_timeout, nullptr, 0 );
+}
+
+long futex_wake( std::atomic<eventcount::key_type>* p_word, int n )
+{
+	return syscall( SYS_futex, reinterpret_cast<std::uint32_t*>( p_word ), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0 );
+}
+
+}   // namespace
+
+void eventcount::commit_wait( key_type key ) noexcept
+{
+	// epoch_がkeyと異なる場合、futex_wait()はすぐに戻る。そのため、prepare_wait()以降のnotifyを取りこぼさない。
+	futex_wait( &epoch_, key, nullptr );
+	waiters_.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+bool eventcount::commit_wait_for( key_type key, std::chrono::nanoseconds rel_time ) noexcept
+{
+	if ( rel_time.count() <= 0 ) {
+		waiters_.fetch_sub( 1, std::memory_order_relaxed );
+		return epoch_.load( std::memory_order_acquire ) != key;
+	}
+
+	struct timespec rel_timeout;
+	rel_timeout.tv_sec  = static_cast<time_t>( rel_time.count() / 1000000000 );
+	rel_timeout.tv_nsec = static_cast<long>( rel_time.count() % 1000000000 );
+
+	futex_wait( &epoch_, key, &rel_timeout );
+	waiters_.fetch_sub( 1, std::memory_order_relaxed );
+	return epoch_.load( std::memory_order_acquire ) != key;
+}
+
+void eventcount::wake( bool is_all ) noexcept
+{
+	epoch_.fetch_add( 1, std::memory_order_seq_cst );
+	futex_wake( &epoch_, is_all ? INT_MAX : 1 );
+}
+
+#else
+
+void eventcount::commit_wait( key_type key ) noexcept
+{
+	{
+		std::unique_lock<std::mutex> lk( mtx_ );
+		cv_.wait( lk, [this, key]() { return epoch_.load( std::memory_order_acquire ) != key; } );
+	}
+	waiters_.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+bool eventcount::commit_wait_for( key_type key, std::chrono::nanoseconds rel_time ) noexcept
+{
+	bool ret;
+	{
+		std::unique_lock<std::mutex> lk( mtx_ );
+		ret = cv_.wait_for( lk, rel_time, [this, key]() { return epoch_.load( std::memory_order_acquire ) != key; } );
+	}
+	waiters_.fetch_sub( 1, std::memory_order_relaxed );
+	return ret;
+}
+
+void eventcount::wake( bool is_all ) noexcept
+{
+	{
+		// 待ち合わせ側の条件確認とcv_.wait()の間に、epoch_の更新とnotifyが入り込まないように、ロック内で更新する。
+		std::lock_guard<std::mutex> lk( mtx_ );
+		epoch_.fetch_add( 1, std::memory_order_seq_cst );
+	}
+	if ( is_all ) {
+		cv_.notify_all();
+	} else {
+		cv_.notify_one();
+	}
+}
+
+#endif
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
@@ -9,22 +9,44 @@
  *
  */
 
+#include <algorithm>
 #include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <stdexcept>
 #include <string>
 #include <thread>
 #include <tuple>
 
+#include <pthread.h>
+
+#ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE
+#if defined( __linux__ ) && __has_include( <linux/membarrier.h> )
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifdef __NR_membarrier
+#define ALCC_INTERNAL_ENABLE_MEMBARRIER
+#endif
+#endif
+#endif
+
+
 #include "alconcurrent/conf_logger.hpp"
+#include "alconcurrent/dynamic_tls.hpp"
 #include "alconcurrent/internal/cpp_std_configure.hpp"
 #include "alconcurrent/internal/hazard_ptr_internal.hpp"
+#include "alconcurrent/lf_mem_alloc.hpp"
 #include "alloc_only_allocator.hpp"
 
 #include "hazard_ptr_impl.hpp"
 
+#ifdef ALCC_INTERNAL_ENABLE_X86_SIMD_HZRD_SCAN
+#include <immintrin.h>
+#endif
+
 namespace alpha {
 namespace concurrent {
 namespace internal {
@@ -38,6 +60,67 @@ static ALCC_INTERNAL_CONSTINIT alloc_only_chamber g_alloc_only_inst_for_hzrd_ptr
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 ALCC_INTERNAL_CONSTINIT global_scope_hazard_ptr_chain     g_scope_hzrd_chain_;
 thread_local ALCC_INTERNAL_CONSTINIT bind_hazard_ptr_list tl_bhpl;
+thread_local retired_ptr_list                             tl_retired_list;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE
+std::atomic<bool> g_is_hzrd_ptr_asymmetric_fence_available( false );
+
+/**
+ * @brief check and register MEMBARRIER_CMD_PRIVATE_EXPEDITED
+ *
+ * g_is_hzrd_ptr_asymmetric_fence_available becomes true only after the registration is succeeded.
+ * Therefore, if a reader observes true, the reclaimer side also issues membarrier().
+ */
+static bool register_hzrd_ptr_asymmetric_fence( void ) noexcept
+{
+#ifdef ALCC_INTERNAL_ENABLE_MEMBARRIER
+	long ret = syscall( __NR_membarrier, MEMBARRIER_CMD_QUERY, 0 );
+	if ( ( ret < 0 ) || ( ( ret & MEMBARRIER_CMD_PRIVATE_EXPEDITED ) == 0 ) ) {
+		LogOutput( log_type::DEBUG, "membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED) is not supported. hazard pointer uses seq_cst fence" );
+		return false;
+	}
+	if ( syscall( __NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0 ) != 0 ) {
+		LogOutput( log_type::DEBUG, "fail to register membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED). hazard pointer uses seq_cst fence" );
+		return false;
+	}
+	g_is_hzrd_ptr_asymmetric_fence_available.store( true, std::memory_order_release );
+	return true;
+#else
+	return false;
+#endif
+}
+
+static bool is_hzrd_ptr_asymmetric_fence_registered( void ) noexcept
+{
+	static const bool is_registered = register_hzrd_ptr_asymmetric_fence();
+	return is_registered;
+}
+
+static const bool is_hzrd_ptr_asymmetric_fence_registered_at_startup = is_hzrd_ptr_asymmetric_fence_registered();   // readers get the light fence from the beginning as much as possible
+#endif
+
+/**
+ * @brief reclaimer side fence that should be called before scanning hazard pointer slots
+ *
+ * This pairs with hzrd_slot_fence_after_store().
+ */
+static inline void hzrd_slot_fence_before_scan( void ) noexcept
+{
+#ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE
+#ifdef ALCC_INTERNAL_ENABLE_MEMBARRIER
+	if ( is_hzrd_ptr_asymmetric_fence_registered() ) {
+		if ( syscall( __NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0 ) == 0 ) {
+			return;
+		}
+		// membarrier()の登録後に失敗することはないはずだが、readerは軽量フェンスしか発行していないため、処理を継続できない。
+		LogOutput( log_type::ERR, "membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED) is failed after registration" );
+		std::terminate();
+	}
+#endif
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+#endif
+}
 
 ///////////////////////////////////////////////////////////////////////
 #ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_PROFILE
@@ -75,6 +158,7 @@ hzrd_slot_ownership_t hazard_ptr_group::try_assign( const void* p )
 	// なお、thisのインスタンスはスレッドローカル変数なので、スレッド間競合は考えなくてよい。
 	if ( next_assign_hint_it_->load( std::memory_order_acquire ) == nullptr ) {
 		next_assign_hint_it_->store( p, internal::hzrd_slot_memory_order_for_store );
+		internal::hzrd_slot_fence_after_store();
 		ans = hzrd_slot_ownership_t( &( *next_assign_hint_it_ ) );
 		++next_assign_hint_it_;
 		if ( next_assign_hint_it_ == end() ) {
@@ -92,6 +176,7 @@ hzrd_slot_ownership_t hazard_ptr_group::try_assign( const void* p )
 #endif
 		if ( it->load( std::memory_order_acquire ) == nullptr ) {
 			it->store( p, internal::hzrd_slot_memory_order_for_store );
+			internal::hzrd_slot_fence_after_store();
 			ans = hzrd_slot_ownership_t( &( *it ) );
 			++it;
 			if ( it == end() ) {
@@ -109,6 +194,7 @@ hzrd_slot_ownership_t hazard_ptr_group::try_assign( const void* p )
 #endif
 		if ( it->load( std::memory_order_acquire ) == nullptr ) {
 			it->store( p, internal::hzrd_slot_memory_order_for_store );
+			internal::hzrd_slot_fence_after_store();
 			ans = hzrd_slot_ownership_t( &( *it ) );
 			++it;
 			if ( it == end() ) {
@@ -143,11 +229,82 @@ void hazard_ptr_group::force_clear( void ) noexcept
 	}
 }
 
+#ifdef ALCC_INTERNAL_ENABLE_X86_SIMD_HZRD_SCAN
+static_assert( sizeof( std::atomic<const void*> ) == sizeof( long long ), "SIMD scan of hazard pointer slots requires 64bit pointer" );
+
+/**
+ * @brief compare 2 slots per instruction by SSE2
+ *
+ * SSE2 does not have 64bit compare. Therefore, 64bit lane is equal if all 8 bytes of the lane are equal.
+ */
+bool chk_hzrd_slots_sse2( const std::atomic<const void*>* p_slots, const void* p )
+{
+	const long long* p_top = reinterpret_cast<const long long*>( p_slots );
+	const __m128i    v_p   = _mm_set1_epi64x( static_cast<long long>( reinterpret_cast<std::uintptr_t>( p ) ) );
+
+	size_t i = 0;
+	for ( ; ( i + 2 ) <= hazard_ptr_group::kArraySize; i += 2 ) {
+		__m128i v_slots = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p_top + i ) );
+		int     mask    = _mm_movemask_epi8( _mm_cmpeq_epi8( v_slots, v_p ) );
+		if ( ( ( mask & 0x00FF ) == 0x00FF ) || ( ( mask & 0xFF00 ) == 0xFF00 ) ) return true;
+	}
+	for ( ; i < hazard_ptr_group::kArraySize; i++ ) {
+		if ( p_slots[i].load( std::memory_order_relaxed ) == p ) return true;
+	}
+	std::atomic_thread_fence( std::memory_order_acquire );   // スカラー版のacquireロードに合わせる
+	return false;
+}
+
+/**
+ * @brief compare 4 slots per instruction by AVX2
+ *
+ * The rest of slots that does not fill 4 slots are loaded by masked load. Therefore, this does not read beyond the slot array.
+ */
+__attribute__( ( target( "avx2" ) ) ) bool chk_hzrd_slots_avx2( const std::atomic<const void*>* p_slots, const void* p )
+{
+	const long long* p_top = reinterpret_cast<const long long*>( p_slots );
+	const __m256i    v_p   = _mm256_set1_epi64x( static_cast<long long>( reinterpret_cast<std::uintptr_t>( p ) ) );
+
+	size_t i = 0;
+	for ( ; ( i + 4 ) <= hazard_ptr_group::kArraySize; i += 4 ) {
+		__m256i v_slots = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( p_top + i ) );
+		if ( _mm256_movemask_epi8( _mm256_cmpeq_epi64( v_slots, v_p ) ) != 0 ) return true;
+	}
+	if ( i < hazard_ptr_group::kArraySize ) {
+		constexpr size_t rest    = hazard_ptr_group::kArraySize % 4;
+		const __m256i    v_mask  = _mm256_setr_epi64x( -1LL, ( rest > 1 ) ? -1LL : 0LL, ( rest > 2 ) ? -1LL : 0LL, 0LL );
+		__m256i          v_slots = _mm256_maskload_epi64( p_top + i, v_mask );   // マスク外のレーンは0になるが、pはnullptrではないため一致しない。
+		if ( _mm256_movemask_epi8( _mm256_cmpeq_epi64( v_slots, v_p ) ) != 0 ) return true;
+	}
+	std::atomic_thread_fence( std::memory_order_acquire );   // スカラー版のacquireロードに合わせる
+	return false;
+}
+
+static bool chk_hzrd_slots_resolve( const std::atomic<const void*>* p_slots, const void* p );
+
+static std::atomic<chk_hzrd_slots_t> g_chk_hzrd_slots_func( chk_hzrd_slots_resolve );   // 初回呼び出し時に、CPUの機能に合わせて差し替える
+
+chk_hzrd_slots_t select_chk_hzrd_slots_func( void )
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports( "avx2" ) ? chk_hzrd_slots_avx2 : chk_hzrd_slots_sse2;
+}
+
+static bool chk_hzrd_slots_resolve( const std::atomic<const void*>* p_slots, const void* p )
+{
+	chk_hzrd_slots_t p_func = select_chk_hzrd_slots_func();
+	g_chk_hzrd_slots_func.store( p_func, std::memory_order_relaxed );
+	return p_func( p_slots, p );
+}
+#endif
+
 bool hazard_ptr_group::check_pointer_is_hazard_pointer( void* p ) noexcept
 {
 	if ( p == nullptr ) return false;
 
-#if 1
+#if defined( ALCC_INTERNAL_ENABLE_X86_SIMD_HZRD_SCAN )
+	return g_chk_hzrd_slots_func.load( std::memory_order_relaxed )( hzrd_ptr_array_.data(), p );
+#elif 1
 	// 単一スレッド処理においては、余分な中間メモリ処理を介さない分、こちらの方が速い。
 	for ( auto& e : *this ) {
 		// if hazard_ptr_group has a pointer that is same to p, p is hazard pointer
@@ -181,6 +338,16 @@ void hazard_ptr_group::scan_hazard_pointers( std::function<void( const void* )>&
 	}
 }
 
+void hazard_ptr_group::take_snapshot( hazard_ptr_snapshot& snapshot ) noexcept
+{
+	for ( auto& e : *this ) {
+		const void* p = e.load( std::memory_order_acquire );
+		if ( p != nullptr ) {
+			snapshot.push_back( p );
+		}
+	}
+}
+
 inline void log_and_throw( const char* p )
 {
 	internal::LogOutput( log_type::ERR, p );
@@ -494,6 +661,7 @@ hzrd_slot_ownership_t bind_hazard_ptr_list::slot_assign( const void* p )
 	if ( p_pre_list != nullptr ) {
 		// 追加割り当てが必要になった状態
 		p_new_hpg = new hazard_ptr_group;   // ここから例外がスローされる可能性がある。
+		g_scope_hzrd_chain_.count_up_hazard_ptr_group();
 		p_pre_list->ap_list_next_.store( p_new_hpg, std::memory_order_release );
 	} else {
 		// まだなにも割り当てられていない状態。
@@ -511,6 +679,41 @@ hzrd_slot_ownership_t bind_hazard_ptr_list::slot_assign( const void* p )
 	return ans;
 }
 
+void bind_hazard_ptr_list::slots_assign( hzrd_slot_ownership_t* p_out, size_t n )
+{
+	if ( n == 0 ) return;
+
+	const void* p_for_store = reinterpret_cast<const void*>( static_cast<std::uintptr_t>( 1U ) );   // 使用中であるが、ハザードポインタは無い状態
+
+	if ( ownership_ticket_ == nullptr ) {
+		ownership_ticket_ = global_scope_hazard_ptr_chain::GetOwnership();
+	}
+
+	size_t            assigned_cnt = 0;
+	hazard_ptr_group* p_pre_list   = nullptr;
+	hazard_ptr_group* p_cur_list   = ownership_ticket_.get();
+	while ( assigned_cnt < n ) {
+		if ( p_cur_list == nullptr ) {
+			// 追加割り当てが必要になった状態
+			p_cur_list = new hazard_ptr_group;   // ここから例外がスローされる可能性がある。
+			g_scope_hzrd_chain_.count_up_hazard_ptr_group();
+			p_pre_list->ap_list_next_.store( p_cur_list, std::memory_order_release );
+		}
+
+		// 1つのグループから、空きスロットがなくなるまで割り当てる
+		hzrd_slot_ownership_t ans = p_cur_list->try_assign( p_for_store );
+		if ( ans != nullptr ) {
+			p_out[assigned_cnt] = std::move( ans );
+			assigned_cnt++;
+			continue;
+		}
+
+		hazard_ptr_group* p_next_list = p_cur_list->ap_list_next_.load( std::memory_order_acquire );
+		p_pre_list                    = p_cur_list;
+		p_cur_list                    = p_next_list;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////
 hazard_ptr_group::ownership_t global_scope_hazard_ptr_chain::GetOwnership( void )
 {
@@ -543,6 +746,44 @@ hazard_ptr_group::ownership_t global_scope_hazard_ptr_chain::try_get_ownership(
 void global_scope_hazard_ptr_chain::release_ownership( hazard_ptr_group::ownership_t up_o )
 {
 	hazard_ptr_group::remove_hazard_ptr_group_from_valid_chain( up_o.get(), &aaddr_top_hzrd_ptr_valid_chain_ );
+	detach_extended_hazard_ptr_groups( up_o.get() );
+}
+
+void global_scope_hazard_ptr_chain::detach_extended_hazard_ptr_groups( hazard_ptr_group* p_top_hpg )
+{
+	// 走査中のスレッドがいても、切り離したhazard_ptr_groupのメモリは解放されず、かつ、スロットはクリア済みのため、走査が途中で終わっても問題ない。
+	// 切り離したhazard_ptr_groupを他のスレッドが再使用した場合のハザードポインタは、ハザードポインタ登録後の検証で保護される。
+	hazard_ptr_group* p_cur_list = p_top_hpg->ap_list_next_.exchange( nullptr, std::memory_order_acq_rel );
+	while ( p_cur_list != nullptr ) {
+		// register_new_hazard_ptr_group()で再使用可能になる前に、リストから切り離しておく
+		hazard_ptr_group* p_next_list = p_cur_list->ap_list_next_.exchange( nullptr, std::memory_order_acq_rel );
+		register_new_hazard_ptr_group( p_cur_list );
+		p_cur_list = p_next_list;
+	}
+}
+
+size_t global_scope_hazard_ptr_chain::CountHazardPtrGroupsOnValidChain( void ) noexcept
+{
+	return g_scope_hzrd_chain_.count_hazard_ptr_groups_on_valid_chain();
+}
+
+size_t global_scope_hazard_ptr_chain::count_hazard_ptr_groups_on_valid_chain( void ) noexcept
+{
+	size_t            ans         = 0;
+	hazard_ptr_group* p_cur_chain = get_pointer_from_addr_clr_marker<hazard_ptr_group>( aaddr_top_hzrd_ptr_valid_chain_.load( std::memory_order_acquire ) );
+
+	while ( p_cur_chain != nullptr ) {
+		hazard_ptr_group* p_cur_list = p_cur_chain;
+		while ( p_cur_list != nullptr ) {
+			ans++;
+			hazard_ptr_group* p_next_list = p_cur_list->ap_list_next_.load( std::memory_order_acquire );
+			p_cur_list                    = p_next_list;
+		}
+		hazard_ptr_group* p_next_chain = p_cur_chain->get_valid_chain_next_reader_accesser().load_pointer<hazard_ptr_group>();
+		p_cur_chain                    = p_next_chain;
+	}
+
+	return ans;
 }
 
 void global_scope_hazard_ptr_chain::register_new_hazard_ptr_group( hazard_ptr_group* p_hpg_arg )
@@ -575,6 +816,7 @@ hazard_ptr_group::ownership_t global_scope_hazard_ptr_chain::get_ownership( void
 			throw std::logic_error( "Fail to get ownership. this is logic error" );
 		}
 		register_new_hazard_ptr_group( p_new_hpg );
+		count_up_hazard_ptr_group();
 	}
 
 	// valid chainに追加する
@@ -622,6 +864,25 @@ void global_scope_hazard_ptr_chain::scan_hazard_pointers( std::function<void( co
 	}
 }
 
+void global_scope_hazard_ptr_chain::take_snapshot( hazard_ptr_snapshot& snapshot ) noexcept
+{
+	hazard_ptr_group* p_cur_chain = get_pointer_from_addr_clr_marker<hazard_ptr_group>( aaddr_top_hzrd_ptr_valid_chain_.load( std::memory_order_acquire ) );
+
+	while ( p_cur_chain != nullptr ) {
+		hazard_ptr_group* p_cur_list = p_cur_chain;
+		while ( p_cur_list != nullptr ) {
+			p_cur_list->take_snapshot( snapshot );
+
+			hazard_ptr_group* p_next_list = p_cur_list->ap_list_next_.load( std::memory_order_acquire );
+			p_cur_list                    = p_next_list;
+		}
+		hazard_ptr_group* p_next_chain = p_cur_chain->get_valid_chain_next_reader_accesser().load_pointer<hazard_ptr_group>();
+		p_cur_chain                    = p_next_chain;
+	}
+
+	snapshot.sort();
+}
+
 void global_scope_hazard_ptr_chain::remove_all( void )
 {
 	tl_bhpl = bind_hazard_ptr_list();
@@ -629,6 +890,7 @@ void global_scope_hazard_ptr_chain::remove_all( void )
 	aaddr_top_hzrd_ptr_valid_chain_.store( 0, std::memory_order_release );
 	hazard_ptr_group* p_cur_chain = ap_top_hzrd_ptr_chain_.load( std::memory_order_acquire );
 	ap_top_hzrd_ptr_chain_.store( nullptr, std::memory_order_release );
+	num_of_hzrd_ptr_groups_.store( 0, std::memory_order_release );
 
 	while ( p_cur_chain != nullptr ) {
 		hazard_ptr_group* p_next_chain = p_cur_chain->ap_chain_next_.load( std::memory_order_acquire );
@@ -659,6 +921,372 @@ void global_scope_hazard_ptr_chain::remove_all( void )
 #endif
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief overflow buffer of hazard_ptr_snapshot that is cached per thread
+ *
+ * The buffer is reused by the next snapshot of the same thread. Therefore, the allocation happens only when the number of hazard pointers exceeds the largest one so far.
+ * This is trivially destructible to be accessible from the destructors of other thread local variables. The buffer itself is released by tl_snapshot_buffer_releaser.
+ */
+struct tl_snapshot_buffer {
+	const void** p_buff_;           //!< cached buffer
+	size_t       capacity_;         //!< capacity of p_buff_
+	bool         is_borrowed_;      //!< true: a snapshot uses p_buff_ now
+	bool         is_unavailable_;   //!< true: the thread is exiting and p_buff_ is already released
+};
+static thread_local ALCC_INTERNAL_CONSTINIT tl_snapshot_buffer tl_snapshot_buff { nullptr, 0, false, false };
+
+struct tl_snapshot_buffer_releaser {
+	tl_snapshot_buffer_releaser( void ) noexcept = default;
+	~tl_snapshot_buffer_releaser()
+	{
+		delete[] tl_snapshot_buff.p_buff_;
+		tl_snapshot_buff.p_buff_         = nullptr;
+		tl_snapshot_buff.capacity_       = 0;
+		tl_snapshot_buff.is_unavailable_ = true;
+	}
+};
+static thread_local tl_snapshot_buffer_releaser tl_snapshot_buff_releaser;
+
+static const void** allocate_snapshot_buff( size_t capacity ) noexcept
+{
+	return new ( std::nothrow ) const void*[capacity];
+}
+
+hazard_ptr_snapshot::hazard_ptr_snapshot( void ) noexcept
+  : inline_buff_ {}
+  , p_overflow_buff_( nullptr )
+  , is_overflow_buff_owned_( false )
+  , size_( 0 )
+  , capacity_( kInlineCapacity )
+  , is_incomplete_( false )
+{
+}
+
+hazard_ptr_snapshot::hazard_ptr_snapshot( hazard_ptr_snapshot&& src ) noexcept
+  : inline_buff_ {}
+  , p_overflow_buff_( src.p_overflow_buff_ )
+  , is_overflow_buff_owned_( src.is_overflow_buff_owned_ )
+  , size_( src.size_ )
+  , capacity_( src.capacity_ )
+  , is_incomplete_( src.is_incomplete_ )
+{
+	if ( p_overflow_buff_ == nullptr ) {
+		std::copy( src.inline_buff_, src.inline_buff_ + size_, inline_buff_ );
+	}
+	src.p_overflow_buff_        = nullptr;
+	src.is_overflow_buff_owned_ = false;
+	src.size_                   = 0;
+	src.capacity_               = kInlineCapacity;
+	src.is_incomplete_          = false;
+}
+
+hazard_ptr_snapshot& hazard_ptr_snapshot::operator=( hazard_ptr_snapshot&& src ) noexcept
+{
+	if ( this == &src ) return *this;
+
+	release_overflow_buff();
+	p_overflow_buff_        = src.p_overflow_buff_;
+	is_overflow_buff_owned_ = src.is_overflow_buff_owned_;
+	size_                   = src.size_;
+	capacity_               = src.capacity_;
+	is_incomplete_          = src.is_incomplete_;
+	if ( p_overflow_buff_ == nullptr ) {
+		std::copy( src.inline_buff_, src.inline_buff_ + size_, inline_buff_ );
+	}
+	src.p_overflow_buff_        = nullptr;
+	src.is_overflow_buff_owned_ = false;
+	src.size_                   = 0;
+	src.capacity_               = kInlineCapacity;
+	src.is_incomplete_          = false;
+
+	return *this;
+}
+
+hazard_ptr_snapshot::~hazard_ptr_snapshot()
+{
+	release_overflow_buff();
+}
+
+void hazard_ptr_snapshot::release_overflow_buff( void ) noexcept
+{
+	if ( p_overflow_buff_ == nullptr ) return;
+
+	if ( is_overflow_buff_owned_ ) {
+		delete[] p_overflow_buff_;
+	} else {
+		tl_snapshot_buff.is_borrowed_ = false;
+	}
+	p_overflow_buff_        = nullptr;
+	is_overflow_buff_owned_ = false;
+}
+
+bool hazard_ptr_snapshot::contains( const void* p ) const noexcept
+{
+	if ( p == nullptr ) return false;
+
+	if ( is_incomplete_ ) {
+		return hazard_ptr_mgr::CheckPtrIsHazardPtr( const_cast<void*>( p ) );
+	}
+	const void* const* p_top = data();
+	return std::binary_search( p_top, p_top + size_, p );
+}
+
+void hazard_ptr_snapshot::push_back( const void* p ) noexcept
+{
+	if ( is_incomplete_ ) return;
+
+	if ( size_ >= capacity_ ) {
+		size_t new_capacity = capacity_ * 2;
+
+		// スレッドローカルにキャッシュしたバッファを借りられる場合は、それを使う。
+		// 借りたバッファを拡張する場合も、拡張したバッファをキャッシュに戻すため、割り当ては最大のハザードポインタ数を更新したときだけとなる。
+		bool is_use_tl_buff = ( p_overflow_buff_ == nullptr ) ? ( !tl_snapshot_buff.is_borrowed_ && !tl_snapshot_buff.is_unavailable_ ) : !is_overflow_buff_owned_;
+		if ( is_use_tl_buff ) {
+			if ( tl_snapshot_buff.capacity_ < new_capacity ) {
+				const void** p_new_buff = allocate_snapshot_buff( new_capacity );
+				if ( p_new_buff == nullptr ) {
+					LogOutput( log_type::WARN, "hazard_ptr_snapshot fail to allocate buffer. contains() falls back to hazard_ptr_mgr::CheckPtrIsHazardPtr()" );
+					is_incomplete_ = true;
+					return;
+				}
+				std::copy( data(), data() + size_, p_new_buff );
+				static_cast<void>( &tl_snapshot_buff_releaser );   // スレッド終了時にバッファを解放するため、解放用のスレッドローカル変数を有効化する。
+				delete[] tl_snapshot_buff.p_buff_;
+				tl_snapshot_buff.p_buff_   = p_new_buff;
+				tl_snapshot_buff.capacity_ = new_capacity;
+			} else {
+				std::copy( data(), data() + size_, tl_snapshot_buff.p_buff_ );
+			}
+			tl_snapshot_buff.is_borrowed_ = true;
+			p_overflow_buff_              = tl_snapshot_buff.p_buff_;
+			is_overflow_buff_owned_       = false;
+			capacity_                     = tl_snapshot_buff.capacity_;
+		} else {
+			// 同じスレッドで他のスナップショットがキャッシュを使用中の場合等は、このスナップショット専用のバッファを割り当てる。
+			const void** p_new_buff = allocate_snapshot_buff( new_capacity );
+			if ( p_new_buff == nullptr ) {
+				LogOutput( log_type::WARN, "hazard_ptr_snapshot fail to allocate buffer. contains() falls back to hazard_ptr_mgr::CheckPtrIsHazardPtr()" );
+				is_incomplete_ = true;
+				return;
+			}
+			std::copy( data(), data() + size_, p_new_buff );
+			release_overflow_buff();
+			p_overflow_buff_        = p_new_buff;
+			is_overflow_buff_owned_ = true;
+			capacity_               = new_capacity;
+		}
+	}
+
+	( ( p_overflow_buff_ != nullptr ) ? p_overflow_buff_ : inline_buff_ )[size_] = p;
+	size_++;
+}
+
+void hazard_ptr_snapshot::sort( void ) noexcept
+{
+	const void** p_top = ( p_overflow_buff_ != nullptr ) ? p_overflow_buff_ : inline_buff_;
+	std::sort( p_top, p_top + size_ );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+retired_ptr_array::~retired_ptr_array()
+{
+	gmem_deallocate( p_buff_ );
+}
+
+bool retired_ptr_array::push_back( const retired_ptr& e ) noexcept
+{
+	if ( size_ >= capacity_ ) {
+		if ( !reserve( ( capacity_ == 0 ) ? 64 : capacity_ * 2 ) ) return false;
+	}
+	p_buff_[size_] = e;
+	size_++;
+	return true;
+}
+
+bool retired_ptr_array::append( const retired_ptr_array& src ) noexcept
+{
+	if ( src.empty() ) return true;
+	if ( ( size_ + src.size_ ) > capacity_ ) {
+		size_t new_capacity = ( capacity_ == 0 ) ? 64 : capacity_;
+		while ( new_capacity < ( size_ + src.size_ ) ) {
+			new_capacity *= 2;
+		}
+		if ( !reserve( new_capacity ) ) return false;
+	}
+	std::copy( src.p_buff_, src.p_buff_ + src.size_, p_buff_ + size_ );
+	size_ += src.size_;
+	return true;
+}
+
+void retired_ptr_array::erase( size_t idx_first, size_t idx_last ) noexcept
+{
+	std::copy( p_buff_ + idx_last, p_buff_ + size_, p_buff_ + idx_first );
+	size_ -= idx_last - idx_first;
+}
+
+bool retired_ptr_array::reserve( size_t new_capacity ) noexcept
+{
+	retired_ptr* p_new_buff = static_cast<retired_ptr*>( gmem_allocate( sizeof( retired_ptr ) * new_capacity ) );
+	if ( p_new_buff == nullptr ) return false;
+
+	std::copy( p_buff_, p_buff_ + size_, p_new_buff );
+	gmem_deallocate( p_buff_ );
+	p_buff_   = p_new_buff;
+	capacity_ = new_capacity;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+std::mutex        retired_ptr_list::orphan_mtx_;
+retired_ptr_array retired_ptr_list::orphan_retired_;
+
+retired_ptr_list::~retired_ptr_list()
+{
+	if ( retired_.empty() ) return;
+
+	reclaim();
+	if ( retired_.empty() ) return;
+
+	std::lock_guard<std::mutex> lk( orphan_mtx_ );
+	if ( !orphan_retired_.append( retired_ ) ) {
+		// グローバルなリストへ移せない場合、スレッド終了時に取り残さないよう、この場で解放する。
+		LogOutput( log_type::WARN, "retired_ptr_list fail to allocate the orphan list. %zu retired pointers are reclaimed synchronously", retired_.size() );
+		for ( size_t i = 0; i < retired_.size(); i++ ) {
+			reclaim_synchronously( retired_[i] );
+		}
+	}
+	retired_.clear();
+}
+
+void retired_ptr_list::push( void* p, hazard_ptr_mgr::retire_deleter_t deleter ) noexcept
+{
+	if ( !retired_.push_back( retired_ptr { p, deleter } ) ) {
+		// リストを拡張できない場合、回収して空いた領域に追加する。それでも追加できなければ、この場で解放する。
+		reclaim();
+		if ( !retired_.push_back( retired_ptr { p, deleter } ) ) {
+			LogOutput( log_type::WARN, "retired_ptr_list fail to allocate the list. %p is reclaimed synchronously", p );
+			reclaim_synchronously( retired_ptr { p, deleter } );
+			return;
+		}
+	}
+	if ( is_reclaiming_ ) return;
+	if ( retired_.size() < calc_threshold() ) return;
+
+	adopt_orphans( true );
+	reclaim();
+}
+
+size_t retired_ptr_list::reclaim( void ) noexcept
+{
+	if ( is_reclaiming_ ) return retired_.size();
+	if ( retired_.empty() ) return 0;
+
+	is_reclaiming_ = true;
+
+	// deleterからRetire()が呼ばれると、リストの後ろに追加される。
+	// その際にバッファが再割り当てされることがあるため、deleterを呼び出す間はインデックスでアクセスする。
+	size_t num_of_candidates = retired_.size();
+	size_t num_of_still_in_hazard;
+	if ( num_of_candidates == 1 ) {
+		// 候補が1つだけなら、スナップショットを作るよりも直接検査する方が安い。
+		num_of_still_in_hazard = hazard_ptr_mgr::CheckPtrIsHazardPtr( retired_[0].p_ ) ? 1 : 0;
+	} else {
+		// スナップショットは、候補の回収が終わった後に取得すること。
+		hazard_ptr_snapshot hzrd_snapshot = hazard_ptr_mgr::TakeSnapshot();
+
+		retired_ptr* it_still_in_hazard_end = std::partition( retired_.begin(), retired_.end(), [&hzrd_snapshot]( const retired_ptr& e ) {
+			return hzrd_snapshot.contains( e.p_ );
+		} );
+		num_of_still_in_hazard = static_cast<size_t>( it_still_in_hazard_end - retired_.begin() );
+	}
+	for ( size_t i = num_of_still_in_hazard; i < num_of_candidates; i++ ) {
+		retired_ptr e = retired_[i];
+		e.deleter_( e.p_ );
+	}
+	retired_.erase( num_of_still_in_hazard, num_of_candidates );
+
+	is_reclaiming_ = false;
+	return retired_.size();
+}
+
+void retired_ptr_list::adopt_orphans( bool is_try_lock ) noexcept
+{
+	std::unique_lock<std::mutex> lk( orphan_mtx_, std::defer_lock );
+	if ( is_try_lock ) {
+		if ( !lk.try_lock() ) return;
+	} else {
+		lk.lock();
+	}
+	if ( orphan_retired_.empty() ) return;
+
+	if ( !retired_.append( orphan_retired_ ) ) return;
+	orphan_retired_.clear();
+}
+
+void retired_ptr_list::reclaim_synchronously( const retired_ptr& e ) noexcept
+{
+	while ( hazard_ptr_mgr::CheckPtrIsHazardPtr( e.p_ ) ) {
+		std::this_thread::yield();
+	}
+	e.deleter_( e.p_ );
+}
+
+size_t retired_ptr_list::calc_threshold( void ) const noexcept
+{
+	// 1回のスキャンで、少なくともハザードポインタのスロット数と同数の回収が期待できる閾値とする。
+	size_t ans = g_scope_hzrd_chain_.get_num_of_hazard_ptr_slots() * 2;
+	return ( ans < kMinThreshold ) ? kMinThreshold : ans;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief fork handlers of this library
+ *
+ * To keep the consistency of the global data in the child process, every library global mutex is locked while fork().
+ * The lock order is fixed to below to avoid dead-lock with the threads that take some of them in nest.
+ *   1. dynamic_tls_global_exclusive_control_for_destructions. the thread local destructors take the mutexes below in this lock.
+ *   2. orphan list of retired_ptr_list
+ *   3. orphan list of ebr_domain
+ * The global lists of gmem and od_node_pool are lock-free, therefore they are always consistent.
+ * Objects in the thread local storages of other threads are not inherited to the child process, and they are just leaked in the child process.
+ */
+static void alcc_prepare_fork( void )
+{
+	dynamic_tls_global_exclusive_control_for_destructions.lock();
+	retired_ptr_list::lock_orphan_for_fork();
+	ebr_lock_orphan_for_fork();
+}
+
+static void alcc_release_fork_in_parent( void )
+{
+	ebr_unlock_orphan_for_fork();
+	retired_ptr_list::unlock_orphan_for_fork();
+	dynamic_tls_global_exclusive_control_for_destructions.unlock();
+}
+
+static void alcc_release_fork_in_child( void )
+{
+	ebr_unlock_orphan_for_fork();
+	ebr_release_other_thread_records_in_child();
+	retired_ptr_list::unlock_orphan_for_fork();
+	// recursive mutexは所有スレッドのIDで所有者を判定するが、子プロセスではスレッドIDが変わるためunlock()できない。
+	// 子プロセスには他スレッドが存在せず、prepareで取得したロックの状態も不要なため、初期化し直す。
+	new ( &dynamic_tls_global_exclusive_control_for_destructions ) std::recursive_mutex();
+}
+
+struct alcc_fork_handler_registerer {
+	alcc_fork_handler_registerer( void )
+	{
+		int ret = pthread_atfork( alcc_prepare_fork, alcc_release_fork_in_parent, alcc_release_fork_in_child );
+		if ( ret != 0 ) {
+			LogOutput( log_type::ERR, "fail to register the fork handlers of alconcurrent. errno=%d", ret );
+		}
+	}
+};
+
+static alcc_fork_handler_registerer g_alcc_fork_handler_registerer;
+
 //////////////////////////////////////////////////////////////////////////////
 
 hzrd_slot_ownership_t hazard_ptr_mgr::AssignHazardPtrSlot( const void* p )
@@ -666,16 +1294,57 @@ hzrd_slot_ownership_t hazard_ptr_mgr::AssignHazardPtrSlot( const void* p )
 	return internal::tl_bhpl.slot_assign( p );
 }
 
+void hazard_ptr_mgr::AssignHazardPtrSlots( hzrd_slot_ownership_t* p_out, size_t n )
+{
+	internal::tl_bhpl.slots_assign( p_out, n );
+}
+
 bool hazard_ptr_mgr::CheckPtrIsHazardPtr( void* p ) noexcept
 {
+	hzrd_slot_fence_before_scan();
 	return g_scope_hzrd_chain_.check_pointer_is_hazard_pointer( p );
 }
 
+bool hazard_ptr_mgr::CheckPtrMayBeHazardPtr( void* p ) noexcept
+{
+#ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_ASYMMETRIC_FENCE
+	if ( g_is_hzrd_ptr_asymmetric_fence_available.load( std::memory_order_relaxed ) ) {
+		// readerは軽量フェンスしか発行しないため、membarrier()なしでは設定途中のハザードポインタを見落とす可能性がある。
+		// 1回の検査ごとにmembarrier()を発行しないよう、ハザードポインタである可能性があるものとして扱い、
+		// membarrier()を1回だけ発行してまとめて検査するTakeSnapshot()等に判定を委ねる。
+		return true;
+	}
+#endif
+	return CheckPtrIsHazardPtr( p );
+}
+
 void hazard_ptr_mgr::ScanHazardPtrs( std::function<void( const void* )> pred )
 {
+	hzrd_slot_fence_before_scan();
 	g_scope_hzrd_chain_.scan_hazard_pointers( pred );
 }
 
+hazard_ptr_snapshot hazard_ptr_mgr::TakeSnapshot( void ) noexcept
+{
+	hzrd_slot_fence_before_scan();
+	hazard_ptr_snapshot ans;
+	g_scope_hzrd_chain_.take_snapshot( ans );
+	return ans;
+}
+
+void hazard_ptr_mgr::Retire( void* p, retire_deleter_t deleter ) noexcept
+{
+	if ( p == nullptr ) return;
+
+	tl_retired_list.push( p, deleter );
+}
+
+size_t hazard_ptr_mgr::DrainRetired( void )
+{
+	tl_retired_list.adopt_orphans( false );
+	return tl_retired_list.reclaim();
+}
+
 void hazard_ptr_mgr::DestoryAll( void )
 {
 	return g_scope_hzrd_chain_.remove_all();
@@ -16,9 +16,17 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "alconcurrent/internal/cpp_std_configure.hpp"
 
+#ifdef ALCONCURRENT_CONF_ENABLE_HAZARD_PTR_SIMD_SCAN
+#if defined( __x86_64__ ) && defined( __GNUC__ ) && !defined( __SANITIZE_THREAD__ )
+#define ALCC_INTERNAL_ENABLE_X86_SIMD_HZRD_SCAN
+#endif
+#endif
+
 namespace alpha {
 namespace concurrent {
 namespace internal {
@@ -415,6 +423,7 @@ public:
 
 	bool check_pointer_is_hazard_pointer( void* p ) noexcept;
 	void scan_hazard_pointers( std::function<void( const void* )>& pred );
+	void take_snapshot( hazard_ptr_snapshot& snapshot ) noexcept;
 
 	del_markable_pointer::writer_accesser get_valid_chain_next_writer_accesser( void )
 	{
@@ -510,6 +519,30 @@ private:
 	iterator                                     next_assign_hint_it_;
 };
 
+#ifdef ALCC_INTERNAL_ENABLE_X86_SIMD_HZRD_SCAN
+using chk_hzrd_slots_t = bool ( * )( const std::atomic<const void*>* p_slots, const void* p );   //!< function type to check whether p is in the slots of a hazard_ptr_group
+
+/**
+ * @brief check whether p is in hazard_ptr_group::kArraySize slots by SSE2
+ *
+ * @pre p is not nullptr
+ */
+bool chk_hzrd_slots_sse2( const std::atomic<const void*>* p_slots, const void* p );
+
+/**
+ * @brief check whether p is in hazard_ptr_group::kArraySize slots by AVX2
+ *
+ * @pre p is not nullptr
+ * @pre CPU supports AVX2
+ */
+bool chk_hzrd_slots_avx2( const std::atomic<const void*>* p_slots, const void* p );
+
+/**
+ * @brief select chk_hzrd_slots_avx2 or chk_hzrd_slots_sse2 according to the feature of CPU
+ */
+chk_hzrd_slots_t select_chk_hzrd_slots_func( void );
+#endif
+
 /**
  * @brief スレッドとhazard_ptr_listを紐づけるクラス
  *
@@ -533,6 +566,14 @@ public:
 	 */
 	hzrd_slot_ownership_t slot_assign( const void* p );
 
+	/**
+	 * @brief assign n slots of hazard pointer at once
+	 *
+	 * @param p_out pointer to the array of hzrd_slot_ownership_t that has n elements at least.
+	 * @param n the number of slots to assign
+	 */
+	void slots_assign( hzrd_slot_ownership_t* p_out, size_t n );
+
 private:
 	hazard_ptr_group::ownership_t ownership_ticket_;
 };
@@ -543,6 +584,7 @@ public:
 	constexpr global_scope_hazard_ptr_chain( void )
 	  : ap_top_hzrd_ptr_chain_( nullptr )
 	  , aaddr_top_hzrd_ptr_valid_chain_( 0 )
+	  , num_of_hzrd_ptr_groups_( 0 )
 	{
 	}
 
@@ -578,6 +620,13 @@ public:
 	 */
 	void scan_hazard_pointers( std::function<void( const void* )>& pred );
 
+	/**
+	 * @brief gather all hazard pointers into snapshot
+	 *
+	 * @param snapshot output destination
+	 */
+	void take_snapshot( hazard_ptr_snapshot& snapshot ) noexcept;
+
 	/**
 	 * @brief remove all hazard_ptr_group
 	 */
@@ -588,6 +637,31 @@ public:
 		return ap_top_hzrd_ptr_chain_.load( std::memory_order_acquire ) == nullptr;
 	}
 
+	/**
+	 * @brief count the hazard_ptr_group that are scanned by check_pointer_is_hazard_pointer() and scan_hazard_pointers()
+	 *
+	 * This is for debug and test purpose.
+	 */
+	static size_t CountHazardPtrGroupsOnValidChain( void ) noexcept;
+
+	/**
+	 * @brief count up the number of allocated hazard_ptr_group
+	 */
+	void count_up_hazard_ptr_group( void ) noexcept
+	{
+		num_of_hzrd_ptr_groups_.fetch_add( 1, std::memory_order_acq_rel );
+	}
+
+	/**
+	 * @brief get the number of allocated hazard pointer slots
+	 *
+	 * @return size_t the number of allocated hazard pointer slots
+	 */
+	size_t get_num_of_hazard_ptr_slots( void ) const noexcept
+	{
+		return num_of_hzrd_ptr_groups_.load( std::memory_order_acquire ) * hazard_ptr_group::kArraySize;
+	}
+
 private:
 	/**
 	 * @brief try to get ownership from unused hazard_ptr_group list
@@ -619,6 +693,19 @@ private:
 	 */
 	void register_hazard_ptr_group_to_valid_list( hazard_ptr_group* p_hpg_arg );
 
+	/**
+	 * @brief detach the hazard_ptr_group that are chained by ap_list_next_ of p_top_hpg, and register them as independent hazard_ptr_group
+	 *
+	 * hazard_ptr_group that are added by a thread that needs many hazard pointers are kept in the list of the owner thread.
+	 * If they are left in the list after the thread exits, the next owner of p_top_hpg scans all of them even if the next owner uses only a few slots.
+	 * Therefore, they are detached and become the target of try_get_ownership() as same as other unused hazard_ptr_group.
+	 *
+	 * @pre all slots of the list of p_top_hpg are cleared.
+	 */
+	void detach_extended_hazard_ptr_groups( hazard_ptr_group* p_top_hpg );
+
+	size_t count_hazard_ptr_groups_on_valid_chain( void ) noexcept;
+
 	/**
 	 * @brief get ownership from unused hazard_ptr_group list
 	 *
@@ -628,8 +715,162 @@ private:
 
 	std::atomic<hazard_ptr_group*> ap_top_hzrd_ptr_chain_;
 	std::atomic<std::uintptr_t>    aaddr_top_hzrd_ptr_valid_chain_;
+	std::atomic<size_t>            num_of_hzrd_ptr_groups_;   //!< the number of allocated hazard_ptr_group
+};
+
+/////////////////////////////////////////////////////////////////
+struct retired_ptr {
+	void*                            p_;         //!< retired pointer
+	hazard_ptr_mgr::retire_deleter_t deleter_;   //!< deleter of p_
+};
+
+/**
+ * @brief array of retired_ptr that allocates its buffer by gmem_allocate()
+ *
+ * This does not throw any exception. If the buffer could not be extended, push_back() and append() return false.
+ */
+class retired_ptr_array {
+public:
+	constexpr retired_ptr_array( void ) noexcept
+	  : p_buff_( nullptr )
+	  , size_( 0 )
+	  , capacity_( 0 )
+	{
+	}
+	~retired_ptr_array();
+
+	retired_ptr_array( const retired_ptr_array& )            = delete;
+	retired_ptr_array( retired_ptr_array&& )                 = delete;
+	retired_ptr_array& operator=( const retired_ptr_array& ) = delete;
+	retired_ptr_array& operator=( retired_ptr_array&& )      = delete;
+
+	bool push_back( const retired_ptr& e ) noexcept;
+	bool append( const retired_ptr_array& src ) noexcept;
+
+	/**
+	 * @brief remove the elements in [idx_first, idx_last)
+	 */
+	void erase( size_t idx_first, size_t idx_last ) noexcept;
+
+	void clear( void ) noexcept
+	{
+		size_ = 0;
+	}
+	bool empty( void ) const noexcept
+	{
+		return size_ == 0;
+	}
+	size_t size( void ) const noexcept
+	{
+		return size_;
+	}
+	retired_ptr& operator[]( size_t idx ) noexcept
+	{
+		return p_buff_[idx];
+	}
+	retired_ptr* begin( void ) noexcept
+	{
+		return p_buff_;
+	}
+	retired_ptr* end( void ) noexcept
+	{
+		return p_buff_ + size_;
+	}
+
+private:
+	bool reserve( size_t new_capacity ) noexcept;
+
+	retired_ptr* p_buff_;
+	size_t       size_;
+	size_t       capacity_;
+};
+
+/**
+ * @brief thread local list of retired pointers for hazard_ptr_mgr::Retire()
+ *
+ * The lists are allocated by gmem_allocate(), and every member function does not throw any exception.
+ */
+class retired_ptr_list {
+public:
+	retired_ptr_list( void ) = default;
+	~retired_ptr_list();
+
+	/**
+	 * @brief add p to this list
+	 *
+	 * If this list could not be extended, this waits for p to become not hazard pointer, and calls deleter( p ) synchronously.
+	 */
+	void push( void* p, hazard_ptr_mgr::retire_deleter_t deleter ) noexcept;
+
+	/**
+	 * @brief call deleter for the retired pointers that are not hazard pointer
+	 *
+	 * @return size_t the number of retired pointers that are still hazard pointer
+	 */
+	size_t reclaim( void ) noexcept;
+
+	/**
+	 * @brief move the retired pointers that are left by exited threads to this list
+	 *
+	 * If this list could not be extended, the retired pointers are left in the global list.
+	 *
+	 * @param is_try_lock true: if the global list is locked by other thread, give up to adopt.
+	 */
+	void adopt_orphans( bool is_try_lock ) noexcept;
+
+	/**
+	 * @brief lock the global list of the orphan retired pointers before fork()
+	 */
+	static void lock_orphan_for_fork( void ) noexcept
+	{
+		orphan_mtx_.lock();
+	}
+
+	/**
+	 * @brief unlock the global list of the orphan retired pointers after fork()
+	 */
+	static void unlock_orphan_for_fork( void ) noexcept
+	{
+		orphan_mtx_.unlock();
+	}
+
+private:
+	size_t calc_threshold( void ) const noexcept;
+
+	static void reclaim_synchronously( const retired_ptr& e ) noexcept;
+
+	static constexpr size_t kMinThreshold = 64;
+
+	retired_ptr_array retired_;
+	bool              is_reclaiming_ = false;   //!< true: in reclaim(). this is to avoid recursive reclaim() from deleter
+
+	static std::mutex        orphan_mtx_;
+	static retired_ptr_array orphan_retired_;   //!< retired pointers that are left by exited threads
 };
 
+/**
+ * @brief lock the global list of the orphan retired pointers of epoch based reclamation before fork()
+ *
+ * This is defined in ebr_domain.cpp.
+ */
+void ebr_lock_orphan_for_fork( void ) noexcept;
+
+/**
+ * @brief unlock the global list of the orphan retired pointers of epoch based reclamation after fork()
+ *
+ * This is defined in ebr_domain.cpp.
+ */
+void ebr_unlock_orphan_for_fork( void ) noexcept;
+
+/**
+ * @brief release the records of epoch based reclamation that are owned by the threads that do not exist in the child process after fork()
+ *
+ * The records of the other threads may be left in critical section, and they block the advance of the global epoch.
+ * The retired pointers of those records are abandoned without calling their deleter.
+ * This is defined in ebr_domain.cpp.
+ */
+void ebr_release_other_thread_records_in_child( void ) noexcept;
+
 }   // namespace internal
 }   // namespace concurrent
 }   // namespace alpha
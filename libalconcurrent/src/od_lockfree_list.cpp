@@ -86,9 +86,10 @@ std::pair<od_lockfree_list::hazard_pointer_w_mark, od_lockfree_list::hazard_poin
 	node_pointer      p_sentinel_node   //!< [in] 終端として判定するノード
 )
 {
-	hazard_pointer_w_mark hp_prev_node_w_m;
-	hazard_pointer_w_mark hp_curr_node_w_m;
-	hazard_pointer_w_mark hp_next_node_w_m;
+	hazard_slot_set<3>    hss;   // prev/curr/nextの3つのスロットをまとめて確保する
+	hazard_pointer_w_mark hp_prev_node_w_m( hss );
+	hazard_pointer_w_mark hp_curr_node_w_m( hss );
+	hazard_pointer_w_mark hp_next_node_w_m( hss );
 	while ( true ) {   // 先頭からやり直すためのループ
 		hp_prev_node_w_m.mark_ = false;
 		hp_prev_node_w_m.hp_.store( &head_ );
@@ -141,9 +142,10 @@ std::pair<od_lockfree_list::hazard_const_pointer_w_mark, od_lockfree_list::hazar
 	const_node_pointer p_sentinel_node   //!< [in] 終端として判定するノード
 ) const
 {
-	hazard_const_pointer_w_mark hp_prev_node_w_m;
-	hazard_const_pointer_w_mark hp_curr_node_w_m;
-	hazard_const_pointer_w_mark hp_next_node_w_m;
+	hazard_slot_set<3>          hss;   // prev/curr/nextの3つのスロットをまとめて確保する
+	hazard_const_pointer_w_mark hp_prev_node_w_m( hss );
+	hazard_const_pointer_w_mark hp_curr_node_w_m( hss );
+	hazard_const_pointer_w_mark hp_next_node_w_m( hss );
 	while ( true ) {   // 先頭からやり直すためのループ
 		hp_prev_node_w_m.mark_ = false;
 		hp_prev_node_w_m.hp_.store( &head_ );
@@ -254,9 +256,10 @@ void od_lockfree_list::for_each(
 	for_each_func_t& f   //!< [in]	A function f is passed value_type& as an argument
 )
 {
-	hazard_pointer_w_mark hp_prev_node_w_m;
-	hazard_pointer_w_mark hp_curr_node_w_m;
-	hazard_pointer_w_mark hp_next_node_w_m;
+	hazard_slot_set<3>    hss;   // prev/curr/nextの3つのスロットをまとめて確保する
+	hazard_pointer_w_mark hp_prev_node_w_m( hss );
+	hazard_pointer_w_mark hp_curr_node_w_m( hss );
+	hazard_pointer_w_mark hp_next_node_w_m( hss );
 
 	hp_prev_node_w_m.mark_ = false;
 	hp_prev_node_w_m.hp_.store( &head_ );
@@ -304,9 +307,10 @@ void od_lockfree_list::for_each(
 	for_each_const_func_t& f   //!< [in]	A function f is passed value_type& as an argument
 ) const
 {
-	hazard_const_pointer_w_mark hp_prev_node_w_m;
-	hazard_const_pointer_w_mark hp_curr_node_w_m;
-	hazard_const_pointer_w_mark hp_next_node_w_m;
+	hazard_slot_set<3>          hss;   // prev/curr/nextの3つのスロットをまとめて確保する
+	hazard_const_pointer_w_mark hp_prev_node_w_m( hss );
+	hazard_const_pointer_w_mark hp_curr_node_w_m( hss );
+	hazard_const_pointer_w_mark hp_next_node_w_m( hss );
 
 	hp_prev_node_w_m.mark_ = false;
 	hp_prev_node_w_m.hp_.store( &head_ );
@@ -550,9 +554,10 @@ std::pair<od_lockfree_list::hazard_pointer_w_mark, od_lockfree_list::hazard_poin
 )
 {
 	dummy_head_.hazard_handler_of_next().store( p_head_node, false );
-	hazard_pointer_w_mark hp_prev_node_w_m;
-	hazard_pointer_w_mark hp_curr_node_w_m;
-	hazard_pointer_w_mark hp_next_node_w_m;
+	hazard_slot_set<3>    hss;   // prev/curr/nextの3つのスロットをまとめて確保する
+	hazard_pointer_w_mark hp_prev_node_w_m( hss );
+	hazard_pointer_w_mark hp_curr_node_w_m( hss );
+	hazard_pointer_w_mark hp_next_node_w_m( hss );
 	while ( true ) {   // 先頭からやり直すためのループ
 		hp_prev_node_w_m.mark_ = false;
 		hp_prev_node_w_m.hp_.store( &dummy_head_ );
@@ -622,6 +627,12 @@ size_t od_lockfree_list::count_size( void ) const noexcept
 	return count;
 }
 
+bool od_lockfree_list::is_empty( void ) const
+{
+	auto head_hp_pair = find_head();
+	return ( head_hp_pair.second.hp_.get() == &sentinel_ );
+}
+
 bool od_lockfree_list::try_to_purge(
 	const hazard_ptr_handler_t::hazard_pointer_w_mark& prev_hp_w_m,   //!< [in] 削除するノードよりひとつ前のノードへのハザードポインタ
 	hazard_ptr_handler_t::hazard_pointer_w_mark&       curr_hp_w_m,   //!< [in/out]	削除するノードへのハザードポインタ。戻り値がtrueの場合、呼び出し前の状態を維持している。falseの場合、値が変わっている。
@@ -10,6 +10,7 @@
  */
 
 #include <memory>
+#include <thread>
 
 #include "alconcurrent/internal/od_node_essence.hpp"
 #include "alconcurrent/internal/od_simple_list.hpp"
@@ -141,7 +142,7 @@ void od_simple_list::merge_push_front( node_pointer p_nd ) noexcept
 {
 	if ( p_nd == nullptr ) return;
 
-	size_t       tmp_cnt = 0;
+	size_t       tmp_cnt = 1;
 	node_pointer p_cur   = p_nd;
 	node_pointer p_nxt   = p_cur->next();
 	while ( p_nxt != nullptr ) {
@@ -173,7 +174,7 @@ void od_simple_list::merge_push_back( node_pointer p_nd ) noexcept
 {
 	if ( p_nd == nullptr ) return;
 
-	size_t       tmp_cnt = 0;
+	size_t       tmp_cnt = 1;
 	node_pointer p_cur   = p_nd;
 	node_pointer p_nxt   = p_cur->next();
 	while ( p_nxt != nullptr ) {
@@ -311,6 +312,81 @@ void od_simple_list::merge_push_back( node_pointer p_nd_head, node_pointer p_nd_
 	}
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+od_simple_list_detachable::~od_simple_list_detachable()
+{
+	od_simple_list tmp = detach_all();
+}
+
+void od_simple_list_detachable::merge_push_front( od_simple_list&& src ) noexcept
+{
+	if ( src.p_head_ == nullptr ) return;
+
+	node_pointer p_src_head = src.p_head_;
+	node_pointer p_src_tail = src.p_tail_;
+	size_t       tmp_cnt    = src.count_;
+	src.count_              = 0;
+	src.p_head_             = nullptr;
+	src.p_tail_             = nullptr;
+
+	// p_src_tailのnextは、CAS成功によって公開されるまで他スレッドから参照されない。
+	count_.fetch_add( tmp_cnt, std::memory_order_acq_rel );
+	node_pointer p_cur_head = ap_head_.load( std::memory_order_relaxed );
+	do {
+		p_src_tail->set_next( p_cur_head );
+	} while ( !ap_head_.compare_exchange_weak( p_cur_head, p_src_head, std::memory_order_release, std::memory_order_relaxed ) );
+}
+
+od_simple_list od_simple_list_detachable::detach_all( void ) noexcept
+{
+	od_simple_list ans;
+
+	// begin_detach()での公開を、空になったリストを読んだスレッドから観測できるように、acq_relとする。
+	node_pointer p_cur = ap_head_.exchange( nullptr, std::memory_order_acq_rel );
+	if ( p_cur == nullptr ) return ans;
+
+	size_t       tmp_cnt = 1;
+	node_pointer p_head  = p_cur;
+	node_pointer p_nxt   = p_cur->next();
+	while ( p_nxt != nullptr ) {
+		p_cur = p_nxt;
+		p_nxt = p_cur->next();
+		tmp_cnt++;
+	}
+	ans.p_head_ = p_head;
+	ans.p_tail_ = p_cur;
+	ans.count_  = tmp_cnt;
+
+	count_.fetch_sub( tmp_cnt, std::memory_order_acq_rel );
+	return ans;
+}
+
+od_simple_list od_simple_list_detachable::begin_detach( void ) noexcept
+{
+	// 切り離しより先に、切り離し中であることを公開する。
+	detach_begin_count_.fetch_add( 1, std::memory_order_seq_cst );
+	return detach_all();
+}
+
+void od_simple_list_detachable::end_detach( void ) noexcept
+{
+	detach_end_count_.fetch_add( 1, std::memory_order_seq_cst );
+}
+
+bool od_simple_list_detachable::wait_for_detaching_by_others( void ) const noexcept
+{
+	size_t begin_cnt = detach_begin_count_.load( std::memory_order_seq_cst );
+	if ( detach_end_count_.load( std::memory_order_seq_cst ) >= begin_cnt ) {
+		return false;
+	}
+
+	// 切り離したノードを検査する処理は、有限時間で完了する。
+	while ( detach_end_count_.load( std::memory_order_seq_cst ) < begin_cnt ) {
+		std::this_thread::yield();
+	}
+	return true;
+}
+
 }   // namespace internal
 }   // namespace concurrent
 }   // namespace alpha
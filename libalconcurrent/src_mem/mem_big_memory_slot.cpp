@@ -9,8 +9,13 @@
  *
  */
 
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD
+#include <sys/mman.h>
+#endif
+
 #include "mem_big_memory_slot.hpp"
 #include "mem_allocated_mem_top.hpp"
+#include "mem_numa_node.hpp"
 #include "mmap_allocator.hpp"
 
 namespace alpha {
@@ -60,6 +65,7 @@ big_memory_slot* big_memory_slot_list::reuse_allocate( size_t requested_allocata
 	}
 
 	if ( p_ans != nullptr ) {
+		unpoison_memory_region_for_debug( p_ans->data_, p_ans->max_allocatable_size() );
 		unused_retrieved_memory_bytes_.fetch_sub( p_ans->buffer_size_, std::memory_order_release );
 		bool old_is_used = p_ans->link_to_big_memory_slot_.fetch_set( true );
 		if ( old_is_used ) {
@@ -125,9 +131,17 @@ bool big_memory_slot_list::deallocate( big_memory_slot* p ) noexcept
 			p->btinfo_.free_trace_ = bt_info::record_backtrace();
 #endif
 			unused_retrieved_memory_bytes_.fetch_add( p->buffer_size_, std::memory_order_release );
+			// p_temprary_link_next_ is used by retrieved_big_slots_array_mgr, therefore it is excluded from poisoning
+			poison_memory_region_for_debug( p->data_ + sizeof( big_memory_slot* ), p->max_allocatable_size() - sizeof( big_memory_slot* ) );
 			retrieved_big_slots_array_mgr::retrieve( slot_array_idx_, p );
 		}
 	} else if ( slot_info.mt_ == mem_type::OVER_BIG_MEM ) {
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+		if ( is_guard_page_mode_ ) {
+			quarantine_guard_page_slot( p );
+			return true;
+		}
+#endif
 		deallocate_by_munmap( p, p->buffer_size_ );
 	} else {
 		LogOutput( log_type::WARN, "big_memory_slot_list::deallocate() is called with unknown mem_type %u", static_cast<unsigned int>( slot_info.mt_ ) );
@@ -143,10 +157,40 @@ big_memory_slot* big_memory_slot_list::allocate_newly( size_t requested_allocata
 	if ( buffer_ret.p_allocated_addr_ == nullptr ) {
 		return nullptr;
 	}
+	bind_memory_to_numa_node( buffer_ret.p_allocated_addr_, buffer_ret.allocated_size_, numa_node_idx_ );
 
 	big_memory_slot* p_ans = big_memory_slot::emplace_on_mem( buffer_ret.p_allocated_addr_,
 	                                                          ( buffer_ret.allocated_size_ < too_big_memory_slot_buffer_size_threshold_ ) ? mem_type::BIG_MEM : mem_type::OVER_BIG_MEM,
-	                                                          buffer_ret.allocated_size_ );
+	                                                          buffer_ret.allocated_size_,
+	                                                          this );
+
+#ifdef ALCONCURRENT_CONF_ENABLE_RECORD_BACKTRACE_CHECK_DOUBLE_FREE
+	p_ans->btinfo_.alloc_trace_ = bt_info::record_backtrace();
+	p_ans->btinfo_.free_trace_.invalidate();
+#endif
+
+	return p_ans;
+}
+
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+big_memory_slot* big_memory_slot_list::allocate_with_guard_page( size_t requested_allocatable_size ) noexcept
+{
+	// レイアウト: [big_memory_slot header ... data ...][guard page(PROT_NONE)]
+	// ヘッダが解放後もアクセス可能であるように、データ部の大きさに1ページを追加する。
+	const size_t gmem_debug_guard_page_size = get_gmem_debug_guard_page_size();
+	size_t       buffer_size = big_memory_slot::calc_minimum_buffer_size( requested_allocatable_size ) + gmem_debug_guard_page_size;
+	buffer_size                             = ( buffer_size + ( gmem_debug_guard_page_size - 1 ) ) & ( ~( gmem_debug_guard_page_size - 1 ) );
+
+	auto buffer_ret = allocate_by_mmap( buffer_size + gmem_debug_guard_page_size, gmem_debug_guard_page_size );
+	if ( buffer_ret.p_allocated_addr_ == nullptr ) {
+		return nullptr;
+	}
+	unsigned char* p_guard_page = reinterpret_cast<unsigned char*>( buffer_ret.p_allocated_addr_ ) + buffer_size;
+	if ( mprotect( p_guard_page, gmem_debug_guard_page_size, PROT_NONE ) != 0 ) {
+		LogOutput( log_type::WARN, "big_memory_slot_list::allocate_with_guard_page() fail to mprotect guard page" );
+	}
+
+	big_memory_slot* p_ans = big_memory_slot::emplace_on_mem( buffer_ret.p_allocated_addr_, mem_type::OVER_BIG_MEM, buffer_size, this );
 
 #ifdef ALCONCURRENT_CONF_ENABLE_RECORD_BACKTRACE_CHECK_DOUBLE_FREE
 	p_ans->btinfo_.alloc_trace_ = bt_info::record_backtrace();
@@ -156,11 +200,36 @@ big_memory_slot* big_memory_slot_list::allocate_newly( size_t requested_allocata
 	return p_ans;
 }
 
+void big_memory_slot_list::quarantine_guard_page_slot( big_memory_slot* p ) noexcept
+{
+#ifdef ALCONCURRENT_CONF_ENABLE_RECORD_BACKTRACE_CHECK_DOUBLE_FREE
+	p->btinfo_.free_trace_ = bt_info::record_backtrace();
+#endif
+	// ヘッダを含むページ以外のデータ部をアクセス不可にし、use-after-freeを検出する。
+	const size_t gmem_debug_guard_page_size = get_gmem_debug_guard_page_size();
+	uintptr_t    protect_top                = reinterpret_cast<uintptr_t>( p->data_ );
+	protect_top                             = ( protect_top + ( gmem_debug_guard_page_size - 1 ) ) & ( ~( gmem_debug_guard_page_size - 1 ) );
+	uintptr_t    protect_end                = reinterpret_cast<uintptr_t>( p ) + p->buffer_size_;
+	if ( protect_top < protect_end ) {
+		if ( mprotect( reinterpret_cast<void*>( protect_top ), protect_end - protect_top, PROT_NONE ) != 0 ) {
+			LogOutput( log_type::WARN, "big_memory_slot_list::quarantine_guard_page_slot() fail to mprotect released slot" );
+		}
+	}
+
+	size_t           idx     = guard_quarantine_idx_.fetch_add( 1, std::memory_order_acq_rel ) % gmem_debug_guard_quarantine_size;
+	big_memory_slot* p_evict = guard_quarantine_[idx].exchange( p, std::memory_order_acq_rel );
+	if ( p_evict != nullptr ) {
+		deallocate_by_munmap( p_evict, p_evict->buffer_size_ + gmem_debug_guard_page_size );
+	}
+}
+#endif
+
 void big_memory_slot_list::clear_for_test( void ) noexcept
 {
 	big_memory_slot* p_ans = nullptr;
 	p_ans                  = retrieved_big_slots_array_mgr::request_reuse( slot_array_idx_ );
 	while ( p_ans != nullptr ) {
+		unpoison_memory_region_for_debug( p_ans, p_ans->buffer_size_ );
 		deallocate_by_munmap( p_ans, p_ans->buffer_size_ );
 		p_ans = retrieved_big_slots_array_mgr::request_reuse( slot_array_idx_ );
 	}
@@ -23,6 +23,7 @@
 
 #include "alconcurrent/internal/cpp_std_configure.hpp"
 #include "mem_allocated_mem_top.hpp"
+#include "mem_debug_guard.hpp"
 #include "mem_retrieved_slot_array_mgr.hpp"
 
 #ifdef ALCONCURRENT_CONF_ENABLE_CHECK_LOGIC_ERROR
@@ -33,6 +34,8 @@ namespace alpha {
 namespace concurrent {
 namespace internal {
 
+struct big_memory_slot_list;
+
 /**
  * @brief big memory slot
  *
@@ -40,6 +43,7 @@ namespace internal {
 struct big_memory_slot {
 	const uintptr_t               magic_number_;   //!< magic number that indicates big_memory_slot
 	const size_t                  buffer_size_;    //!< size of buffer
+	big_memory_slot_list* const   p_list_mgr_;     //!< pointer to big_memory_slot_list that this slot belongs to
 	std::atomic<big_memory_slot*> ap_slot_next_;   //!< pointer to next big_memory_slot
 #ifdef ALCONCURRENT_CONF_ENABLE_RECORD_BACKTRACE_CHECK_DOUBLE_FREE
 	btinfo_alloc_free btinfo_;   //!< back trace information
@@ -52,9 +56,9 @@ struct big_memory_slot {
 
 	static constexpr uintptr_t magic_number_value_ = 0x3434ABAB7878CDCDUL;
 
-	static constexpr big_memory_slot* emplace_on_mem( void* p_mem, mem_type mt_arg, size_t buffer_size ) noexcept
+	static constexpr big_memory_slot* emplace_on_mem( void* p_mem, mem_type mt_arg, size_t buffer_size, big_memory_slot_list* p_list_mgr_arg = nullptr ) noexcept
 	{
-		return new ( p_mem ) big_memory_slot( mt_arg, buffer_size );
+		return new ( p_mem ) big_memory_slot( mt_arg, buffer_size, p_list_mgr_arg );
 	}
 
 	big_memory_slot* check_validity_to_owner_and_get( void ) const noexcept;
@@ -90,15 +94,45 @@ struct big_memory_slot {
 		return allocated_mem_top::emplace_on_mem( reinterpret_cast<unsigned char*>( addr ), link_to_big_memory_slot_ );
 	}
 
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+	/**
+	 * @brief Get the allocated mem top object that is placed so that the end of allocated memory is close to the end of buffer
+	 *
+	 * This is used for the slot that is followed by guard page to detect buffer overrun.
+	 *
+	 * @param align_bytes alignment bytes. This value should be power of 2.
+	 * @return allocated_mem_top*
+	 */
+	allocated_mem_top* get_tail_aligned_allocated_mem_top( size_t align_bytes, size_t requested_allocation_size ) noexcept
+	{
+#ifdef ALCONCURRENT_CONF_ENABLE_CHECK_LOGIC_ERROR
+		if ( !is_power_of_2( align_bytes ) ) {
+			std::terminate();
+		}
+#endif
+		uintptr_t end_addr = reinterpret_cast<uintptr_t>( this ) + buffer_size_;
+		uintptr_t addr     = ( end_addr - requested_allocation_size ) & ( ~( align_bytes - 1 ) );
+		addr -= sizeof( allocated_mem_top );
+		if ( addr < reinterpret_cast<uintptr_t>( &link_to_big_memory_slot_ ) ) {
+			return get_aligned_allocated_mem_top( align_bytes, requested_allocation_size );
+		}
+		if ( addr == reinterpret_cast<uintptr_t>( &link_to_big_memory_slot_ ) ) {
+			return &link_to_big_memory_slot_;
+		}
+		return allocated_mem_top::emplace_on_mem( reinterpret_cast<unsigned char*>( addr ), link_to_big_memory_slot_ );
+	}
+#endif
+
 	static constexpr size_t calc_minimum_buffer_size( size_t requested_allocatable_size ) noexcept
 	{
 		return requested_allocatable_size + ( sizeof( big_memory_slot ) - sizeof( big_memory_slot* ) ) + 1;
 	}
 
 private:
-	constexpr big_memory_slot( mem_type mt_arg, size_t buffer_size ) noexcept
+	constexpr big_memory_slot( mem_type mt_arg, size_t buffer_size, big_memory_slot_list* p_list_mgr_arg ) noexcept
 	  : magic_number_( magic_number_value_ )
 	  , buffer_size_( buffer_size )
+	  , p_list_mgr_( p_list_mgr_arg )
 	  , ap_slot_next_( nullptr )
 #ifdef ALCONCURRENT_CONF_ENABLE_RECORD_BACKTRACE_CHECK_DOUBLE_FREE
 	  , btinfo_ {}
@@ -126,15 +160,29 @@ using retrieved_big_slots_array_mgr = retrieved_slots_stack_array_mgr<big_memory
  */
 struct big_memory_slot_list {
 	std::atomic<size_t> unused_retrieved_memory_bytes_;   //!< count of slots in hazard
+	const size_t        slot_array_idx_;                  //!< index of retrieved_big_slots_array_mgr
+	const size_t        numa_node_idx_;                   //!< index of NUMA node that big_memory_slot belongs to
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+	const bool                    is_guard_page_mode_;                                     //!< true: slots are followed by guard page and are quarantined after free
+	std::atomic<size_t>           guard_quarantine_idx_;                                   //!< next index of guard_quarantine_
+	std::atomic<big_memory_slot*> guard_quarantine_[gmem_debug_guard_quarantine_size];   //!< freed slots that are kept inaccessible
+#endif
 
 	static constexpr size_t defualt_limit_bytes_of_unused_retrieved_memory_ = 1024 * 1024 * 4;   // 4MB
 	static size_t           limit_bytes_of_unused_retrieved_memory_;                             //!< limit bytes of unused retrieved memory for cache
 	static size_t           too_big_memory_slot_buffer_size_threshold_;                          //!< threshold of buffer size to be too big memory slot
-	static constexpr size_t slot_array_idx_ = 0;
 
-	constexpr big_memory_slot_list( void ) noexcept
+	constexpr big_memory_slot_list( const size_t slot_array_idx_arg = 0, const size_t numa_node_idx_arg = 0, const bool is_guard_page_mode_arg = false ) noexcept
 	  : unused_retrieved_memory_bytes_( 0 )
+	  , slot_array_idx_( slot_array_idx_arg )
+	  , numa_node_idx_( numa_node_idx_arg )
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+	  , is_guard_page_mode_( is_guard_page_mode_arg )
+	  , guard_quarantine_idx_( 0 )
+	  , guard_quarantine_ {}
+#endif
 	{
+		static_cast<void>( is_guard_page_mode_arg );
 	}
 
 	big_memory_slot* reuse_allocate( size_t requested_allocatable_size ) noexcept;
@@ -146,11 +194,26 @@ struct big_memory_slot_list {
 	 */
 	big_memory_slot* allocate_newly( size_t requested_allocatable_size ) noexcept;
 
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+	/**
+	 * @brief allocate a big_memory_slot that is followed by PROT_NONE guard page
+	 *
+	 * This slot is released by deallocate() of the list that is constructed with is_guard_page_mode_arg = true.
+	 * After release, the data area of the slot becomes PROT_NONE and is kept in quarantine until gmem_debug_guard_quarantine_size slots are released after that.
+	 */
+	big_memory_slot* allocate_with_guard_page( size_t requested_allocatable_size ) noexcept;
+#endif
+
 	/**
 	 * @brief free all memory_slot_group
 	 *
 	 */
 	void clear_for_test( void ) noexcept;
+
+private:
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+	void quarantine_guard_page_slot( big_memory_slot* p ) noexcept;
+#endif
 };
 static_assert( std::is_trivially_destructible<big_memory_slot_list>::value );
 
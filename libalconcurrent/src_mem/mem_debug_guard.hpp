@@ -0,0 +1,100 @@
+/**
+ * @file mem_debug_guard.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief configuration and AddressSanitizer annotation for debug guard mode of gmem
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#ifndef ALCONCCURRENT_SRC_MEM_DEBUG_GUARD_HPP_
+#define ALCONCCURRENT_SRC_MEM_DEBUG_GUARD_HPP_
+
+#include <cstddef>
+
+#include <unistd.h>
+
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD
+
+#ifndef ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_SAMPLING_INTERVAL
+#define ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_SAMPLING_INTERVAL 1000
+#endif
+#ifndef ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_QUARANTINE_SIZE
+#define ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_QUARANTINE_SIZE 64
+#endif
+
+#ifndef ALCONCURRENT_CONF_ENABLE_MALLOC_INSTEAD_OF_MMAP
+// malloc() does not return page aligned memory. therefore guard page is applicable only for mmap
+#define ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+#endif
+
+#if defined( __SANITIZE_ADDRESS__ )
+#define ALCC_INTERNAL_GMEM_ENABLE_ASAN_POISONING
+#elif defined( __has_feature )
+#if __has_feature( address_sanitizer )
+#define ALCC_INTERNAL_GMEM_ENABLE_ASAN_POISONING
+#endif
+#endif
+
+#endif
+
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_ASAN_POISONING
+#include <sanitizer/asan_interface.h>
+#endif
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD
+constexpr size_t gmem_debug_guard_sampling_interval = ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_SAMPLING_INTERVAL;   //!< 1 of this number allocations is placed on guard page
+constexpr size_t gmem_debug_guard_quarantine_size   = ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_QUARANTINE_SIZE;     //!< number of freed guard page allocations that keeps inaccessible
+static_assert( gmem_debug_guard_sampling_interval >= 1, "ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_SAMPLING_INTERVAL should be 1 or more" );
+static_assert( gmem_debug_guard_quarantine_size >= 1, "ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_QUARANTINE_SIZE should be 1 or more" );
+
+/**
+ * @brief get the page size that is used for guard page and mprotect()
+ *
+ * mprotect() requires the page size of the system. Therefore, this reads it by sysconf() instead of a fixed value.
+ */
+inline size_t get_gmem_debug_guard_page_size( void ) noexcept
+{
+	static const size_t guard_page_size = []() -> size_t {
+		long ret = sysconf( _SC_PAGESIZE );
+		return ( ret > 0 ) ? static_cast<size_t>( ret ) : 4096;
+	}();
+	return guard_page_size;
+}
+#endif
+
+/**
+ * @brief mark the memory region as inaccessible for AddressSanitizer
+ *
+ * If ALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD is not defined or the compilation does not enable AddressSanitizer, this does nothing.
+ */
+inline void poison_memory_region_for_debug( const void* p, size_t bytes ) noexcept
+{
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_ASAN_POISONING
+	ASAN_POISON_MEMORY_REGION( p, bytes );
+#endif
+}
+
+/**
+ * @brief mark the memory region as accessible for AddressSanitizer
+ *
+ * If ALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD is not defined or the compilation does not enable AddressSanitizer, this does nothing.
+ */
+inline void unpoison_memory_region_for_debug( const void* p, size_t bytes ) noexcept
+{
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_ASAN_POISONING
+	ASAN_UNPOISON_MEMORY_REGION( p, bytes );
+#endif
+}
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
@@ -10,11 +10,14 @@
  */
 
 #include <stdexcept>
+#include <utility>
 
 #include "alconcurrent/conf_logger.hpp"
 #include "alconcurrent/lf_mem_alloc.hpp"
 
 #include "mem_big_memory_slot.hpp"
+#include "mem_debug_guard.hpp"
+#include "mem_numa_node.hpp"
 #include "mem_retrieved_slot_array_mgr.hpp"
 #include "mem_small_memory_slot.hpp"
 #include "mmap_allocator.hpp"
@@ -22,138 +25,217 @@
 namespace alpha {
 namespace concurrent {
 
-internal::memory_slot_group_list g_memory_slot_group_list_array[] = {
-	{ 8, 4096, 1048576, 0 },
-	{ 16, 4096, 1048576, 1 },
-	{ 24, 4096, 1048576, 2 },
-	{ 32, 4096, 1048576, 3 },
-	{ 40, 8192, 1048576, 4 },
-	{ 48, 8192, 1048576, 5 },
-	{ 56, 8192, 1048576, 6 },
-	{ 64, 12288, 1048576, 7 },
-	{ 72, 12288, 1048576, 8 },
-	{ 80, 12288, 1048576, 9 },
-	{ 88, 12288, 1048576, 10 },
-	{ 96, 16384, 1048576, 11 },
-	{ 104, 16384, 1048576, 12 },
-	{ 112, 16384, 1048576, 13 },
-	{ 120, 16384, 1048576, 14 },
-	{ 128, 20480, 1048576, 15 },
-	{ 136, 20480, 1048576, 16 },
-	{ 144, 20480, 1048576, 17 },
-	{ 152, 20480, 1048576, 18 },
-	{ 160, 24576, 1048576, 19 },
-	{ 168, 24576, 1048576, 20 },
-	{ 176, 24576, 1048576, 21 },
-	{ 184, 24576, 1048576, 22 },
-	{ 192, 28672, 1048576, 23 },
-	{ 200, 28672, 1048576, 24 },
-	{ 208, 28672, 1048576, 25 },
-	{ 216, 28672, 1048576, 26 },
-	{ 224, 32768, 1048576, 27 },
-	{ 232, 32768, 1048576, 28 },
-	{ 240, 32768, 1048576, 29 },
-	{ 248, 32768, 1048576, 30 },
-	{ 256, 36864, 1048576, 31 },
-	{ 264, 36864, 1048576, 32 },
-	{ 272, 36864, 1048576, 33 },
-	{ 280, 36864, 1048576, 34 },
-	{ 288, 40960, 1048576, 35 },
-	{ 296, 40960, 1048576, 36 },
-	{ 304, 40960, 1048576, 37 },
-	{ 312, 40960, 1048576, 38 },
-	{ 320, 45056, 1048576, 39 },
-	{ 328, 45056, 1048576, 40 },
-	{ 336, 45056, 1048576, 41 },
-	{ 344, 45056, 1048576, 42 },
-	{ 352, 49152, 1048576, 43 },
-	{ 360, 49152, 1048576, 44 },
-	{ 368, 49152, 1048576, 45 },
-	{ 376, 49152, 1048576, 46 },
-	{ 384, 53248, 1048576, 47 },
-	{ 392, 53248, 1048576, 48 },
-	{ 400, 53248, 1048576, 49 },
-	{ 408, 53248, 1048576, 50 },
-	{ 416, 57344, 1048576, 51 },
-	{ 424, 57344, 1048576, 52 },
-	{ 432, 57344, 1048576, 53 },
-	{ 440, 57344, 1048576, 54 },
-	{ 448, 61440, 1048576, 55 },
-	{ 456, 61440, 1048576, 56 },
-	{ 464, 61440, 1048576, 57 },
-	{ 472, 61440, 1048576, 58 },
-	{ 480, 65536, 1048576, 59 },
-	{ 488, 65536, 1048576, 60 },
-	{ 496, 65536, 1048576, 61 },
-	{ 504, 65536, 1048576, 62 },
-	{ 512, 65536, 1048576, 63 },
-	{ 576, 65536, 2097152, 64 },
-	{ 640, 65536, 2097152, 65 },
-	{ 704, 65536, 2097152, 66 },
-	{ 768, 65536, 2097152, 67 },
-	{ 832, 65536, 2097152, 68 },
-	{ 896, 65536, 2097152, 69 },
-	{ 960, 65536, 2097152, 70 },
-	{ 1024, 65536, 4194304, 71 },
-	{ 1152, 77824, 4194304, 72 },
-	{ 1280, 86016, 4194304, 73 },
-	{ 1408, 94208, 4194304, 74 },
-	{ 1536, 102400, 4194304, 75 },
-	{ 1664, 110592, 4194304, 76 },
-	{ 1792, 118784, 4194304, 77 },
-	{ 1920, 126976, 4194304, 78 },
-	{ 2048, 135168, 4194304, 79 },
-	{ 2304, 151552, 4194304, 80 },
-	{ 2560, 167936, 4194304, 81 },
-	{ 2816, 184320, 4194304, 82 },
-	{ 3072, 200704, 4194304, 83 },
-	{ 3328, 217088, 4194304, 84 },
-	{ 3584, 233472, 4194304, 85 },
-	{ 3840, 249856, 4194304, 86 },
-	{ 4096, 266240, 4194304, 87 },
-	{ 4608, 299008, 4194304, 88 },
-	{ 5120, 331776, 4194304, 89 },
-	{ 5632, 364544, 4194304, 90 },
-	{ 6144, 397312, 4194304, 91 },
-	{ 6656, 430080, 4194304, 92 },
-	{ 7168, 462848, 4194304, 93 },
-	{ 7680, 495616, 4194304, 94 },
-	{ 8192, 528384, 4194304, 95 },
-	{ 9216, 528384, 4194304, 96 },
-	{ 10240, 528384, 4194304, 97 },
-	{ 11264, 528384, 4194304, 98 },
-	{ 12288, 528384, 4194304, 99 },
-	{ 13312, 528384, 4194304, 100 },
-	{ 14336, 528384, 4194304, 101 },
-	{ 15360, 528384, 4194304, 102 },
-	{ 16384, 528384, 4194304, 103 },
-	{ 18432, 593920, 4194304, 104 },
-	{ 20480, 659456, 4194304, 105 },
-	{ 22528, 724992, 4194304, 106 },
-	{ 24576, 790528, 4194304, 107 },
-	{ 26624, 856064, 4194304, 108 },
-	{ 28672, 921600, 4194304, 109 },
-	{ 30720, 987136, 4194304, 110 },
-	{ 32768, 1052672, 4194304, 111 },
-	{ 36864, 1052672, 4194304, 112 },
-	{ 40960, 1052672, 4194304, 113 },
-	{ 45056, 1052672, 4194304, 114 },
-	{ 49152, 1052672, 4194304, 115 },
-	{ 53248, 1052672, 4194304, 116 },
-	{ 57344, 1052672, 4194304, 117 },
-	{ 61440, 1052672, 4194304, 118 },
-	{ 65536, 1052672, 4194304, 119 },
-	{ 73728, 1052672, 4194304, 120 },
-	{ 81920, 1052672, 4194304, 121 },
-	{ 90112, 1052672, 4194304, 122 },
-	{ 98304, 1052672, 4194304, 123 },
-	{ 106496, 1052672, 4194304, 124 },
-	{ 114688, 1052672, 4194304, 125 },
-	{ 122880, 1052672, 4194304, 126 },
-	{ 131072, 1052672, 4194304, 127 },
+/**
+ * @brief parameters of memory_slot_group_list
+ *
+ */
+struct memory_slot_group_list_param {
+	size_t allocatable_bytes_;                       //!< max allocatable bytes by allocation
+	size_t init_buffer_bytes_of_memory_slot_group_;   //!< buffer size of one memory_slot_group when 1st allocation
+	size_t limit_bytes_for_one_memory_slot_group_;    //!< limitation to allocate one memory_slot_group
+};
+
+constexpr memory_slot_group_list_param g_memory_slot_group_list_param_array[] = {
+	{ 8, 4096, 1048576 },
+	{ 16, 4096, 1048576 },
+	{ 24, 4096, 1048576 },
+	{ 32, 4096, 1048576 },
+	{ 40, 8192, 1048576 },
+	{ 48, 8192, 1048576 },
+	{ 56, 8192, 1048576 },
+	{ 64, 12288, 1048576 },
+	{ 72, 12288, 1048576 },
+	{ 80, 12288, 1048576 },
+	{ 88, 12288, 1048576 },
+	{ 96, 16384, 1048576 },
+	{ 104, 16384, 1048576 },
+	{ 112, 16384, 1048576 },
+	{ 120, 16384, 1048576 },
+	{ 128, 20480, 1048576 },
+	{ 136, 20480, 1048576 },
+	{ 144, 20480, 1048576 },
+	{ 152, 20480, 1048576 },
+	{ 160, 24576, 1048576 },
+	{ 168, 24576, 1048576 },
+	{ 176, 24576, 1048576 },
+	{ 184, 24576, 1048576 },
+	{ 192, 28672, 1048576 },
+	{ 200, 28672, 1048576 },
+	{ 208, 28672, 1048576 },
+	{ 216, 28672, 1048576 },
+	{ 224, 32768, 1048576 },
+	{ 232, 32768, 1048576 },
+	{ 240, 32768, 1048576 },
+	{ 248, 32768, 1048576 },
+	{ 256, 36864, 1048576 },
+	{ 264, 36864, 1048576 },
+	{ 272, 36864, 1048576 },
+	{ 280, 36864, 1048576 },
+	{ 288, 40960, 1048576 },
+	{ 296, 40960, 1048576 },
+	{ 304, 40960, 1048576 },
+	{ 312, 40960, 1048576 },
+	{ 320, 45056, 1048576 },
+	{ 328, 45056, 1048576 },
+	{ 336, 45056, 1048576 },
+	{ 344, 45056, 1048576 },
+	{ 352, 49152, 1048576 },
+	{ 360, 49152, 1048576 },
+	{ 368, 49152, 1048576 },
+	{ 376, 49152, 1048576 },
+	{ 384, 53248, 1048576 },
+	{ 392, 53248, 1048576 },
+	{ 400, 53248, 1048576 },
+	{ 408, 53248, 1048576 },
+	{ 416, 57344, 1048576 },
+	{ 424, 57344, 1048576 },
+	{ 432, 57344, 1048576 },
+	{ 440, 57344, 1048576 },
+	{ 448, 61440, 1048576 },
+	{ 456, 61440, 1048576 },
+	{ 464, 61440, 1048576 },
+	{ 472, 61440, 1048576 },
+	{ 480, 65536, 1048576 },
+	{ 488, 65536, 1048576 },
+	{ 496, 65536, 1048576 },
+	{ 504, 65536, 1048576 },
+	{ 512, 65536, 1048576 },
+	{ 576, 65536, 2097152 },
+	{ 640, 65536, 2097152 },
+	{ 704, 65536, 2097152 },
+	{ 768, 65536, 2097152 },
+	{ 832, 65536, 2097152 },
+	{ 896, 65536, 2097152 },
+	{ 960, 65536, 2097152 },
+	{ 1024, 65536, 4194304 },
+	{ 1152, 77824, 4194304 },
+	{ 1280, 86016, 4194304 },
+	{ 1408, 94208, 4194304 },
+	{ 1536, 102400, 4194304 },
+	{ 1664, 110592, 4194304 },
+	{ 1792, 118784, 4194304 },
+	{ 1920, 126976, 4194304 },
+	{ 2048, 135168, 4194304 },
+	{ 2304, 151552, 4194304 },
+	{ 2560, 167936, 4194304 },
+	{ 2816, 184320, 4194304 },
+	{ 3072, 200704, 4194304 },
+	{ 3328, 217088, 4194304 },
+	{ 3584, 233472, 4194304 },
+	{ 3840, 249856, 4194304 },
+	{ 4096, 266240, 4194304 },
+	{ 4608, 299008, 4194304 },
+	{ 5120, 331776, 4194304 },
+	{ 5632, 364544, 4194304 },
+	{ 6144, 397312, 4194304 },
+	{ 6656, 430080, 4194304 },
+	{ 7168, 462848, 4194304 },
+	{ 7680, 495616, 4194304 },
+	{ 8192, 528384, 4194304 },
+	{ 9216, 528384, 4194304 },
+	{ 10240, 528384, 4194304 },
+	{ 11264, 528384, 4194304 },
+	{ 12288, 528384, 4194304 },
+	{ 13312, 528384, 4194304 },
+	{ 14336, 528384, 4194304 },
+	{ 15360, 528384, 4194304 },
+	{ 16384, 528384, 4194304 },
+	{ 18432, 593920, 4194304 },
+	{ 20480, 659456, 4194304 },
+	{ 22528, 724992, 4194304 },
+	{ 24576, 790528, 4194304 },
+	{ 26624, 856064, 4194304 },
+	{ 28672, 921600, 4194304 },
+	{ 30720, 987136, 4194304 },
+	{ 32768, 1052672, 4194304 },
+	{ 36864, 1052672, 4194304 },
+	{ 40960, 1052672, 4194304 },
+	{ 45056, 1052672, 4194304 },
+	{ 49152, 1052672, 4194304 },
+	{ 53248, 1052672, 4194304 },
+	{ 57344, 1052672, 4194304 },
+	{ 61440, 1052672, 4194304 },
+	{ 65536, 1052672, 4194304 },
+	{ 73728, 1052672, 4194304 },
+	{ 81920, 1052672, 4194304 },
+	{ 90112, 1052672, 4194304 },
+	{ 98304, 1052672, 4194304 },
+	{ 106496, 1052672, 4194304 },
+	{ 114688, 1052672, 4194304 },
+	{ 122880, 1052672, 4194304 },
+	{ 131072, 1052672, 4194304 },
 
 	//
 };
+constexpr size_t num_of_memory_slot_group_list = sizeof( g_memory_slot_group_list_param_array ) / sizeof( g_memory_slot_group_list_param_array[0] );
+static_assert( num_of_memory_slot_group_list * internal::gmem_numa_max_nodes <= internal::retrieved_small_slots_array_mgr::max_entry_, "retrieved_small_slots_array_mgr::max_entry_ is too small" );
+static_assert( internal::gmem_numa_max_nodes <= internal::retrieved_big_slots_array_mgr::max_entry_, "retrieved_big_slots_array_mgr::max_entry_ is too small" );
+
+/**
+ * @brief slot lists of one NUMA node
+ *
+ * memory_slot_group_list and big_memory_slot_list are prepared for each NUMA node.
+ * The index of retrieved slot array is also separated for each NUMA node.
+ * Therefore, a slot freed by a thread on other NUMA node is returned to the lists of its home NUMA node.
+ */
+struct numa_node_slot_lists {
+	internal::memory_slot_group_list memory_slot_group_list_array_[num_of_memory_slot_group_list];
+	internal::big_memory_slot_list   big_memory_slot_list_;
+
+	template <size_t... Is>
+	constexpr numa_node_slot_lists( size_t numa_node_idx, std::index_sequence<Is...> ) noexcept
+	  : memory_slot_group_list_array_ { { g_memory_slot_group_list_param_array[Is].allocatable_bytes_,
+		                                  g_memory_slot_group_list_param_array[Is].init_buffer_bytes_of_memory_slot_group_,
+		                                  g_memory_slot_group_list_param_array[Is].limit_bytes_for_one_memory_slot_group_,
+		                                  numa_node_idx * num_of_memory_slot_group_list + Is,
+		                                  numa_node_idx }... }
+	  , big_memory_slot_list_( numa_node_idx, numa_node_idx )
+	{
+	}
+};
+
+template <size_t... NodeIs>
+struct numa_node_slot_lists_array {
+	numa_node_slot_lists node_slot_lists_[sizeof...( NodeIs )];
+
+	constexpr numa_node_slot_lists_array( std::index_sequence<NodeIs...> ) noexcept
+	  : node_slot_lists_ { { NodeIs, std::make_index_sequence<num_of_memory_slot_group_list>() }... }
+	{
+	}
+};
+
+template <size_t... NodeIs>
+constexpr numa_node_slot_lists_array<NodeIs...> make_numa_node_slot_lists_array( std::index_sequence<NodeIs...> seq ) noexcept;
+
+using numa_node_slot_lists_array_t = decltype( make_numa_node_slot_lists_array( std::make_index_sequence<internal::gmem_numa_max_nodes>() ) );
+
+numa_node_slot_lists_array_t g_numa_node_slot_lists_array { std::make_index_sequence<internal::gmem_numa_max_nodes>() };
+
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+/**
+ * @brief big_memory_slot_list for the sampled allocations that are followed by guard page
+ *
+ * 1 of gmem_debug_guard_sampling_interval allocations in each thread is allocated from this list regardless of the requested size.
+ */
+internal::big_memory_slot_list g_guard_page_big_memory_slot_list( 0, 0, true );
+
+thread_local size_t tl_guard_page_sampling_countdown = internal::gmem_debug_guard_sampling_interval;
+
+inline bool is_sampled_for_guard_page( void ) noexcept
+{
+	if ( tl_guard_page_sampling_countdown > 1 ) {
+		--tl_guard_page_sampling_countdown;
+		return false;
+	}
+	tl_guard_page_sampling_countdown = internal::gmem_debug_guard_sampling_interval;
+	return true;
+}
+#endif
+
+inline numa_node_slot_lists& get_current_numa_node_slot_lists( void ) noexcept
+{
+	return g_numa_node_slot_lists_array.node_slot_lists_[internal::get_current_numa_node_idx()];
+}
 
 inline size_t calc_init_slot_entry( size_t needed_bytes )
 {
@@ -193,8 +275,6 @@ inline size_t calc_init_slot_entry( size_t needed_bytes )
 	return 128;
 }
 
-internal::big_memory_slot_list g_big_memory_slot_list;
-
 /*!
  * @brief	allocate memory
  *
@@ -221,28 +301,39 @@ void* gmem_allocate_impl(
 		return nullptr;
 	}
 
-	constexpr size_t array_count      = sizeof( g_memory_slot_group_list_array ) / sizeof( g_memory_slot_group_list_array[0] );
-	const size_t     initial_slot_idx = calc_init_slot_entry( needed_bytes );
-	for ( size_t i = initial_slot_idx; i < array_count; ++i ) {
-		if ( needed_bytes <= g_memory_slot_group_list_array[i].allocatable_bytes_ ) {
-			internal::slot_link_info* p_slot = g_memory_slot_group_list_array[i].allocate();
+#ifdef ALCC_INTERNAL_GMEM_ENABLE_GUARD_PAGE
+	if ( is_sampled_for_guard_page() ) {
+		internal::big_memory_slot* p_guarded_slot = g_guard_page_big_memory_slot_list.allocate_with_guard_page( needed_bytes );
+		if ( p_guarded_slot != nullptr ) {
+			internal::allocated_mem_top* p_ans = p_guarded_slot->get_tail_aligned_allocated_mem_top( req_align, n );
+			return reinterpret_cast<void*>( p_ans->data_ );
+		}
+	}
+#endif
+
+	numa_node_slot_lists&             cur_node_slot_lists     = get_current_numa_node_slot_lists();
+	internal::memory_slot_group_list* p_slot_group_list_array = cur_node_slot_lists.memory_slot_group_list_array_;
+	const size_t                      initial_slot_idx        = calc_init_slot_entry( needed_bytes );
+	for ( size_t i = initial_slot_idx; i < num_of_memory_slot_group_list; ++i ) {
+		if ( needed_bytes <= p_slot_group_list_array[i].allocatable_bytes_ ) {
+			internal::slot_link_info* p_slot = p_slot_group_list_array[i].allocate();
 			if ( p_slot == nullptr ) {
-				g_memory_slot_group_list_array[i].request_allocate_memory_slot_group();
-				p_slot = g_memory_slot_group_list_array[i].allocate();
+				p_slot_group_list_array[i].request_allocate_memory_slot_group();
+				p_slot = p_slot_group_list_array[i].allocate();
 			}
 			if ( p_slot != nullptr ) {
 				internal::allocated_mem_top* p_ans = p_slot->get_aligned_allocated_mem_top(
 					req_align,
 					n,
-					internal::memory_slot_group::calc_one_slot_size( g_memory_slot_group_list_array[i].allocatable_bytes_ ) );
+					internal::memory_slot_group::calc_one_slot_size( p_slot_group_list_array[i].allocatable_bytes_ ) );
 				return reinterpret_cast<void*>( p_ans->data_ );
 			}
 		}
 	}
 
-	internal::big_memory_slot* p_big_slot = g_big_memory_slot_list.reuse_allocate( needed_bytes );
+	internal::big_memory_slot* p_big_slot = cur_node_slot_lists.big_memory_slot_list_.reuse_allocate( needed_bytes );
 	if ( p_big_slot == nullptr ) {
-		p_big_slot = g_big_memory_slot_list.allocate_newly( needed_bytes );
+		p_big_slot = cur_node_slot_lists.big_memory_slot_list_.allocate_newly( needed_bytes );
 	}
 	if ( p_big_slot != nullptr ) {
 		internal::allocated_mem_top* p_ans = p_big_slot->get_aligned_allocated_mem_top( req_align, n );
@@ -304,7 +395,12 @@ bool gmem_deallocate(
 		if ( &( slot_info.p_mgr_->link_to_big_memory_slot_ ) != p_top ) {
 			p_top->fetch_set( false );
 		}
-		ans = g_big_memory_slot_list.deallocate( slot_info.p_mgr_ );
+		internal::big_memory_slot_list* p_mgr = slot_info.p_mgr_->p_list_mgr_;
+		if ( p_mgr == nullptr ) {
+			internal::LogOutput( log_type::ERR, "big_memory_slot does not have the owner list." );
+			return false;
+		}
+		ans = p_mgr->deallocate( slot_info.p_mgr_ );
 	} else {
 		internal::LogOutput( log_type::ERR, "unknown slot type." );
 		return false;
@@ -348,9 +444,10 @@ size_t get_max_allocatable_size(
 
 void gmem_dump_status( log_type lt, char c, int id ) noexcept
 {
-	constexpr size_t array_count = sizeof( g_memory_slot_group_list_array ) / sizeof( g_memory_slot_group_list_array[0] );
-	for ( size_t i = 0; i < array_count; ++i ) {
-		g_memory_slot_group_list_array[i].dump_status( lt, c, id );
+	for ( size_t node_idx = 0; node_idx < internal::get_numa_node_count(); ++node_idx ) {
+		for ( size_t i = 0; i < num_of_memory_slot_group_list; ++i ) {
+			g_numa_node_slot_lists_array.node_slot_lists_[node_idx].memory_slot_group_list_array_[i].dump_status( lt, c, id );
+		}
 	}
 }
 
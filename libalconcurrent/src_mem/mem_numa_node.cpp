@@ -0,0 +1,151 @@
+/**
+ * @file mem_numa_node.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief NUMA node utilities for gmem
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_NUMA_AWARE
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "alconcurrent/conf_logger.hpp"
+
+#include "mem_numa_node.hpp"
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_NUMA_AWARE
+
+// libnumaに依存しないように、<linux/mempolicy.h>の値をここで定義する。
+constexpr int           numa_mpol_preferred       = 1;          // MPOL_PREFERRED
+constexpr unsigned long numa_mpol_f_mems_allowed  = 1UL << 2;   // MPOL_F_MEMS_ALLOWED
+constexpr size_t        numa_node_mask_bits       = 1024;
+constexpr size_t        numa_node_mask_word_bits  = sizeof( unsigned long ) * 8;
+constexpr unsigned int  numa_node_refresh_count   = 256;   //!< getcpuを呼び出す間隔。スレッドは他のCPUへ移動し得るため、定期的に再取得する。
+
+/**
+ * @brief get the page size of the system. mbind() requires the range that is aligned to this size.
+ *
+ * arm64/ppc64le kernels may use 16K/64K page. Therefore, the page size is read by sysconf() once.
+ */
+static uintptr_t get_numa_page_size( void ) noexcept
+{
+	static const uintptr_t numa_page_size = []() -> uintptr_t {
+		long ret = sysconf( _SC_PAGESIZE );
+		return ( ret > 0 ) ? static_cast<uintptr_t>( ret ) : 4096;
+	}();
+	return numa_page_size;
+}
+
+static size_t detect_numa_node_count( void ) noexcept
+{
+	unsigned long node_mask[numa_node_mask_bits / numa_node_mask_word_bits] = {};
+
+	long ret = syscall( SYS_get_mempolicy, nullptr, node_mask, numa_node_mask_bits, nullptr, numa_mpol_f_mems_allowed );
+	if ( ret != 0 ) {
+		LogOutput( log_type::WARN, "get_mempolicy() fails. NUMA aware mode of gmem works as single node" );
+		return 1;
+	}
+
+	size_t ans = 1;
+	for ( size_t i = 0; i < numa_node_mask_bits; i++ ) {
+		if ( ( node_mask[i / numa_node_mask_word_bits] & ( 1UL << ( i % numa_node_mask_word_bits ) ) ) != 0 ) {
+			ans = i + 1;
+		}
+	}
+	if ( ans > gmem_numa_max_nodes ) {
+		LogOutput( log_type::WARN, "number of NUMA nodes(%zu) is over ALCONCURRENT_CONF_GMEM_NUMA_MAX_NODES(%zu). some nodes share the slot lists", ans, gmem_numa_max_nodes );
+		ans = gmem_numa_max_nodes;
+	}
+	return ans;
+}
+
+size_t get_numa_node_count( void ) noexcept
+{
+	static const size_t numa_node_count = detect_numa_node_count();
+	return numa_node_count;
+}
+
+struct numa_node_cache {
+	size_t       node_idx_;
+	unsigned int call_count_;
+};
+
+static thread_local numa_node_cache tl_numa_node_cache { 0, 0 };
+
+size_t get_current_numa_node_idx( void ) noexcept
+{
+	const size_t node_count = get_numa_node_count();
+	if ( node_count <= 1 ) {
+		return 0;
+	}
+
+	if ( tl_numa_node_cache.call_count_ == 0 ) {
+		unsigned int cpu  = 0;
+		unsigned int node = 0;
+		if ( syscall( SYS_getcpu, &cpu, &node, nullptr ) == 0 ) {
+			tl_numa_node_cache.node_idx_ = static_cast<size_t>( node ) % node_count;
+		}
+		tl_numa_node_cache.call_count_ = numa_node_refresh_count;
+	}
+	tl_numa_node_cache.call_count_--;
+
+	return tl_numa_node_cache.node_idx_;
+}
+
+bool bind_memory_to_numa_node( void* p_mem, size_t bytes, size_t node_idx ) noexcept
+{
+	if ( get_numa_node_count() <= 1 ) {
+		return true;
+	}
+
+	const uintptr_t numa_page_size = get_numa_page_size();
+	uintptr_t       addr_begin     = ( reinterpret_cast<uintptr_t>( p_mem ) + numa_page_size - 1 ) & ~( numa_page_size - 1 );
+	uintptr_t       addr_end       = ( reinterpret_cast<uintptr_t>( p_mem ) + bytes ) & ~( numa_page_size - 1 );
+	if ( addr_end <= addr_begin ) {
+		return true;
+	}
+
+	unsigned long node_mask[numa_node_mask_bits / numa_node_mask_word_bits] = {};
+	node_mask[node_idx / numa_node_mask_word_bits] |= 1UL << ( node_idx % numa_node_mask_word_bits );
+
+	long ret = syscall( SYS_mbind, addr_begin, addr_end - addr_begin, numa_mpol_preferred, node_mask, numa_node_mask_bits, 0 );
+	if ( ret != 0 ) {
+		LogOutput( log_type::DEBUG, "mbind() fails for node %zu", node_idx );
+		return false;
+	}
+	return true;
+}
+
+#else
+
+size_t get_numa_node_count( void ) noexcept
+{
+	return 1;
+}
+
+size_t get_current_numa_node_idx( void ) noexcept
+{
+	return 0;
+}
+
+bool bind_memory_to_numa_node( void* p_mem, size_t bytes, size_t node_idx ) noexcept
+{
+	return true;
+}
+
+#endif
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
@@ -0,0 +1,70 @@
+/**
+ * @file mem_numa_node.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief NUMA node utilities for gmem
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#ifndef ALCONCCURRENT_SRC_MEM_NUMA_NODE_HPP_
+#define ALCONCCURRENT_SRC_MEM_NUMA_NODE_HPP_
+
+#include <cstddef>
+
+#ifndef ALCONCURRENT_CONF_GMEM_NUMA_MAX_NODES
+#define ALCONCURRENT_CONF_GMEM_NUMA_MAX_NODES 4
+#endif
+
+namespace alpha {
+namespace concurrent {
+namespace internal {
+
+/**
+ * @brief gmemが管理するNUMAノードの最大数
+ *
+ * ALCONCURRENT_CONF_ENABLE_GMEM_NUMA_AWAREが定義されていない場合、1となり、NUMAノードを区別しない。
+ */
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_NUMA_AWARE
+constexpr size_t gmem_numa_max_nodes = ALCONCURRENT_CONF_GMEM_NUMA_MAX_NODES;
+#else
+constexpr size_t gmem_numa_max_nodes = 1;
+#endif
+static_assert( gmem_numa_max_nodes >= 1, "ALCONCURRENT_CONF_GMEM_NUMA_MAX_NODES should be 1 or more" );
+
+/**
+ * @brief get the number of NUMA nodes that gmem uses
+ *
+ * @return number of NUMA nodes. the range is [1, gmem_numa_max_nodes].
+ * If the number of nodes could not be detected, return 1.
+ */
+size_t get_numa_node_count( void ) noexcept;
+
+/**
+ * @brief get the index of NUMA node that the calling thread is running on
+ *
+ * The result is cached in thread local storage and refreshed periodically.
+ *
+ * @return index of NUMA node. the range is [0, get_numa_node_count()).
+ */
+size_t get_current_numa_node_idx( void ) noexcept;
+
+/**
+ * @brief set the preferred NUMA node of the memory pages that are fully included in [p_mem, p_mem+bytes)
+ *
+ * This should be called before touching the memory. If the number of nodes is 1, this does nothing.
+ *
+ * @param p_mem top address of memory
+ * @param bytes bytes of memory
+ * @param node_idx index of NUMA node
+ * @return true: the preferred NUMA node is set, or there is nothing to set. false: fail to set the preferred NUMA node
+ */
+bool bind_memory_to_numa_node( void* p_mem, size_t bytes, size_t node_idx ) noexcept;
+
+}   // namespace internal
+}   // namespace concurrent
+}   // namespace alpha
+
+#endif
@@ -13,7 +13,7 @@
 #define ALCONCCURRENT_SRC_MEM_RETRIEVED_SLOT_ARRAY_MGR_HPP_
 
 #include <atomic>
-#include <mutex>
+#include <thread>
 #include <type_traits>
 #ifdef ALCONCURRENT_CONF_ENABLE_CHECK_LOGIC_ERROR
 #include <exception>
@@ -22,6 +22,8 @@
 #include "alconcurrent/conf_logger.hpp"
 #include "alconcurrent/hazard_ptr.hpp"
 
+#include "mem_numa_node.hpp"
+
 namespace alpha {
 namespace concurrent {
 namespace internal {
@@ -38,6 +40,7 @@ struct retrieved_slots_stack {
 
 	constexpr retrieved_slots_stack( void ) noexcept
 	  : p_head_of_slot_stack_( nullptr )
+	  , p_tail_of_slot_stack_( nullptr )
 	  , count_( 0 )
 	{
 	}
@@ -48,7 +51,10 @@ struct retrieved_slots_stack {
 			return;
 		}
 		p->p_temprary_link_next_ = p_head_of_slot_stack_;
-		p_head_of_slot_stack_    = p;
+		if ( p_head_of_slot_stack_ == nullptr ) {
+			p_tail_of_slot_stack_ = p;
+		}
+		p_head_of_slot_stack_ = p;
 		count_++;
 	}
 
@@ -59,27 +65,71 @@ struct retrieved_slots_stack {
 			return nullptr;
 		}
 		p_head_of_slot_stack_ = p->p_temprary_link_next_;
+		if ( p_head_of_slot_stack_ == nullptr ) {
+			p_tail_of_slot_stack_ = nullptr;
+		}
 		count_--;
 		return p;
 	}
 
+	/**
+	 * @brief move all slots in src to the head of this stack
+	 *
+	 * Because the tail of stack is tracked, this is O(1).
+	 */
 	void merge( retrieved_slots_stack&& src ) noexcept
 	{
 		slot_pointer p = src.p_head_of_slot_stack_;
 		if ( p == nullptr ) {
 			return;
 		}
-		src.p_head_of_slot_stack_ = nullptr;
 
+		src.p_tail_of_slot_stack_->p_temprary_link_next_ = p_head_of_slot_stack_;
+		if ( p_head_of_slot_stack_ == nullptr ) {
+			p_tail_of_slot_stack_ = src.p_tail_of_slot_stack_;
+		}
+		p_head_of_slot_stack_ = p;
 		count_ += src.count_;
-		src.count_ = 0;
 
-		slot_pointer p_last = p;
-		while ( p_last->p_temprary_link_next_ != nullptr ) {
-			p_last = p_last->p_temprary_link_next_;
+		src.p_head_of_slot_stack_ = nullptr;
+		src.p_tail_of_slot_stack_ = nullptr;
+		src.count_                = 0;
+	}
+
+	/**
+	 * @brief ハザードポインタに登録されていないスロットを取り出す
+	 *
+	 * 取り出し過程で見つかったハザードポインタ登録中のスロットは、still_in_hazard_stackへ移す。
+	 * 同じスロットが複数のスタックに存在することはなく、ハザードポインタとして登録可能なスロットの数は
+	 * ハザードポインタのスロット数で抑えられるため、検査回数も高々ハザードポインタのスロット数+1回となる。
+	 *
+	 * スロットが1つだけの場合は直接検査し、複数の場合はハザードポインタのスナップショットを1回だけ取得して検査する。
+	 * このスタックはスレッドローカルであり、積まれたスロットは共有データ構造から到達不可能なため、この時点でスナップショットを取得してよい。
+	 *
+	 * @param still_in_hazard_stack まだハザードポインタ登録中のスロットを返すスタック
+	 * @return slot_pointer 取り出したスロットへのポインタ。nullptrの場合、取り出せるスロットがなかったことを示す。
+	 */
+	slot_pointer pop_no_in_hazard( retrieved_slots_stack& still_in_hazard_stack ) noexcept
+	{
+		if ( count_ == 1 ) {
+			slot_pointer p = pop();
+			if ( !hazard_ptr_mgr::CheckPtrIsHazardPtr( p ) ) {
+				return p;
+			}
+			still_in_hazard_stack.push( p );
+			return nullptr;
+		}
+
+		hazard_ptr_snapshot hzrd_snapshot = hazard_ptr_mgr::TakeSnapshot();
+		slot_pointer        p             = pop();
+		while ( p != nullptr ) {
+			if ( !hzrd_snapshot.contains( p ) ) {
+				return p;
+			}
+			still_in_hazard_stack.push( p );
+			p = pop();
 		}
-		p_last->p_temprary_link_next_ = p_head_of_slot_stack_;
-		p_head_of_slot_stack_         = p;
+		return nullptr;
 	}
 
 	bool is_empty( void ) const noexcept
@@ -95,10 +145,13 @@ struct retrieved_slots_stack {
 	void reset_for_test( void ) noexcept
 	{
 		p_head_of_slot_stack_ = nullptr;   // even if leaked, just release to detect memory leak
+		p_tail_of_slot_stack_ = nullptr;
+		count_                = 0;
 	}
 
 private:
 	slot_pointer p_head_of_slot_stack_;   //!< pointer to head unused memory slot stack
+	slot_pointer p_tail_of_slot_stack_;   //!< pointer to tail unused memory slot stack
 	size_t       count_;
 };
 
@@ -109,143 +162,275 @@ private:
  * SLOT_T* == decltype(p->p_temprary_link_next_)
  */
 template <typename SLOT_T>
-struct retrieved_slots_stack_lockable {
+struct retrieved_slots_stack_lockfree {
 	using slot_pointer = SLOT_T*;
 
-	constexpr retrieved_slots_stack_lockable( void ) noexcept
-	  : mtx_()
-	  , head_unused_memory_slot_stack_()
+	constexpr retrieved_slots_stack_lockfree( void ) noexcept
+	  : hph_head_unused_memory_slot_stack_()
 	{
 	}
 
 	slot_pointer try_push( slot_pointer p ) noexcept
 	{
-		std::unique_lock<std::mutex> lock( mtx_, std::try_to_lock );
-		if ( !lock.owns_lock() ) {
+		if ( p == nullptr ) {
+			return nullptr;
+		}
+
+		// Experimental: CAS loopせず、素直にあきらめる方式
+		slot_pointer p_cur_head = hph_head_unused_memory_slot_stack_.load( std::memory_order_acquire );
+		p->ap_slot_next_.store( p_cur_head, std::memory_order_release );
+		if ( !hph_head_unused_memory_slot_stack_.compare_exchange_strong( p_cur_head, p, std::memory_order_acq_rel ) ) {
 			return p;
 		}
 
-		head_unused_memory_slot_stack_.push( p );
 		return nullptr;
 	}
 
 	slot_pointer try_pop( void ) noexcept
 	{
-		std::unique_lock<std::mutex> lock( mtx_, std::try_to_lock );
-		if ( !lock.owns_lock() ) {
+		// Experimental: CAS loopせず、素直にあきらめる方式
+		hazard_pointer hp_cur_head = hph_head_unused_memory_slot_stack_.get_to_verify_exchange();
+		if ( !hph_head_unused_memory_slot_stack_.verify_exchange( hp_cur_head ) ) {
+			return nullptr;
+		}
+		if ( hp_cur_head == nullptr ) {
 			return nullptr;
 		}
 
-		return head_unused_memory_slot_stack_.pop();
+		typename hazard_pointer::pointer p_new_head = hp_cur_head->ap_slot_next_.load( std::memory_order_acquire );
+		if ( hph_head_unused_memory_slot_stack_.compare_exchange_strong_to_verify_exchange2( hp_cur_head, p_new_head ) ) {
+			// hp_cur_headの所有権を獲得
+			return hp_cur_head.get();
+		}
+		return nullptr;
 	}
 
-	void merge( retrieved_slots_stack<SLOT_T>&& src ) noexcept
+	void push( slot_pointer p ) noexcept
 	{
-		std::lock_guard<std::mutex> lock( mtx_ );
-		head_unused_memory_slot_stack_.merge( std::move( src ) );
+		if ( p == nullptr ) {
+			return;
+		}
+
+		SLOT_T* p_cur_head = hph_head_unused_memory_slot_stack_.load( std::memory_order_acquire );
+		do {
+			p->ap_slot_next_.store( p_cur_head, std::memory_order_release );
+		} while ( !hph_head_unused_memory_slot_stack_.compare_exchange_strong( p_cur_head, p, std::memory_order_acq_rel ) );
+
+		return;
 	}
 
-	bool is_empty( void ) const noexcept
+	/**
+	 * @brief スロットを取り出す
+	 *
+	 * try_pop()と異なり、CAS競合時はリトライする。そのため、nullptrが返った場合、スタックが空であったことを保証する。
+	 *
+	 * @return slot_pointer 取り出したスロットへのポインタ。nullptrの場合、スタックが空であったことを示す。
+	 */
+	slot_pointer pop( void ) noexcept
 	{
-		std::lock_guard<std::mutex> lock( mtx_ );
-		return head_unused_memory_slot_stack_.is_empty();
+		hazard_pointer hp_cur_head = hph_head_unused_memory_slot_stack_.get_to_verify_exchange();
+		while ( true ) {
+			if ( !hph_head_unused_memory_slot_stack_.verify_exchange( hp_cur_head ) ) {
+				continue;
+			}
+			if ( hp_cur_head == nullptr ) {
+				return nullptr;
+			}
+
+			typename hazard_pointer::pointer p_new_head = hp_cur_head->ap_slot_next_.load( std::memory_order_acquire );
+			if ( hph_head_unused_memory_slot_stack_.compare_exchange_strong_to_verify_exchange2( hp_cur_head, p_new_head ) ) {
+				// hp_cur_headの所有権を獲得
+				return hp_cur_head.get();
+			}
+		}
 	}
 
-	size_t count( void ) const noexcept
+	/**
+	 * @brief move all slots in src to this stack
+	 *
+	 * The slots are linked by ap_slot_next_ in local, and then the linked slots are spliced to the head by one CAS loop.
+	 */
+	void merge( retrieved_slots_stack<SLOT_T>&& src ) noexcept
 	{
-		std::lock_guard<std::mutex> lock( mtx_ );
-		return head_unused_memory_slot_stack_.count();
+		slot_pointer p_last = src.pop();
+		if ( p_last == nullptr ) {
+			return;
+		}
+
+		// pushを繰り返した場合と同じ順序になるように、取り出した順に先頭へ積み上げる。
+		slot_pointer p_top = p_last;
+		slot_pointer p     = src.pop();
+		while ( p != nullptr ) {
+			p->ap_slot_next_.store( p_top, std::memory_order_relaxed );
+			p_top = p;
+			p     = src.pop();
+		}
+
+		SLOT_T* p_cur_head = hph_head_unused_memory_slot_stack_.load( std::memory_order_acquire );
+		do {
+			p_last->ap_slot_next_.store( p_cur_head, std::memory_order_release );
+		} while ( !hph_head_unused_memory_slot_stack_.compare_exchange_strong( p_cur_head, p_top, std::memory_order_acq_rel ) );
 	}
 
 	void reset_for_test( void ) noexcept
 	{
-		std::lock_guard<std::mutex> lock( mtx_ );
-		head_unused_memory_slot_stack_.reset_for_test();
+		hph_head_unused_memory_slot_stack_.store( nullptr, std::memory_order_release );
 	}
 
 private:
-	mutable std::mutex            mtx_;
-	retrieved_slots_stack<SLOT_T> head_unused_memory_slot_stack_;   //!< pointer to head unused memory slot stack
+	using hazard_pointer = typename hazard_ptr_handler<SLOT_T>::hazard_pointer;
+
+	hazard_ptr_handler<SLOT_T> hph_head_unused_memory_slot_stack_;   //!< pointer to head unused memory slot stack
 };
 
 /**
- * @brief keep the list of retrieved slots as global
+ * @brief keep the list of retrieved slots that may be still in hazard as global
+ *
+ * ロックを使わず、pushはCASで先頭へ積み、取り出しはスタック全体をexchangeで切り離す。
+ * 切り離したスロットは切り離したスレッドだけが参照するため、ABA問題もハザードポインタも不要で、
+ * ハザードポインタの検査もロックを保持せずに行える。
+ * 切り離している間、他スレッドからはこのスタックが空に見えるため、wait_for_pop_by_others()で切り離し中の取り出しの完了を待てるようにする。
  *
  * @tparam SLOT_T type of slot that requires below;
  * SLOT_T* == decltype(p->p_temprary_link_next_)
+ * std::atomic<SLOT_T*> == decltype(p->ap_slot_next_)
  */
 template <typename SLOT_T>
-struct retrieved_slots_stack_lockfree {
+struct retrieved_slots_stack_detachable {
 	using slot_pointer = SLOT_T*;
 
-	constexpr retrieved_slots_stack_lockfree( void ) noexcept
-	  : hph_head_unused_memory_slot_stack_()
+	constexpr retrieved_slots_stack_detachable( void ) noexcept
+	  : ap_head_unused_memory_slot_stack_( nullptr )
+	  , pop_begin_count_( 0 )
+	  , pop_end_count_( 0 )
 	{
 	}
 
-	slot_pointer try_push( slot_pointer p ) noexcept
+	/**
+	 * @brief move all slots in src to this stack
+	 *
+	 * The slots are linked by p_temprary_link_next_ in local, and then the linked slots are spliced to the head by one CAS loop.
+	 */
+	void merge( retrieved_slots_stack<SLOT_T>&& src ) noexcept
 	{
-		if ( p == nullptr ) {
-			return nullptr;
+		slot_pointer p_last = src.pop();
+		if ( p_last == nullptr ) {
+			return;
 		}
 
-		// Experimental: CAS loopせず、素直にあきらめる方式
-		slot_pointer p_cur_head = hph_head_unused_memory_slot_stack_.load( std::memory_order_acquire );
-		p->ap_slot_next_.store( p_cur_head, std::memory_order_release );
-		if ( !hph_head_unused_memory_slot_stack_.compare_exchange_strong( p_cur_head, p, std::memory_order_acq_rel ) ) {
-			return p;
+		slot_pointer p_top = p_last;
+		slot_pointer p     = src.pop();
+		while ( p != nullptr ) {
+			p->p_temprary_link_next_ = p_top;
+			p_top                    = p;
+			p                        = src.pop();
 		}
 
-		return nullptr;
+		// p_last->p_temprary_link_next_は、CAS成功によって公開されるまで他スレッドから参照されない。
+		slot_pointer p_cur_head = ap_head_unused_memory_slot_stack_.load( std::memory_order_relaxed );
+		do {
+			p_last->p_temprary_link_next_ = p_cur_head;
+		} while ( !ap_head_unused_memory_slot_stack_.compare_exchange_weak( p_cur_head, p_top, std::memory_order_release, std::memory_order_relaxed ) );
 	}
 
-	slot_pointer try_pop( void ) noexcept
+	/**
+	 * @brief ハザードポインタに登録されていないスロットを取り出す
+	 *
+	 * スタック全体を切り離してから、ロックを保持せずにハザードポインタのスナップショットを取得して検査する。
+	 * 見つかったハザードポインタ登録中ではないスロットのうち、1つを返し、残りはdst_non_hazard_stackへ移す。
+	 * まだハザードポインタ登録中のスロットは、他スレッドからも再利用できるよう、このスタックへ戻す。
+	 *
+	 * 切り離している間、他スレッドからはこのスタックが空に見える。そのため、同時に呼び出した他スレッドは、
+	 * 再利用可能なスロットがあってもnullptrを受け取ることがある。このような場合に備え、呼び出し側はwait_for_pop_by_others()で
+	 * 他スレッドの取り出しの完了を待ってから、再確認すること。
+	 *
+	 * @param dst_non_hazard_stack 返さなかったハザードポインタ登録中ではないスロットを移すスタック
+	 * @return slot_pointer 取り出したスロットへのポインタ。nullptrの場合、切り離したスロットがすべてハザードポインタ登録中であったか、スタックが空に見えたことを示す。
+	 */
+	slot_pointer pop_no_in_hazard( retrieved_slots_stack_lockfree<SLOT_T>& dst_non_hazard_stack ) noexcept
 	{
-		// Experimental: CAS loopせず、素直にあきらめる方式
-		hazard_pointer hp_cur_head = hph_head_unused_memory_slot_stack_.get_to_verify_exchange();
-		if ( !hph_head_unused_memory_slot_stack_.verify_exchange( hp_cur_head ) ) {
-			return nullptr;
-		}
-		if ( hp_cur_head == nullptr ) {
-			return nullptr;
+		// 切り離しより先に、切り離し中であることを公開する。
+		pop_begin_count_.fetch_add( 1, std::memory_order_seq_cst );
+		slot_pointer p_ans = pop_no_in_hazard_impl( dst_non_hazard_stack );
+		pop_end_count_.fetch_add( 1, std::memory_order_seq_cst );
+		return p_ans;
+	}
+
+	/**
+	 * @brief この呼び出しより前に他スレッドが開始したpop_no_in_hazard()の完了を待つ
+	 *
+	 * @return true: 他スレッドの取り出しの完了を待った。呼び出し側は、グローバルのスタックを再確認すること。
+	 * @return false: 他スレッドの取り出しはなかった。
+	 */
+	bool wait_for_pop_by_others( void ) const noexcept
+	{
+		size_t begin_cnt = pop_begin_count_.load( std::memory_order_seq_cst );
+		if ( pop_end_count_.load( std::memory_order_seq_cst ) >= begin_cnt ) {
+			return false;
 		}
 
-		typename hazard_pointer::pointer p_new_head = hp_cur_head->ap_slot_next_.load( std::memory_order_acquire );
-		if ( hph_head_unused_memory_slot_stack_.compare_exchange_strong_to_verify_exchange2( hp_cur_head, p_new_head ) ) {
-			// hp_cur_headの所有権を獲得
-			return hp_cur_head.get();
+		// 切り離したスロットを検査する処理は、有限時間で完了する。
+		while ( pop_end_count_.load( std::memory_order_seq_cst ) < begin_cnt ) {
+			std::this_thread::yield();
 		}
-		return nullptr;
+		return true;
 	}
 
-	void merge( retrieved_slots_stack<SLOT_T>&& src ) noexcept
+	bool is_empty( void ) const noexcept
 	{
-		slot_pointer p = src.pop();
-		while ( p != nullptr ) {
-			push( p );
-			p = src.pop();
-		}
+		return ap_head_unused_memory_slot_stack_.load( std::memory_order_acquire ) == nullptr;
 	}
 
 	void reset_for_test( void ) noexcept
 	{
-		hph_head_unused_memory_slot_stack_.store( nullptr, std::memory_order_release );
+		ap_head_unused_memory_slot_stack_.store( nullptr, std::memory_order_release );   // even if leaked, just release to detect memory leak
 	}
 
 private:
-	using hazard_pointer = typename hazard_ptr_handler<SLOT_T>::hazard_pointer;
-
-	void push( slot_pointer p ) noexcept
+	slot_pointer pop_no_in_hazard_impl( retrieved_slots_stack_lockfree<SLOT_T>& dst_non_hazard_stack ) noexcept
 	{
-		SLOT_T* p_cur_head = hph_head_unused_memory_slot_stack_.load( std::memory_order_acquire );
-		do {
-			p->ap_slot_next_.store( p_cur_head, std::memory_order_release );
-		} while ( !hph_head_unused_memory_slot_stack_.compare_exchange_strong( p_cur_head, p, std::memory_order_acq_rel ) );
+		// pop_begin_count_での公開を、空になったスタックを読んだスレッドから観測できるように、acq_relとする。
+		slot_pointer p = ap_head_unused_memory_slot_stack_.exchange( nullptr, std::memory_order_acq_rel );
+		if ( p == nullptr ) {
+			return nullptr;
+		}
 
-		return;
+		if ( p->p_temprary_link_next_ == nullptr ) {
+			// 切り離したスロットが1つだけなら、スナップショットを作るよりも直接検査する方が安い。
+			if ( !hazard_ptr_mgr::CheckPtrIsHazardPtr( p ) ) {
+				return p;
+			}
+			retrieved_slots_stack<SLOT_T> still_in_hazard_stack;
+			still_in_hazard_stack.push( p );
+			merge( std::move( still_in_hazard_stack ) );
+			return nullptr;
+		}
+
+		// スナップショットは、検査対象のスロットを切り離した後に取得する必要がある。
+		hazard_ptr_snapshot           hzrd_snapshot = hazard_ptr_mgr::TakeSnapshot();
+		retrieved_slots_stack<SLOT_T> non_hazard_stack;
+		retrieved_slots_stack<SLOT_T> still_in_hazard_stack;
+		slot_pointer                  p_ans = nullptr;
+		while ( p != nullptr ) {
+			slot_pointer p_next = p->p_temprary_link_next_;
+			if ( hzrd_snapshot.contains( p ) ) {
+				still_in_hazard_stack.push( p );
+			} else if ( p_ans == nullptr ) {
+				p_ans = p;
+			} else {
+				non_hazard_stack.push( p );
+			}
+			p = p_next;
+		}
+
+		merge( std::move( still_in_hazard_stack ) );
+		dst_non_hazard_stack.merge( std::move( non_hazard_stack ) );
+		return p_ans;
 	}
 
-	hazard_ptr_handler<SLOT_T> hph_head_unused_memory_slot_stack_;   //!< pointer to head unused memory slot stack
+	std::atomic<slot_pointer> ap_head_unused_memory_slot_stack_;   //!< pointer to head unused memory slot stack
+	std::atomic<size_t>       pop_begin_count_;                    //!< number of the started pop_no_in_hazard()
+	std::atomic<size_t>       pop_end_count_;                      //!< number of the finished pop_no_in_hazard()
 };
 
 /**
@@ -254,12 +439,21 @@ private:
  * @tparam SLOT_T type of slot that requires below;
  * SLOT_T* == decltype(p->p_temprary_link_next_)
  * std::atomic<SLOT_T*> == decltype(p->ap_slot_next_)
+ *
+ * request_reuse()は、ロック取得を待たず、CAS競合を理由に再利用可能なスロットの取り出しを断念しない。
+ * また、他スレッドがグローバルのハザードポインタ登録中スタックを検査のために切り離している間は、その検査の完了を待ってから
+ * グローバルのスタックを再確認する。
+ * よって、request_reuse()がnullptrを返す(=新たなスロットが割り当てられる)のは、呼び出しスレッドのTLSとグローバルのスタックに、
+ * 再利用可能なスロットが残っていない場合に限られる。
+ * なお、他スレッドのTLSに保持されるスロット(エントリ毎、スレッド毎に、ハザードポインタに登録されていないスロットが高々1個、
+ * ハザードポインタ登録中のスロットが tls_in_hazard_slots_threshold_ 個未満)は、グローバルのスタックには含まれない。
  */
 template <typename SLOT_T>
 struct retrieved_slots_stack_array_mgr {
 	using slot_pointer = SLOT_T*;
 
-	static constexpr size_t max_entry_ = 128;
+	static constexpr size_t max_entry_                      = 128 * gmem_numa_max_nodes;   //!< NUMAノード毎に、サイズ別の128エントリを持つ
+	static constexpr size_t tls_in_hazard_slots_threshold_ = 32;   //!< TLSのハザードポインタ登録中リストがこの数以上になったら、グローバルへ移す
 
 	static void         retrieve( size_t idx, slot_pointer p ) noexcept;
 	static slot_pointer request_reuse( size_t idx ) noexcept;
@@ -267,33 +461,51 @@ struct retrieved_slots_stack_array_mgr {
 	static void reset_for_test( void ) noexcept;
 
 private:
-	static retrieved_slots_stack_lockfree<SLOT_T> global_non_hazard_retrieved_slots_lockfree_stack_[max_entry_];
-	static retrieved_slots_stack_lockable<SLOT_T> global_in_hazard_retrieved_slots_lockable_stack_[max_entry_];
+	static retrieved_slots_stack_lockfree<SLOT_T>   global_non_hazard_retrieved_slots_lockfree_stack_[max_entry_];
+	static retrieved_slots_stack_detachable<SLOT_T> global_in_hazard_retrieved_slots_detachable_stack_[max_entry_];
+
+	static constexpr size_t bits_of_used_bitmap_word_ = sizeof( unsigned long long ) * 8;
+	static constexpr size_t num_of_used_bitmap_words_ = ( max_entry_ + bits_of_used_bitmap_word_ - 1 ) / bits_of_used_bitmap_word_;
 
 	struct tls_data {
 		retrieved_slots_stack<SLOT_T> non_hazard_retrieved_slots_stack_[max_entry_];
 		retrieved_slots_stack<SLOT_T> in_hazard_retrieved_slots_stack_[max_entry_];
+		unsigned long long            used_bitmap_[num_of_used_bitmap_words_];   //!< bit of the index that may keep slots. スレッド終了時に、空のエントリの走査を省くために使用する。
 
 		constexpr tls_data( void ) noexcept
 		  : non_hazard_retrieved_slots_stack_ {}
 		  , in_hazard_retrieved_slots_stack_ {}
+		  , used_bitmap_ {}
 		{
 		}
 
 		~tls_data( void )
 		{
-			for ( size_t i = 0; i < max_entry_; i++ ) {
+			for ( size_t w = 0; w < num_of_used_bitmap_words_; w++ ) {
+				unsigned long long bits = used_bitmap_[w];
+				while ( bits != 0 ) {
+					size_t i = w * bits_of_used_bitmap_word_ + static_cast<size_t>( __builtin_ctzll( bits ) );
+					bits &= bits - 1;
 #ifdef ALCONCURRENT_CONF_ENABLE_GMEM_PROFILE
-				LogOutput( log_type::DUMP,
-				           "retrieved_slots_stack_array_mgr: idx=%zu, non-hazard slots=%zu, in-hazard slots=%zu",
-				           i,
-				           non_hazard_retrieved_slots_stack_[i].count(),
-				           in_hazard_retrieved_slots_stack_[i].count() );
+					LogOutput( log_type::DUMP,
+					           "retrieved_slots_stack_array_mgr: idx=%zu, non-hazard slots=%zu, in-hazard slots=%zu",
+					           i,
+					           non_hazard_retrieved_slots_stack_[i].count(),
+					           in_hazard_retrieved_slots_stack_[i].count() );
 #endif
-				global_non_hazard_retrieved_slots_lockfree_stack_[i].merge( std::move( non_hazard_retrieved_slots_stack_[i] ) );
-				global_in_hazard_retrieved_slots_lockable_stack_[i].merge( std::move( in_hazard_retrieved_slots_stack_[i] ) );
+					global_non_hazard_retrieved_slots_lockfree_stack_[i].merge( std::move( non_hazard_retrieved_slots_stack_[i] ) );
+					if ( !in_hazard_retrieved_slots_stack_[i].is_empty() ) {
+						global_in_hazard_retrieved_slots_detachable_stack_[i].merge( std::move( in_hazard_retrieved_slots_stack_[i] ) );
+					}
+				}
+				used_bitmap_[w] = 0;
 			}
 		}
+
+		void mark_used( size_t idx ) noexcept
+		{
+			used_bitmap_[idx / bits_of_used_bitmap_word_] |= 1ULL << ( idx % bits_of_used_bitmap_word_ );
+		}
 	};
 
 	static thread_local tls_data tls_data_;
@@ -303,7 +515,7 @@ template <typename SLOT_T>
 retrieved_slots_stack_lockfree<SLOT_T> retrieved_slots_stack_array_mgr<SLOT_T>::global_non_hazard_retrieved_slots_lockfree_stack_[max_entry_];
 
 template <typename SLOT_T>
-retrieved_slots_stack_lockable<SLOT_T> retrieved_slots_stack_array_mgr<SLOT_T>::global_in_hazard_retrieved_slots_lockable_stack_[max_entry_];
+retrieved_slots_stack_detachable<SLOT_T> retrieved_slots_stack_array_mgr<SLOT_T>::global_in_hazard_retrieved_slots_detachable_stack_[max_entry_];
 
 template <typename SLOT_T>
 thread_local typename retrieved_slots_stack_array_mgr<SLOT_T>::tls_data retrieved_slots_stack_array_mgr<SLOT_T>::tls_data_;
@@ -320,16 +532,20 @@ void retrieved_slots_stack_array_mgr<SLOT_T>::retrieve( size_t idx, slot_pointer
 
 	if ( hazard_ptr_mgr::CheckPtrIsHazardPtr( p ) ) {
 		// ハザードポインタとして登録されている場合、ハザードポインタ登録中のリストに追加する
+		tls_data_.mark_used( idx );
 		tls_data_.in_hazard_retrieved_slots_stack_[idx].push( p );
+		if ( tls_data_.in_hazard_retrieved_slots_stack_[idx].count() >= tls_in_hazard_slots_threshold_ ) {
+			// TLSに溜め込むと他スレッドから再利用できなくなるため、グローバルのハザードポインタ登録中リストへ移す。
+			global_in_hazard_retrieved_slots_detachable_stack_[idx].merge( std::move( tls_data_.in_hazard_retrieved_slots_stack_[idx] ) );
+		}
 	} else {
 		// ハザードポインタとして登録されていない場合、未使用スロットリストに登録する
 		if ( tls_data_.non_hazard_retrieved_slots_stack_[idx].is_empty() ) {
+			tls_data_.mark_used( idx );
 			tls_data_.non_hazard_retrieved_slots_stack_[idx].push( p );
 		} else {
-			p = global_non_hazard_retrieved_slots_lockfree_stack_[idx].try_push( p );
-			if ( p != nullptr ) {
-				tls_data_.non_hazard_retrieved_slots_stack_[idx].push( p );
-			}
+			// TLSに溜め込まないように、CAS競合時もリトライしてグローバルへ登録する。
+			global_non_hazard_retrieved_slots_lockfree_stack_[idx].push( p );
 		}
 	}
 }
@@ -351,35 +567,39 @@ typename retrieved_slots_stack_array_mgr<SLOT_T>::slot_pointer retrieved_slots_s
 	}
 
 	// ロックフリースタックから取得を試みる。
-	p = global_non_hazard_retrieved_slots_lockfree_stack_[idx].try_pop();
+	// CAS競合で取得を断念すると、空きスロットを取り残したまま新たなスロットを割り当ててしまうため、空と判定できるまでリトライする。
+	p = global_non_hazard_retrieved_slots_lockfree_stack_[idx].pop();
 	if ( p != nullptr ) {
 		return p;
 	}
 
 	// TLSのハザードポインタ登録中リストから取得を試みる。
-	p = tls_data_.in_hazard_retrieved_slots_stack_[idx].pop();
-	if ( p != nullptr ) {
-		if ( hazard_ptr_mgr::CheckPtrIsHazardPtr( p ) ) {
-			// まだハザードポインタとして登録されている場合、ハザードポインタ登録中のリストに差し戻す。
-			tls_data_.in_hazard_retrieved_slots_stack_[idx].push( p );
-		} else {
-			// ハザードポインタとして登録されていない場合
+	// 先頭だけを検査すると、先頭以降の再利用可能なスロットを取り残すため、ハザードポインタ登録中ではないスロットが見つかるまで検査する。
+	if ( !tls_data_.in_hazard_retrieved_slots_stack_[idx].is_empty() ) {
+		retrieved_slots_stack<SLOT_T> still_in_hazard_stack;
+		p = tls_data_.in_hazard_retrieved_slots_stack_[idx].pop_no_in_hazard( still_in_hazard_stack );
+		tls_data_.in_hazard_retrieved_slots_stack_[idx].merge( std::move( still_in_hazard_stack ) );
+		if ( p != nullptr ) {
 			return p;
 		}
 	}
 
-	p = global_in_hazard_retrieved_slots_lockable_stack_[idx].try_pop();
-	if ( p != nullptr ) {
-		if ( hazard_ptr_mgr::CheckPtrIsHazardPtr( p ) ) {
-			// まだハザードポインタとして登録されている場合、ハザードポインタ登録中のリストに差し戻す。
-			tls_data_.in_hazard_retrieved_slots_stack_[idx].push( p );
-		} else {
-			// ハザードポインタとして登録されていない場合
+	// グローバルのハザードポインタ登録中リストから取得を試みる。
+	// ロックを使わずにリスト全体を切り離して検査する。他スレッドが切り離している間は空に見えるため、
+	// その検査の完了を待ってから、グローバルのスタックを再確認する。
+	while ( true ) {
+		p = global_in_hazard_retrieved_slots_detachable_stack_[idx].pop_no_in_hazard( global_non_hazard_retrieved_slots_lockfree_stack_[idx] );
+		if ( p != nullptr ) {
+			return p;
+		}
+		if ( !global_in_hazard_retrieved_slots_detachable_stack_[idx].wait_for_pop_by_others() ) {
+			return nullptr;
+		}
+		p = global_non_hazard_retrieved_slots_lockfree_stack_[idx].pop();
+		if ( p != nullptr ) {
 			return p;
 		}
 	}
-
-	return nullptr;
 }
 
 template <typename SLOT_T>
@@ -387,7 +607,7 @@ void retrieved_slots_stack_array_mgr<SLOT_T>::reset_for_test( void ) noexcept
 {
 	for ( size_t i = 0; i < max_entry_; i++ ) {
 		global_non_hazard_retrieved_slots_lockfree_stack_[i].reset_for_test();
-		global_in_hazard_retrieved_slots_lockable_stack_[i].reset_for_test();
+		global_in_hazard_retrieved_slots_detachable_stack_[i].reset_for_test();
 
 		tls_data_.non_hazard_retrieved_slots_stack_[i].reset_for_test();
 		tls_data_.in_hazard_retrieved_slots_stack_[i].reset_for_test();
@@ -12,6 +12,8 @@
 #include "mem_small_memory_slot.hpp"
 #include "alloc_only_allocator.hpp"
 #include "mem_allocated_mem_top.hpp"
+#include "mem_debug_guard.hpp"
+#include "mem_numa_node.hpp"
 #include "mmap_allocator.hpp"
 
 namespace alpha {
@@ -66,6 +68,10 @@ slot_link_info* memory_slot_group_list::allocate_impl( void ) noexcept
 	// 回収済み、再割り当て待ちリストからスロットの取得を試みる
 	slot_link_info* p_ans = retrieved_small_slots_array_mgr::request_reuse( retrieved_array_idx_ );
 	if ( p_ans != nullptr ) {
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD
+		memory_slot_group* p_owner = p_ans->link_to_memory_slot_group_.load_addr<memory_slot_group>();
+		unpoison_memory_region_for_debug( p_ans->data_, p_owner->one_slot_bytes_ - sizeof( slot_link_info ) + sizeof( slot_link_info* ) );
+#endif
 		bool old_is_used = p_ans->link_to_memory_slot_group_.fetch_set( true );
 		if ( old_is_used ) {
 			LogOutput( log_type::ERR, "big_memory_slot_list::reuse_allocate() detected unexpected is_used flag" );
@@ -173,6 +179,8 @@ bool memory_slot_group_list::deallocate( slot_link_info* p ) noexcept
 	btinfo_alloc_free& cur_btinfo = p_slot_owner->get_btinfo( p_slot_owner->get_slot_idx( p ) );
 	cur_btinfo.free_trace_        = bt_info::record_backtrace();
 #endif
+	// p_temprary_link_next_ is used by retrieved_small_slots_array_mgr, therefore it is excluded from poisoning
+	poison_memory_region_for_debug( p->data_ + sizeof( slot_link_info* ), p_slot_owner->one_slot_bytes_ - sizeof( slot_link_info ) );
 	retrieved_small_slots_array_mgr::retrieve( retrieved_array_idx_, p );
 	return true;
 }
@@ -184,6 +192,7 @@ void memory_slot_group_list::request_allocate_memory_slot_group( void ) noexcept
 	if ( p_buffer_ret == nullptr ) {
 		return;
 	}
+	bind_memory_to_numa_node( p_buffer_ret, cur_allocating_buffer_bytes, numa_node_idx_ );
 	memory_slot_group* p_new_group = memory_slot_group::emplace_on_mem( p_buffer_ret, this, cur_allocating_buffer_bytes, allocatable_bytes_ );
 	memory_slot_group* p_cur_head  = ap_head_memory_slot_group_.load( std::memory_order_acquire );
 	do {
@@ -205,6 +214,7 @@ void memory_slot_group_list::clear_for_test( void ) noexcept
 	memory_slot_group* p_cur = ap_head_memory_slot_group_.load( std::memory_order_acquire );
 	while ( p_cur != nullptr ) {
 		memory_slot_group* p_next = p_cur->ap_next_group_;
+		unpoison_memory_region_for_debug( p_cur, p_cur->buffer_size_ );
 		gmem_alloc_only_inst.deallocate( p_cur );
 		p_cur = p_next;
 	}
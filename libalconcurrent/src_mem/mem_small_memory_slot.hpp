@@ -331,6 +331,7 @@ using retrieved_small_slots_array_mgr = retrieved_slots_stack_array_mgr<slot_lin
  */
 struct memory_slot_group_list {
 	const size_t                    retrieved_array_idx_;                     //!< index of memory_slot_group_list in g_memory_slot_group_list_array
+	const size_t                    numa_node_idx_;                           //!< index of NUMA node that memory_slot_group belongs to
 	const size_t                    allocatable_bytes_;                       //!< allocatable bytes per one slot
 	const size_t                    limit_bytes_for_one_memory_slot_group_;   //!< max bytes for one memory_slot_group
 	std::atomic<size_t>             next_allocating_buffer_bytes_;            //!< allocating buffer size of next allocation for memory_slot_group
@@ -341,9 +342,11 @@ struct memory_slot_group_list {
 		const size_t allocatable_bytes_arg,                        //!< [in] max allocatable bytes by allocation
 		const size_t init_buffer_bytes_of_memory_slot_group_arg,   //!< [in] buffer size of one memory_slot_group when 1st allocation
 		const size_t limit_bytes_for_one_memory_slot_group_arg,    //!< [in] limitation to allocate one memory_slot_group
-		const size_t retrieved_array_idx_arg = 0                   //!< [in] index of memory_slot_group_list in g_memory_slot_group_list_array
+		const size_t retrieved_array_idx_arg = 0,                  //!< [in] index of memory_slot_group_list in g_memory_slot_group_list_array
+		const size_t numa_node_idx_arg       = 0                   //!< [in] index of NUMA node that memory_slot_group belongs to
 		) noexcept
 	  : retrieved_array_idx_( retrieved_array_idx_arg )
+	  , numa_node_idx_( numa_node_idx_arg )
 	  , allocatable_bytes_( allocatable_bytes_arg )
 	  , limit_bytes_for_one_memory_slot_group_( limit_bytes_for_one_memory_slot_group_arg )
 	  , next_allocating_buffer_bytes_( check_init_buffer_size( allocatable_bytes_arg, init_buffer_bytes_of_memory_slot_group_arg ) )
@@ -0,0 +1,120 @@
+/**
+ * @file perf_atomic_shared_ptr.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * 設定情報の再読み込みを想定し、多数の読み出しスレッドがload()を繰り返す中で、1つの書き込みスレッドが定期的にstore()する。
+ * 一定時間内に、読み出しスレッドが何回load()できたか？を計測することで性能を測定する。
+ *
+ * @note need C++20 to comple
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "alconcurrent/atomic_shared_ptr.hpp"
+
+struct config_data {
+	std::size_t version_;
+	std::string name_;
+
+	config_data( std::size_t v )
+	  : version_( v )
+	  , name_( "config" )
+	{
+	}
+};
+
+template <typename SUT_T>
+std::size_t reader_task( std::latch& start_sync_latch, std::atomic_bool& loop_flag, SUT_T& sut )
+{
+	std::size_t count        = 0;
+	std::size_t last_version = 0;
+
+	start_sync_latch.arrive_and_wait();
+	while ( loop_flag.load( std::memory_order_acquire ) ) {
+		std::shared_ptr<config_data> sp = sut.load();
+		if ( sp->version_ < last_version ) {
+			std::cout << "SUT has bug!!!" << std::endl;
+			abort();
+		}
+		last_version = sp->version_;
+		count++;
+	}
+
+	return count;
+}
+
+template <typename SUT_T>
+void nwoker_perf_test_read_mostly( const char* p_title, unsigned int nreader, unsigned int exec_sec, std::chrono::microseconds reload_interval )
+{
+	SUT_T sut( std::make_shared<config_data>( 0 ) );
+
+	std::cout << p_title << "\tnumber of reader thread is " << nreader << ", reload interval " << reload_interval.count() << "us \t=-> ";
+
+	std::latch       start_sync_latch( nreader + 1 );
+	std::atomic_bool loop_flag( true );
+
+	std::vector<std::future<std::size_t>> rets( nreader );
+	for ( auto& e_f_r : rets ) {
+		std::packaged_task<std::size_t()> task(
+			[&start_sync_latch, &loop_flag, &sut]() {
+				return reader_task<SUT_T>( start_sync_latch, loop_flag, sut );
+			} );   // 非同期実行する関数を登録する
+		e_f_r = task.get_future();
+		std::thread( std::move( task ) ).detach();
+	}
+
+	start_sync_latch.arrive_and_wait();
+	auto        tp_end       = std::chrono::steady_clock::now() + std::chrono::seconds( exec_sec );
+	std::size_t num_of_store = 0;
+	while ( std::chrono::steady_clock::now() < tp_end ) {
+		num_of_store++;
+		sut.store( std::make_shared<config_data>( num_of_store ) );
+		std::this_thread::sleep_for( reload_interval );
+	}
+	loop_flag.store( false, std::memory_order_release );
+
+	std::size_t count_sum = 0;
+	for ( auto& r : rets ) {
+		count_sum += r.get();
+	}
+
+	std::cout << "load count: " << count_sum << "\tstore count: " << num_of_store << std::endl;
+}
+
+template <typename SUT_T>
+void nwoker_perf_test_read_mostly_sub( const char* p_title, unsigned int nworker )
+{
+	nwoker_perf_test_read_mostly<SUT_T>( p_title, nworker, 1, std::chrono::microseconds( 1000 ) );
+	nwoker_perf_test_read_mostly<SUT_T>( p_title, nworker, 1, std::chrono::microseconds( 10 ) );
+	nwoker_perf_test_read_mostly<SUT_T>( p_title, 4, 1, std::chrono::microseconds( 1000 ) );
+	nwoker_perf_test_read_mostly<SUT_T>( p_title, 1, 1, std::chrono::microseconds( 1000 ) );
+}
+
+int main( void )
+{
+	auto nworker = std::thread::hardware_concurrency();
+	if ( nworker == 0 ) {
+		std::cout << "hardware_concurrency is unknown, therefore let's select templary value. " << std::endl;
+		nworker = 10;
+	}
+
+	nwoker_perf_test_read_mostly_sub<alpha::concurrent::atomic_shared_ptr<config_data>>( "alpha::concurrent::atomic_shared_ptr", nworker );
+	nwoker_perf_test_read_mostly_sub<std::atomic<std::shared_ptr<config_data>>>( "std::atomic<std::shared_ptr>", nworker );
+
+	return EXIT_SUCCESS;
+}
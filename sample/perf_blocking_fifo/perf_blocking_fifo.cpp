@@ -0,0 +1,175 @@
+/**
+ * @file perf_blocking_fifo.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * 待ち合わせ中のconsumerが起床するまでの遅延と、値がないときにconsumerが消費するCPU時間を、
+ * blocking_fifo_list、std::condition_variableを使ったキュー、sleepでポーリングするfifo_listで比較する。
+ *
+ * @note need C++20 to comple
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <time.h>
+
+#include "alconcurrent/lf_blocking_fifo.hpp"
+#include "alconcurrent/lf_fifo.hpp"
+
+constexpr int       num_of_rounds = 200;
+constexpr auto      push_interval = std::chrono::microseconds( 1000 );
+constexpr auto      idle_duration = std::chrono::milliseconds( 500 );
+constexpr auto      poll_interval = std::chrono::microseconds( 50 );
+constexpr long long end_of_test   = -1;
+
+class cv_queue {
+public:
+	void push( long long v )
+	{
+		{
+			std::lock_guard<std::mutex> lk( mtx_ );
+			q_.push_back( v );
+		}
+		cv_.notify_one();
+	}
+
+	std::optional<long long> pop_wait( void )
+	{
+		std::unique_lock<std::mutex> lk( mtx_ );
+		cv_.wait( lk, [this]() { return !q_.empty(); } );
+		long long ans = q_.front();
+		q_.pop_front();
+		return ans;
+	}
+
+private:
+	std::mutex              mtx_;
+	std::condition_variable cv_;
+	std::deque<long long>   q_;
+};
+
+class blocking_fifo_adaptor {
+public:
+	void push( long long v )
+	{
+		fifo_.push( v );
+	}
+
+	std::optional<long long> pop_wait( void )
+	{
+		auto ret = fifo_.pop_wait();
+		if ( !ret.has_value() ) return std::nullopt;
+		return ret.value();
+	}
+
+private:
+	alpha::concurrent::blocking_fifo_list<long long> fifo_;
+};
+
+class polling_fifo_adaptor {
+public:
+	void push( long long v )
+	{
+		fifo_.push( v );
+	}
+
+	std::optional<long long> pop_wait( void )
+	{
+		while ( true ) {
+			auto ret = fifo_.pop();
+			if ( ret.has_value() ) return ret.value();
+			std::this_thread::sleep_for( poll_interval );
+		}
+	}
+
+private:
+	alpha::concurrent::fifo_list<long long> fifo_;
+};
+
+long long now_ns( void )
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+long long thread_cpu_time_ns( void )
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
+	return static_cast<long long>( ts.tv_sec ) * 1000000000LL + ts.tv_nsec;
+}
+
+template <typename Q>
+void perf_wakeup_latency( const char* p_name )
+{
+	Q         q;
+	long long sum_latency = 0;
+	long long max_latency = 0;
+	int       count       = 0;
+
+	std::thread th_consumer( [&]() {
+		while ( true ) {
+			auto ret = q.pop_wait();
+			if ( !ret.has_value() ) continue;
+			if ( ret.value() == end_of_test ) break;
+			long long latency = now_ns() - ret.value();
+			sum_latency += latency;
+			if ( latency > max_latency ) max_latency = latency;
+			count++;
+		}
+	} );
+
+	for ( int i = 0; i < num_of_rounds; i++ ) {
+		std::this_thread::sleep_for( push_interval );
+		q.push( now_ns() );
+	}
+	q.push( end_of_test );
+	th_consumer.join();
+
+	std::cout << p_name << "\twake-up latency: avg " << ( sum_latency / count ) / 1000 << " [us], max " << max_latency / 1000 << " [us]" << std::endl;
+}
+
+template <typename Q>
+void perf_idle_cpu( const char* p_name )
+{
+	Q         q;
+	long long consumer_cpu_time = 0;
+
+	std::thread th_consumer( [&]() {
+		long long cpu_start = thread_cpu_time_ns();
+		while ( true ) {
+			auto ret = q.pop_wait();
+			if ( ret.has_value() && ( ret.value() == end_of_test ) ) break;
+		}
+		consumer_cpu_time = thread_cpu_time_ns() - cpu_start;
+	} );
+
+	std::this_thread::sleep_for( idle_duration );
+	q.push( end_of_test );
+	th_consumer.join();
+
+	std::cout << p_name << "\tidle consumer cpu time in " << std::chrono::duration_cast<std::chrono::milliseconds>( idle_duration ).count() << " [ms]: " << consumer_cpu_time / 1000 << " [us]" << std::endl;
+}
+
+int main( void )
+{
+	perf_wakeup_latency<blocking_fifo_adaptor>( "blocking_fifo_list" );
+	perf_wakeup_latency<cv_queue>( "std::condition_variable queue" );
+	perf_wakeup_latency<polling_fifo_adaptor>( "fifo_list with sleep polling" );
+
+	perf_idle_cpu<blocking_fifo_adaptor>( "blocking_fifo_list" );
+	perf_idle_cpu<cv_queue>( "std::condition_variable queue" );
+	perf_idle_cpu<polling_fifo_adaptor>( "fifo_list with sleep polling" );
+
+	return EXIT_SUCCESS;
+}
@@ -18,9 +18,13 @@
 #include <list>
 #include <mutex>
 #include <new>
+#include <thread>
 #include <vector>
 
+#include "alconcurrent/lf_bounded_fifo.hpp"
 #include "alconcurrent/lf_fifo.hpp"
+#include "alconcurrent/lf_segmented_fifo.hpp"
+#include "alconcurrent/lf_sharded_fifo.hpp"
 
 #include "../inc_common/perf_pushpop_NtoN.hpp"
 
@@ -143,6 +147,38 @@ private:
 	std::list<value_type> l_;
 };
 
+template <typename T>
+class bounded_fifo : public alpha::concurrent::bounded_fifo_list<T> {
+public:
+	bounded_fifo( void )
+	  : alpha::concurrent::bounded_fifo_list<T>( ReserveSize )
+	{
+	}
+
+	/**
+	 * @brief 計測では値の総数が一定のため、書き込み中/取り出し中のセルによる一時的な満杯は、完了を待って再試行する
+	 */
+	void push( T x )
+	{
+		while ( !this->try_push( x ) ) {
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	 * @brief 計測では値の総数が一定のため、空と判定されても値が残っている間は再試行する
+	 */
+	alpha::concurrent::alcc_optional<T> pop( void )
+	{
+		auto ret = this->try_pop();
+		while ( !ret.has_value() && !this->is_empty() ) {
+			std::this_thread::yield();
+			ret = this->try_pop();
+		}
+		return ret;
+	}
+};
+
 // ===========================================================
 using TestType = std::size_t;
 // using TestType = int;
@@ -158,6 +194,38 @@ int nwoker_perf_test_stack_NtoN_sub( unsigned int nworker )
 	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType>, SUT_N>( 2, 1 );
 	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType>, SUT_N>( 1, 1 );
 
+	std::cout << "--- fifo_list with epoch_based_reclamation " << std::to_string( SUT_N ) << " ---" << std::endl;
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( nworker * 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( nworker, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( nworker / 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( 4, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::fifo_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( 1, 1 );
+
+	std::cout << "--- bounded_fifo_list " << std::to_string( SUT_N ) << " ---" << std::endl;
+	nwoker_perf_test_pushpop_NtoN<bounded_fifo<TestType>, SUT_N>( nworker * 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<bounded_fifo<TestType>, SUT_N>( nworker, 1 );
+	nwoker_perf_test_pushpop_NtoN<bounded_fifo<TestType>, SUT_N>( nworker / 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<bounded_fifo<TestType>, SUT_N>( 4, 1 );
+	nwoker_perf_test_pushpop_NtoN<bounded_fifo<TestType>, SUT_N>( 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<bounded_fifo<TestType>, SUT_N>( 1, 1 );
+
+	std::cout << "--- segmented_fifo_list " << std::to_string( SUT_N ) << " ---" << std::endl;
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::segmented_fifo_list<TestType>, SUT_N>( nworker * 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::segmented_fifo_list<TestType>, SUT_N>( nworker, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::segmented_fifo_list<TestType>, SUT_N>( nworker / 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::segmented_fifo_list<TestType>, SUT_N>( 4, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::segmented_fifo_list<TestType>, SUT_N>( 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::segmented_fifo_list<TestType>, SUT_N>( 1, 1 );
+
+	std::cout << "--- sharded_fifo " << std::to_string( SUT_N ) << " ---" << std::endl;
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::sharded_fifo<TestType>, SUT_N>( nworker * 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::sharded_fifo<TestType>, SUT_N>( nworker, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::sharded_fifo<TestType>, SUT_N>( nworker / 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::sharded_fifo<TestType>, SUT_N>( 4, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::sharded_fifo<TestType>, SUT_N>( 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::sharded_fifo<TestType>, SUT_N>( 1, 1 );
+
 	std::cout << "--- vec_fifo " << std::to_string( SUT_N ) << " ---" << std::endl;
 	nwoker_perf_test_pushpop_NtoN<vec_fifo<TestType>, SUT_N>( nworker * 2, 1 );
 	nwoker_perf_test_pushpop_NtoN<vec_fifo<TestType>, SUT_N>( nworker, 1 );
@@ -0,0 +1,135 @@
+/**
+ * @file perf_list.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * lockfree_listのハザードポインタ版とepoch based reclamation版を比較する。
+ * push/popの繰り返しと、find_ifで全ノードをたどる読み込み中心の処理の2種類で、一定時間内に何回のループ処理が実行できるか？を計測する。
+ *
+ * @note need C++20 to comple
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <latch>
+#include <thread>
+#include <vector>
+
+#include "alconcurrent/lf_list.hpp"
+
+#include "../inc_common/perf_pushpop_NtoN.hpp"
+
+// ===========================================================
+using TestType = std::size_t;
+
+constexpr size_t read_mostly_list_size   = 64;   //!< 読み込み中心の計測でリストに保持する値の数
+constexpr size_t read_mostly_update_rate = 16;   //!< 読み込み中心の計測で、この回数に1回だけpop/pushする
+
+/**
+ * @brief perf_pushpop_NtoN.hppが使うpush/popをlockfree_listのpush_back/pop_frontに対応させる
+ */
+template <typename ReclamationPolicy>
+class list_as_fifo : public alpha::concurrent::lockfree_list<TestType, ReclamationPolicy> {
+public:
+	void push( TestType v )
+	{
+		this->push_back( v );
+	}
+	alpha::concurrent::alcc_optional<TestType> pop( void )
+	{
+		return this->pop_front();
+	}
+};
+
+template <typename ListType>
+std::size_t worker_task_read_mostly(
+	std::latch&       start_sync_latch,
+	std::atomic_bool& loop_flag,
+	ListType&         sut )
+{
+	std::size_t count = 0;
+
+	start_sync_latch.arrive_and_wait();
+	while ( loop_flag.load( std::memory_order_acquire ) ) {
+		if ( ( count % read_mostly_update_rate ) == 0 ) {
+			auto ret = sut.pop_front();
+			if ( !ret.has_value() ) {
+				std::cout << "SUT has bug!!!" << std::endl;
+				abort();
+			}
+			sut.push_back( ret.value() );
+		} else {
+			sut.find_if( []( const TestType& v ) -> bool { return v == read_mostly_list_size; } );   // 見つからない値を探して、全ノードをたどる
+		}
+		count++;
+	}
+
+	return count;
+}
+
+template <typename ListType>
+void nwoker_perf_test_read_mostly( unsigned int nworker, unsigned int exec_sec )
+{
+	ListType sut;
+	for ( TestType i = 0; i < read_mostly_list_size; i++ ) {
+		sut.push_back( i );
+	}
+
+	std::cout << "[Read mostly]           number of worker thread is " << nworker << ", list size=" << std::to_string( read_mostly_list_size ) << " \t=-> ";
+
+	std::latch       start_sync_latch( nworker + 1 );
+	std::atomic_bool loop_flag( true );
+
+	std::vector<std::future<std::size_t>> rets( nworker );
+	for ( auto& e_f_r : rets ) {
+		std::packaged_task<std::size_t()> task(
+			[&start_sync_latch, &loop_flag, &sut]() {
+				return worker_task_read_mostly<ListType>( start_sync_latch, loop_flag, sut );
+			} );   // 非同期実行する関数を登録する
+		e_f_r = task.get_future();
+		std::thread( std::move( task ) ).detach();
+	}
+
+	start_sync_latch.arrive_and_wait();
+	sleep( exec_sec );
+	loop_flag.store( false, std::memory_order_release );
+
+	std::size_t count_sum = 0;
+	for ( auto& r : rets ) {
+		count_sum += r.get();
+	}
+
+	std::cout << "result is count_sum: " << count_sum << "\t\tremained size: " << sut.count_size() << "\t\t" << ( ( sut.count_size() == read_mostly_list_size ) ? "Good" : "FAILED" ) << std::endl;
+}
+
+template <typename ReclamationPolicy>
+void nwoker_perf_test_list_sub( unsigned int nworker )
+{
+	nwoker_perf_test_pushpop_NtoN<list_as_fifo<ReclamationPolicy>, 1>( nworker, 1 );
+	nwoker_perf_test_pushpop_NtoN<list_as_fifo<ReclamationPolicy>, 10>( nworker, 1 );
+	nwoker_perf_test_read_mostly<alpha::concurrent::lockfree_list<TestType, ReclamationPolicy>>( nworker, 1 );
+	nwoker_perf_test_read_mostly<alpha::concurrent::lockfree_list<TestType, ReclamationPolicy>>( 1, 1 );
+}
+
+int main( void )
+{
+	auto nworker = std::thread::hardware_concurrency();
+	if ( nworker == 0 ) {
+		std::cout << "hardware_concurrency is unknown, therefore let's select templary value. " << std::endl;
+		nworker = 10;
+	}
+
+	std::cout << "--- lockfree_list ---" << std::endl;
+	nwoker_perf_test_list_sub<alpha::concurrent::hazard_ptr_reclamation>( nworker );
+
+	std::cout << "--- lockfree_list with epoch_based_reclamation ---" << std::endl;
+	nwoker_perf_test_list_sub<alpha::concurrent::epoch_based_reclamation>( nworker );
+
+	return EXIT_SUCCESS;
+}
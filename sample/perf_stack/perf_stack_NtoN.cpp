@@ -39,6 +39,13 @@ int nwoker_perf_test_pushpop_NtoN_sub( unsigned int nworker )
 	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::stack_list<TestType>, SUT_N>( 4, 1 );
 	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::stack_list<TestType>, SUT_N>( 1, 1 );
 
+	std::cout << "--- stack_list with epoch_based_reclamation " << std::to_string( SUT_N ) << " ---" << std::endl;
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::stack_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( nworker * 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::stack_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( nworker, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::stack_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( nworker / 2, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::stack_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( 4, 1 );
+	nwoker_perf_test_pushpop_NtoN<alpha::concurrent::stack_list<TestType, alpha::concurrent::epoch_based_reclamation>, SUT_N>( 1, 1 );
+
 	std::cout << "--- vec_mutex_stack " << std::to_string( SUT_N ) << " ---" << std::endl;
 	nwoker_perf_test_pushpop_NtoN<vec_mutex_stack<TestType>, SUT_N>( nworker * 2, 1 );
 	nwoker_perf_test_pushpop_NtoN<vec_mutex_stack<TestType>, SUT_N>( nworker, 1 );
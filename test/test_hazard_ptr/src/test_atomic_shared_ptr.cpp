@@ -0,0 +1,194 @@
+/**
+ * @file test_atomic_shared_ptr.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/atomic_shared_ptr.hpp"
+#include "alconcurrent/conf_logger.hpp"
+
+namespace {
+
+std::atomic<int> destruct_count( 0 );
+
+struct test_obj {
+	int v_;
+
+	test_obj( int v )
+	  : v_( v )
+	{
+	}
+	~test_obj()
+	{
+		destruct_count++;
+	}
+};
+
+}   // namespace
+
+class TestAtomicSharedPtr : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		alpha::concurrent::GetErrorWarningLogCountAndReset( nullptr, nullptr );
+		destruct_count.store( 0 );
+	}
+
+	void TearDown() override
+	{
+		alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+		alpha::concurrent::internal::hazard_ptr_mgr::DestoryAll();
+
+		int cw, ce;
+		alpha::concurrent::GetErrorWarningLogCountAndReset( &ce, &cw );
+		EXPECT_EQ( ce, 0 );
+		EXPECT_EQ( cw, 0 );
+	}
+};
+
+TEST_F( TestAtomicSharedPtr, DefaultConstruct_Then_LoadEmpty )
+{
+	// Arrange
+	alpha::concurrent::atomic_shared_ptr<test_obj> sut;
+
+	// Act
+	auto ret = sut.load();
+
+	// Assert
+	EXPECT_EQ( ret, nullptr );
+	EXPECT_EQ( ret.use_count(), 0 );
+}
+
+TEST_F( TestAtomicSharedPtr, Load_Then_MayPropagateExceptionOfHazardPointerSlot )
+{
+	// Arrange
+	alpha::concurrent::atomic_shared_ptr<test_obj> sut;
+
+	// Act
+	// ハザードポインタのスロット確保はstd::bad_allocをスローし得るため、load()はnoexceptであってはならない。
+	bool is_load_noexcept       = noexcept( sut.load() );
+	bool is_conversion_noexcept = noexcept( static_cast<std::shared_ptr<test_obj>>( sut ) );
+
+	// Assert
+	EXPECT_FALSE( is_load_noexcept );
+	EXPECT_FALSE( is_conversion_noexcept );
+}
+
+TEST_F( TestAtomicSharedPtr, Store_Then_LoadSharesOwnership )
+{
+	// Arrange
+	alpha::concurrent::atomic_shared_ptr<test_obj> sut;
+	auto                                           sp = std::make_shared<test_obj>( 1 );
+
+	// Act
+	sut.store( sp );
+	auto ret = sut.load();
+
+	// Assert
+	EXPECT_EQ( ret, sp );
+	EXPECT_EQ( ret->v_, 1 );
+	EXPECT_EQ( sp.use_count(), 3 );   // sp, ret, sut
+}
+
+TEST_F( TestAtomicSharedPtr, Exchange_Then_OldIsReturnedAndReleasedAfterRetire )
+{
+	// Arrange
+	alpha::concurrent::atomic_shared_ptr<test_obj> sut( std::make_shared<test_obj>( 1 ) );
+
+	// Act
+	auto ret = sut.exchange( std::make_shared<test_obj>( 2 ) );
+
+	// Assert
+	ASSERT_NE( ret, nullptr );
+	EXPECT_EQ( ret->v_, 1 );
+	ret.reset();
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+	EXPECT_EQ( destruct_count.load(), 1 );
+	EXPECT_EQ( sut.load()->v_, 2 );
+}
+
+TEST_F( TestAtomicSharedPtr, CompareExchange_WithNotEquivalent_Then_Fail )
+{
+	// Arrange
+	auto                                           sp1 = std::make_shared<test_obj>( 1 );
+	auto                                           sp2 = std::make_shared<test_obj>( 2 );
+	alpha::concurrent::atomic_shared_ptr<test_obj> sut( sp1 );
+	std::shared_ptr<test_obj>                      expected = std::make_shared<test_obj>( 1 );
+
+	// Act
+	bool ret1 = sut.compare_exchange_strong( expected, sp2 );
+	bool ret2 = sut.compare_exchange_strong( expected, sp2 );
+
+	// Assert
+	EXPECT_FALSE( ret1 );
+	EXPECT_TRUE( ret2 );
+	EXPECT_EQ( expected, sp1 );
+	EXPECT_EQ( sut.load(), sp2 );
+}
+
+TEST_F( TestAtomicSharedPtr, CompareExchange_FromEmpty_Then_Success )
+{
+	// Arrange
+	alpha::concurrent::atomic_shared_ptr<test_obj> sut;
+	std::shared_ptr<test_obj>                      expected;
+	auto                                           sp = std::make_shared<test_obj>( 1 );
+
+	// Act
+	bool ret = sut.compare_exchange_weak( expected, sp );
+
+	// Assert
+	EXPECT_TRUE( ret );
+	EXPECT_EQ( sut.load(), sp );
+}
+
+TEST_F( TestAtomicSharedPtr, HighLoadReaderAndWriter_Then_NoLeak )
+{
+	// Arrange
+	constexpr int num_of_readers = 4;
+	constexpr int num_of_stores  = 10000;
+	{
+		alpha::concurrent::atomic_shared_ptr<test_obj> sut( std::make_shared<test_obj>( 0 ) );
+		std::atomic<bool>                              loop_flag( true );
+		std::atomic<bool>                              is_ok( true );
+
+		// Act
+		std::vector<std::thread> readers;
+		for ( int i = 0; i < num_of_readers; i++ ) {
+			readers.emplace_back( [&sut, &loop_flag, &is_ok]() {
+				int last_v = 0;
+				while ( loop_flag.load( std::memory_order_acquire ) ) {
+					auto sp = sut.load();
+					if ( ( sp == nullptr ) || ( sp->v_ < last_v ) ) {
+						is_ok.store( false );
+					} else {
+						last_v = sp->v_;
+					}
+				}
+			} );
+		}
+		for ( int i = 1; i <= num_of_stores; i++ ) {
+			sut.store( std::make_shared<test_obj>( i ) );
+		}
+		loop_flag.store( false, std::memory_order_release );
+		for ( auto& t : readers ) {
+			t.join();
+		}
+
+		// Assert
+		EXPECT_TRUE( is_ok.load() );
+	}
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+	EXPECT_EQ( destruct_count.load(), num_of_stores + 1 );
+}
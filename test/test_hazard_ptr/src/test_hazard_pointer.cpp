@@ -0,0 +1,166 @@
+/**
+ * @file test_hazard_pointer.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/conf_logger.hpp"
+#include "alconcurrent/hazard_pointer.hpp"
+
+namespace {
+
+std::atomic<int> delete_count( 0 );
+
+struct test_obj : public alpha::concurrent::hazard_pointer_obj_base<test_obj> {
+	int v_;
+
+	test_obj( int v )
+	  : v_( v )
+	{
+	}
+	~test_obj()
+	{
+		delete_count++;
+	}
+};
+
+}   // namespace
+
+class TestHazardPointer : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		alpha::concurrent::GetErrorWarningLogCountAndReset( nullptr, nullptr );
+		delete_count.store( 0 );
+	}
+
+	void TearDown() override
+	{
+		alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+		alpha::concurrent::internal::hazard_ptr_mgr::DestoryAll();
+
+		int cw, ce;
+		alpha::concurrent::GetErrorWarningLogCountAndReset( &ce, &cw );
+		EXPECT_EQ( ce, 0 );
+		EXPECT_EQ( cw, 0 );
+	}
+};
+
+TEST_F( TestHazardPointer, DefaultConstruct_Then_Empty )
+{
+	// Arrange
+
+	// Act
+	alpha::concurrent::hazard_pointer sut;
+
+	// Assert
+	EXPECT_TRUE( sut.empty() );
+}
+
+TEST_F( TestHazardPointer, Protect_Then_IsHazardPtr )
+{
+	// Arrange
+	test_obj                          obj( 1 );
+	std::atomic<test_obj*>            src( &obj );
+	alpha::concurrent::hazard_pointer sut = alpha::concurrent::make_hazard_pointer();
+
+	// Act
+	test_obj* p = sut.protect( src );
+
+	// Assert
+	EXPECT_FALSE( sut.empty() );
+	EXPECT_EQ( p, &obj );
+	EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &obj ) );
+	sut.reset_protection();
+	EXPECT_FALSE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &obj ) );
+}
+
+TEST_F( TestHazardPointer, TryProtectWithOldValue_Then_Fail )
+{
+	// Arrange
+	test_obj                          obj1( 1 );
+	test_obj                          obj2( 2 );
+	std::atomic<test_obj*>            src( &obj2 );
+	alpha::concurrent::hazard_pointer sut = alpha::concurrent::make_hazard_pointer();
+	test_obj*                         p   = &obj1;
+
+	// Act
+	bool ret = sut.try_protect( p, src );
+
+	// Assert
+	EXPECT_FALSE( ret );
+	EXPECT_EQ( p, &obj2 );
+	EXPECT_FALSE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &obj1 ) );
+}
+
+TEST_F( TestHazardPointer, RetireProtectedObj_Then_DeleteAfterResetProtection )
+{
+	// Arrange
+	test_obj*                         p_obj = new test_obj( 1 );
+	std::atomic<test_obj*>            src( p_obj );
+	alpha::concurrent::hazard_pointer sut = alpha::concurrent::make_hazard_pointer();
+	test_obj*                         p     = sut.protect( src );
+	src.store( nullptr );
+
+	// Act
+	p->retire();
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+	EXPECT_EQ( delete_count.load(), 0 );
+	sut.reset_protection();
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+
+	// Assert
+	EXPECT_EQ( delete_count.load(), 1 );
+}
+
+TEST_F( TestHazardPointer, RetireManyWithOneProtected_Then_OnlyProtectedIsLeft )
+{
+	// Arrange
+	constexpr int                     num_of_objs = 1000;
+	test_obj*                         p_obj       = new test_obj( 0 );
+	std::atomic<test_obj*>            src( p_obj );
+	alpha::concurrent::hazard_pointer sut = alpha::concurrent::make_hazard_pointer();
+	test_obj*                         p   = sut.protect( src );
+	src.store( nullptr );
+	static_assert( noexcept( p->retire() ), "retire() should be noexcept" );
+
+	// Act
+	p->retire();
+	for ( int i = 1; i < num_of_objs; i++ ) {
+		( new test_obj( i ) )->retire();
+	}
+	size_t ret = alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+
+	// Assert
+	EXPECT_EQ( ret, 1 );
+	EXPECT_EQ( delete_count.load(), num_of_objs - 1 );
+	sut.reset_protection();
+	EXPECT_EQ( alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired(), 0 );
+	EXPECT_EQ( delete_count.load(), num_of_objs );
+}
+
+TEST_F( TestHazardPointer, MakeBatch_Then_AllHaveSlot )
+{
+	// Arrange
+	constexpr size_t num_of_hp = 20;   // over the number of slots in a hazard_ptr_group
+	test_obj         obj( 1 );
+
+	// Act
+	auto sut = alpha::concurrent::make_hazard_pointer<num_of_hp>();
+
+	// Assert
+	for ( auto& e : sut ) {
+		EXPECT_FALSE( e.empty() );
+	}
+	sut[num_of_hp - 1].reset_protection( &obj );
+	EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &obj ) );
+}
@@ -11,11 +11,13 @@
 
 #include <iostream>
 #include <pthread.h>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "alconcurrent/conf_logger.hpp"
 #include "alconcurrent/hazard_ptr.hpp"
+#include "alconcurrent/internal/ebr_domain.hpp"
 #include "alconcurrent/internal/hazard_ptr_internal.hpp"
 #include "hazard_ptr_impl.hpp"
 
@@ -1322,6 +1324,98 @@ TEST_F( TestHazardPtrWMarkHandler, Call_HazardPtr_get_for_nullptr )
 	EXPECT_EQ( hp2.hp_, nullptr );
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+class TestHazardPtrWTagHandler : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		alpha::concurrent::GetErrorWarningLogCountAndReset( nullptr, nullptr );
+	}
+
+	void TearDown() override
+	{
+		alpha::concurrent::internal::hazard_ptr_mgr::DestoryAll();
+
+		int cw, ce;
+		alpha::concurrent::GetErrorWarningLogCountAndReset( &ce, &cw );
+		EXPECT_EQ( ce, 0 );
+		EXPECT_EQ( cw, 0 );
+	}
+};
+
+TEST_F( TestHazardPtrWTagHandler, CallTransConstructor )
+{
+	// Arrange
+	int dummy1 = 1;
+
+	// Act
+	alpha::concurrent::hazard_ptr_w_tag_handler<int> sut( &dummy1, 0xABCD );
+
+	// Assert
+	auto hp = sut.get_to_verify_exchange();
+	EXPECT_EQ( hp.hp_, &dummy1 );
+	EXPECT_EQ( hp.tag_, 0xABCD );
+	EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy1 ) );
+}
+
+TEST_F( TestHazardPtrWTagHandler, ChangeOnlyTag_Then_VerifyExchangeFail )
+{
+	// Arrange
+	int                                              dummy1 = 1;
+	alpha::concurrent::hazard_ptr_w_tag_handler<int> sut( &dummy1, 1 );
+	auto                                             hp = sut.get_to_verify_exchange();
+	EXPECT_TRUE( sut.verify_exchange( hp ) );
+
+	// Act
+	sut.store( &dummy1, 2 );
+	bool ret = sut.verify_exchange( hp );
+
+	// Assert
+	EXPECT_FALSE( ret );
+	EXPECT_EQ( hp.hp_, &dummy1 );
+	EXPECT_EQ( hp.tag_, 2 );
+	EXPECT_TRUE( sut.verify_exchange( hp ) );
+}
+
+TEST_F( TestHazardPtrWTagHandler, CallCompareExchangeStrong_WithOldTag_Then_Fail )
+{
+	// Arrange
+	int                                                             dummy1 = 1;
+	int                                                             dummy2 = 2;
+	alpha::concurrent::hazard_ptr_w_tag_handler<int>                sut( &dummy1, 0xFFFF );
+	alpha::concurrent::hazard_ptr_w_tag_handler<int>::pointer_w_tag expected { 0xFFFE, &dummy1 };
+
+	// Act
+	bool ret1 = sut.compare_exchange_strong( expected, { 0, &dummy2 } );
+	bool ret2 = sut.compare_exchange_strong( expected, { 0, &dummy2 } );
+
+	// Assert
+	EXPECT_FALSE( ret1 );
+	EXPECT_TRUE( ret2 );
+	auto cur = sut.load();
+	EXPECT_EQ( cur.p_, &dummy2 );
+	EXPECT_EQ( cur.tag_, 0 );
+}
+
+TEST_F( TestHazardPtrWTagHandler, CallCompareExchangeStrongToVerifyExchange1_Then_HazardPtrIsUpdated )
+{
+	// Arrange
+	int                                              dummy1 = 1;
+	int                                              dummy2 = 2;
+	alpha::concurrent::hazard_ptr_w_tag_handler<int> sut( &dummy1, 3 );
+	auto                                             hp = sut.get_to_verify_exchange();
+
+	// Act
+	bool ret = sut.compare_exchange_strong_to_verify_exchange1( hp, { 4, &dummy2 } );
+
+	// Assert
+	EXPECT_TRUE( ret );
+	EXPECT_EQ( hp.hp_, &dummy2 );
+	EXPECT_EQ( hp.tag_, 4 );
+	EXPECT_FALSE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy1 ) );
+	EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy2 ) );
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 class TestHazardPtr : public ::testing::Test {
 protected:
@@ -1459,3 +1553,259 @@ TEST_F( TestHazardPtr, Call_ReleaseHazardPtr_by_assignment )
 	p_ret2 = sut.get();
 	EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( p_ret2 ) );
 }
+
+TEST_F( TestHazardPtrHandler, TakeSnapshot_Then_ContainsOnlyHazardPtr )
+{
+	// Arrange
+	int                                        dummy1 = 1;
+	int                                        dummy2 = 2;
+	alpha::concurrent::hazard_ptr_handler<int> sut( &dummy1 );
+	auto                                       hp1 = sut.get_to_verify_exchange();
+	EXPECT_EQ( hp1, &dummy1 );
+
+	// Act
+	auto snapshot = alpha::concurrent::internal::hazard_ptr_mgr::TakeSnapshot();
+
+	// Assert
+	EXPECT_GE( snapshot.size(), 1 );
+	EXPECT_TRUE( snapshot.contains( &dummy1 ) );
+	EXPECT_FALSE( snapshot.contains( &dummy2 ) );
+	EXPECT_FALSE( snapshot.contains( nullptr ) );
+}
+
+TEST_F( TestHazardPtrHandler, TakeSnapshot_ManyHazardPtr_Then_ContainsAll )
+{
+	// Arrange
+	constexpr size_t                                        num_of_ptrs = 200;
+	std::vector<int>                                        dummy_array( num_of_ptrs );
+	std::vector<alpha::concurrent::hazard_ptr_handler<int>> hph_array( num_of_ptrs );
+	std::vector<alpha::concurrent::hazard_ptr<int>>         hp_array;
+	hp_array.reserve( num_of_ptrs );
+	for ( size_t i = 0; i < num_of_ptrs; i++ ) {
+		hph_array[i].store( &dummy_array[i] );
+		hp_array.emplace_back( hph_array[i].get_to_verify_exchange() );
+	}
+	int dummy_not_hazard = 0;
+
+	// Act
+	auto snapshot = alpha::concurrent::internal::hazard_ptr_mgr::TakeSnapshot();
+
+	// Assert
+	EXPECT_GE( snapshot.size(), num_of_ptrs );
+	for ( size_t i = 0; i < num_of_ptrs; i++ ) {
+		EXPECT_TRUE( snapshot.contains( &dummy_array[i] ) );
+	}
+	EXPECT_FALSE( snapshot.contains( &dummy_not_hazard ) );
+}
+
+TEST_F( TestHazardPtrHandler, TakeSnapshotInNest_ManyHazardPtr_Then_BothContainAll )
+{
+	// Arrange
+	constexpr size_t                                        num_of_ptrs = 200;
+	std::vector<int>                                        dummy_array( num_of_ptrs );
+	std::vector<alpha::concurrent::hazard_ptr_handler<int>> hph_array( num_of_ptrs );
+	std::vector<alpha::concurrent::hazard_ptr<int>>         hp_array;
+	hp_array.reserve( num_of_ptrs );
+	for ( size_t i = 0; i < num_of_ptrs; i++ ) {
+		hph_array[i].store( &dummy_array[i] );
+		hp_array.emplace_back( hph_array[i].get_to_verify_exchange() );
+	}
+	int dummy_not_hazard = 0;
+
+	// Act
+	// 1つ目はスレッドローカルにキャッシュしたバッファを使い、入れ子の2つ目は専用のバッファを使う。
+	auto snapshot1 = alpha::concurrent::internal::hazard_ptr_mgr::TakeSnapshot();
+	auto snapshot2 = alpha::concurrent::internal::hazard_ptr_mgr::TakeSnapshot();
+	auto snapshot3 = std::move( snapshot1 );
+
+	// Assert
+	EXPECT_EQ( snapshot1.size(), 0 );
+	EXPECT_GE( snapshot2.size(), num_of_ptrs );
+	EXPECT_GE( snapshot3.size(), num_of_ptrs );
+	for ( size_t i = 0; i < num_of_ptrs; i++ ) {
+		EXPECT_TRUE( snapshot2.contains( &dummy_array[i] ) );
+		EXPECT_TRUE( snapshot3.contains( &dummy_array[i] ) );
+	}
+	EXPECT_FALSE( snapshot2.contains( &dummy_not_hazard ) );
+	EXPECT_FALSE( snapshot3.contains( &dummy_not_hazard ) );
+}
+
+TEST_F( TestHazardPtrHandler, HazardSlotSet_TakeSlots_Then_HazardPtrIsRegistered )
+{
+	// Arrange
+	int dummy1 = 1;
+	int dummy2 = 2;
+	int dummy3 = 3;
+
+	{
+		alpha::concurrent::hazard_slot_set<2> hss;
+		EXPECT_EQ( hss.remaining(), 2 );
+
+		// Act
+		alpha::concurrent::hazard_ptr<int> hp1( hss, &dummy1 );
+		alpha::concurrent::hazard_ptr<int> hp2( hss );
+		alpha::concurrent::hazard_ptr<int> hp3( hss, &dummy3 );   // 予約数を超えたため、通常の割り当てになる
+		hp2.store( &dummy2 );
+
+		// Assert
+		EXPECT_EQ( hss.remaining(), 0 );
+		EXPECT_EQ( hp1, &dummy1 );
+		EXPECT_EQ( hp2, &dummy2 );
+		EXPECT_EQ( hp3, &dummy3 );
+		EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy1 ) );
+		EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy2 ) );
+		EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy3 ) );
+	}
+
+	EXPECT_FALSE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy1 ) );
+	EXPECT_FALSE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy2 ) );
+	EXPECT_FALSE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy3 ) );
+}
+
+TEST_F( TestHazardPtrHandler, HazardSlotSet_MoveOutHazardPtr_Then_OutliveSlotSet )
+{
+	// Arrange
+	int                                        dummy1 = 1;
+	alpha::concurrent::hazard_ptr_handler<int> sut( &dummy1 );
+	alpha::concurrent::hazard_ptr<int>         hp_out;
+
+	// Act
+	{
+		alpha::concurrent::hazard_slot_set<3>                      hss;
+		alpha::concurrent::hazard_ptr_handler<int>::hazard_pointer hp( hss );
+		sut.reuse_to_verify_exchange( hp );
+		EXPECT_TRUE( sut.verify_exchange( hp ) );
+		hp_out = std::move( hp );
+	}
+
+	// Assert
+	EXPECT_EQ( hp_out, &dummy1 );
+	EXPECT_TRUE( alpha::concurrent::internal::hazard_ptr_mgr::CheckPtrIsHazardPtr( &dummy1 ) );
+}
+
+TEST_F( TestHazardPtrHandler, ThreadWithManyHazardPtrExits_Then_NextOwnerScanChainIsShort )
+{
+	// Arrange
+	constexpr size_t num_of_ptrs = alpha::concurrent::internal::hazard_ptr_group::kArraySize * 5;
+	size_t           cnt_in_many_thread = 0;
+	size_t           cnt_in_next_thread = 0;
+
+	std::thread t1( [&cnt_in_many_thread]() {
+		std::vector<int>                                dummy_array( num_of_ptrs );
+		std::vector<alpha::concurrent::hazard_ptr<int>> hp_array;
+		hp_array.reserve( num_of_ptrs );
+		for ( size_t i = 0; i < num_of_ptrs; i++ ) {
+			hp_array.emplace_back( &dummy_array[i] );
+		}
+		cnt_in_many_thread = alpha::concurrent::internal::global_scope_hazard_ptr_chain::CountHazardPtrGroupsOnValidChain();
+	} );
+	t1.join();
+
+	// Act
+	std::thread t2( [&cnt_in_next_thread]() {
+		int                                dummy = 0;
+		alpha::concurrent::hazard_ptr<int> hp( &dummy );
+		cnt_in_next_thread = alpha::concurrent::internal::global_scope_hazard_ptr_chain::CountHazardPtrGroupsOnValidChain();
+	} );
+	t2.join();
+
+	// Assert
+	EXPECT_GE( cnt_in_many_thread, 5 );
+	EXPECT_LE( cnt_in_next_thread, cnt_in_many_thread - 4 );
+}
+
+static std::atomic<int> retire_deleter_call_count( 0 );
+static void             retire_test_deleter( void* p )
+{
+	retire_deleter_call_count++;
+	delete static_cast<int*>( p );
+}
+
+TEST_F( TestHazardPtrHandler, Retire_InHazard_Then_DeleteAfterReleasingHazard )
+{
+	// Arrange
+	retire_deleter_call_count.store( 0 );
+	int*                                       p_target = new int( 1 );
+	alpha::concurrent::hazard_ptr_handler<int> hph( p_target );
+	auto                                       hp = hph.get_to_verify_exchange();
+	hph.store( nullptr );
+
+	// Act
+	alpha::concurrent::internal::hazard_ptr_mgr::Retire( p_target, retire_test_deleter );
+	size_t ret1 = alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+	hp.store( nullptr );
+	size_t ret2 = alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+
+	// Assert
+	EXPECT_EQ( ret1, 1 );
+	EXPECT_EQ( ret2, 0 );
+	EXPECT_EQ( retire_deleter_call_count.load(), 1 );
+}
+
+TEST_F( TestHazardPtrHandler, RetireMany_Then_ReclaimWithoutDrain )
+{
+	// Arrange
+	retire_deleter_call_count.store( 0 );
+
+	// Act
+	for ( int i = 0; i < 10000; i++ ) {
+		alpha::concurrent::internal::hazard_ptr_mgr::Retire( new int( i ), retire_test_deleter );
+	}
+
+	// Assert
+	EXPECT_GT( retire_deleter_call_count.load(), 0 );
+	EXPECT_EQ( alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired(), 0 );
+	EXPECT_EQ( retire_deleter_call_count.load(), 10000 );
+}
+
+TEST_F( TestHazardPtrHandler, RetireInExitedThread_Then_DrainInMainThread )
+{
+	// Arrange
+	retire_deleter_call_count.store( 0 );
+	int*                                       p_target = new int( 1 );
+	alpha::concurrent::hazard_ptr_handler<int> hph( p_target );
+	auto                                       hp = hph.get_to_verify_exchange();
+	hph.store( nullptr );
+
+	// Act
+	std::thread t1( [p_target]() {
+		alpha::concurrent::internal::hazard_ptr_mgr::Retire( p_target, retire_test_deleter );
+	} );
+	t1.join();
+	EXPECT_EQ( retire_deleter_call_count.load(), 0 );
+	hp.store( nullptr );
+	size_t ret = alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+
+	// Assert
+	EXPECT_EQ( ret, 0 );
+	EXPECT_EQ( retire_deleter_call_count.load(), 1 );
+}
+
+TEST( TestEbrDomain, Retire_InCriticalSectionOfOtherThread_Then_NotDeleteUntilLeave )
+{
+	// Arrange
+	retire_deleter_call_count.store( 0 );
+	std::atomic<int> step( 0 );
+	std::thread      t1( [&step]() {
+		alpha::concurrent::internal::ebr_domain::critical_section cs;
+		step.store( 1 );
+		while ( step.load() != 2 ) {
+			std::this_thread::yield();
+		}
+	} );
+	while ( step.load() != 1 ) {
+		std::this_thread::yield();
+	}
+
+	// Act
+	alpha::concurrent::internal::ebr_domain::Retire( new int( 1 ), retire_test_deleter );
+	size_t ret1 = alpha::concurrent::internal::ebr_domain::DrainRetired();
+	step.store( 2 );
+	t1.join();
+	size_t ret2 = alpha::concurrent::internal::ebr_domain::DrainRetired();
+
+	// Assert
+	EXPECT_EQ( ret1, 1 );
+	EXPECT_EQ( ret2, 0 );
+	EXPECT_EQ( retire_deleter_call_count.load(), 1 );
+}
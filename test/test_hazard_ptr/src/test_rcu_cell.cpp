@@ -0,0 +1,152 @@
+/**
+ * @file test_rcu_cell.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/conf_logger.hpp"
+#include "alconcurrent/rcu_cell.hpp"
+
+namespace {
+
+std::atomic<int> destruct_count( 0 );
+
+struct test_table {
+	int a_;
+	int b_;
+
+	test_table( void )
+	  : a_( 0 )
+	  , b_( 0 )
+	{
+	}
+	test_table( int a, int b )
+	  : a_( a )
+	  , b_( b )
+	{
+	}
+	test_table( const test_table& ) = default;
+	~test_table()
+	{
+		destruct_count++;
+	}
+};
+
+}   // namespace
+
+class TestRcuCell : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		alpha::concurrent::GetErrorWarningLogCountAndReset( nullptr, nullptr );
+		destruct_count.store( 0 );
+	}
+
+	void TearDown() override
+	{
+		alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+		alpha::concurrent::internal::hazard_ptr_mgr::DestoryAll();
+
+		int cw, ce;
+		alpha::concurrent::GetErrorWarningLogCountAndReset( &ce, &cw );
+		EXPECT_EQ( ce, 0 );
+		EXPECT_EQ( cw, 0 );
+	}
+};
+
+TEST_F( TestRcuCell, Store_Then_ReadNewValue )
+{
+	// Arrange
+	alpha::concurrent::rcu_cell<test_table> sut( test_table( 1, 2 ) );
+
+	// Act
+	sut.emplace( 3, 4 );
+
+	// Assert
+	auto view = sut.read();
+	EXPECT_EQ( view->a_, 3 );
+	EXPECT_EQ( view->b_, 4 );
+}
+
+TEST_F( TestRcuCell, StoreWhileReading_Then_OldValueIsKeptUntilViewIsReleased )
+{
+	// Arrange
+	alpha::concurrent::rcu_cell<test_table> sut( test_table( 1, 2 ) );
+	destruct_count.store( 0 );
+	auto view = sut.read();
+
+	// Act
+	sut.store( test_table( 5, 6 ) );
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+	int cnt_before_release = destruct_count.load();
+	view.reset();
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+
+	// Assert
+	EXPECT_EQ( cnt_before_release, 1 );   // 引数の一時オブジェクトのみ
+	EXPECT_EQ( destruct_count.load(), 2 );
+	EXPECT_EQ( sut.read()->a_, 5 );
+}
+
+TEST_F( TestRcuCell, Update_Then_ModifiedCopyIsInstalled )
+{
+	// Arrange
+	alpha::concurrent::rcu_cell<test_table> sut( test_table( 1, 2 ) );
+
+	// Act
+	size_t ret = sut.update( []( test_table& t ) { t.b_ += 10; } );
+
+	// Assert
+	EXPECT_EQ( ret, 0 );
+	auto view = sut.read();
+	EXPECT_EQ( view->a_, 1 );
+	EXPECT_EQ( view->b_, 12 );
+}
+
+TEST_F( TestRcuCell, ConcurrentUpdate_Then_NoLostUpdate )
+{
+	// Arrange
+	constexpr int       num_of_threads = 4;
+	constexpr int       num_of_updates = 2000;
+	std::atomic<size_t> total_retry( 0 );
+	{
+		alpha::concurrent::rcu_cell<test_table> sut;
+
+		// Act
+		std::vector<std::thread> writers;
+		for ( int i = 0; i < num_of_threads; i++ ) {
+			writers.emplace_back( [&sut, &total_retry]() {
+				for ( int j = 0; j < num_of_updates; j++ ) {
+					total_retry += sut.update( []( test_table& t ) {
+						t.a_++;
+						t.b_ += 2;
+					} );
+					auto view = sut.read();
+					EXPECT_EQ( view->a_ * 2, view->b_ );
+				}
+			} );
+		}
+		for ( auto& t : writers ) {
+			t.join();
+		}
+
+		// Assert
+		auto view = sut.read();
+		EXPECT_EQ( view->a_, num_of_threads * num_of_updates );
+		EXPECT_EQ( view->b_, num_of_threads * num_of_updates * 2 );
+	}
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+	// CASに失敗したコピーも破棄されるため、リトライ回数分を加える
+	EXPECT_EQ( static_cast<size_t>( destruct_count.load() ), num_of_threads * num_of_updates + 1 + total_retry.load() );
+}
@@ -0,0 +1,126 @@
+/**
+ * @file test_hazard_ptr_simd.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/conf_logger.hpp"
+#include "alconcurrent/internal/hazard_ptr_internal.hpp"
+#include "hazard_ptr_impl.hpp"
+
+using hazard_ptr_group = alpha::concurrent::internal::hazard_ptr_group;
+using slots_t          = std::array<std::atomic<const void*>, hazard_ptr_group::kArraySize>;
+
+class TestHazardPtrSimdScan : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		alpha::concurrent::GetErrorWarningLogCountAndReset( nullptr, nullptr );
+	}
+
+	void TearDown() override
+	{
+		int cw, ce;
+		alpha::concurrent::GetErrorWarningLogCountAndReset( &ce, &cw );
+		EXPECT_EQ( ce, 0 );
+		EXPECT_EQ( cw, 0 );
+	}
+};
+
+TEST_F( TestHazardPtrSimdScan, FullGroup_Then_HitAtEverySlotIndex )
+{
+	// Arrange
+	hazard_ptr_group                                   sut;
+	int                                                dummy_array[hazard_ptr_group::kArraySize];
+	alpha::concurrent::internal::hzrd_slot_ownership_t righofownership_array[hazard_ptr_group::kArraySize];
+	for ( size_t i = 0; i < hazard_ptr_group::kArraySize; i++ ) {
+		righofownership_array[i] = sut.try_assign( &dummy_array[i] );
+		ASSERT_NE( righofownership_array[i], nullptr );
+	}
+
+	// Act & Assert
+	for ( size_t i = 0; i < hazard_ptr_group::kArraySize; i++ ) {
+		EXPECT_TRUE( sut.check_pointer_is_hazard_pointer( &dummy_array[i] ) ) << "i=" << i;
+	}
+}
+
+TEST_F( TestHazardPtrSimdScan, FullGroup_Then_MissIfOnlyOneByteIsDifferent )
+{
+	// Arrange
+	hazard_ptr_group                                   sut;
+	int                                                dummy_array[hazard_ptr_group::kArraySize];
+	alpha::concurrent::internal::hzrd_slot_ownership_t righofownership_array[hazard_ptr_group::kArraySize];
+	for ( size_t i = 0; i < hazard_ptr_group::kArraySize; i++ ) {
+		righofownership_array[i] = sut.try_assign( &dummy_array[i] );
+		ASSERT_NE( righofownership_array[i], nullptr );
+	}
+
+	// Act & Assert
+	for ( size_t i = 0; i < hazard_ptr_group::kArraySize; i++ ) {
+		for ( unsigned int b = 0; b < sizeof( void* ); b++ ) {
+			std::uintptr_t addr = reinterpret_cast<std::uintptr_t>( &dummy_array[i] ) ^ ( static_cast<std::uintptr_t>( 0x80U ) << ( b * 8 ) );
+			EXPECT_FALSE( sut.check_pointer_is_hazard_pointer( reinterpret_cast<void*>( addr ) ) ) << "i=" << i << ", byte=" << b;
+		}
+	}
+}
+
+#ifdef ALCC_INTERNAL_ENABLE_X86_SIMD_HZRD_SCAN
+static void check_hit_and_miss_at_every_slot_index( alpha::concurrent::internal::chk_hzrd_slots_t p_func )
+{
+	int     target = 0;
+	slots_t slots;
+	for ( size_t i = 0; i < hazard_ptr_group::kArraySize; i++ ) {
+		for ( auto& e : slots ) {
+			e.store( nullptr );
+		}
+
+		slots[i].store( &target );
+		EXPECT_TRUE( p_func( slots.data(), &target ) ) << "i=" << i;
+
+		for ( unsigned int b = 0; b < sizeof( void* ); b++ ) {
+			std::uintptr_t addr = reinterpret_cast<std::uintptr_t>( &target ) ^ ( static_cast<std::uintptr_t>( 0x80U ) << ( b * 8 ) );
+			slots[i].store( reinterpret_cast<const void*>( addr ) );
+			EXPECT_FALSE( p_func( slots.data(), &target ) ) << "i=" << i << ", byte=" << b;
+		}
+	}
+}
+
+TEST_F( TestHazardPtrSimdScan, Sse2_Then_HitAndMissAtEverySlotIndex )
+{
+	check_hit_and_miss_at_every_slot_index( alpha::concurrent::internal::chk_hzrd_slots_sse2 );
+}
+
+TEST_F( TestHazardPtrSimdScan, Avx2_Then_HitAndMissAtEverySlotIndex )
+{
+	__builtin_cpu_init();
+	if ( !__builtin_cpu_supports( "avx2" ) ) {
+		GTEST_SKIP() << "CPU does not support AVX2";
+	}
+
+	check_hit_and_miss_at_every_slot_index( alpha::concurrent::internal::chk_hzrd_slots_avx2 );
+}
+
+TEST_F( TestHazardPtrSimdScan, Select_Then_FunctionMatchesCpuFeature )
+{
+	// Arrange
+	__builtin_cpu_init();
+	alpha::concurrent::internal::chk_hzrd_slots_t expected = __builtin_cpu_supports( "avx2" ) ? alpha::concurrent::internal::chk_hzrd_slots_avx2 : alpha::concurrent::internal::chk_hzrd_slots_sse2;
+
+	// Act
+	alpha::concurrent::internal::chk_hzrd_slots_t ret = alpha::concurrent::internal::select_chk_hzrd_slots_func();
+
+	// Assert
+	EXPECT_EQ( ret, expected );
+}
+#endif
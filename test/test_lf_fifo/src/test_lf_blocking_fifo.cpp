@@ -0,0 +1,180 @@
+/**
+ * @file test_lf_blocking_fifo.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_blocking_fifo.hpp"
+
+TEST( lfBlockingFifoTest, PopWaitForOnEmpty_Then_Timeout )
+{
+	// Arrange
+	alpha::concurrent::blocking_fifo_list<int> sut;
+
+	// Act
+	auto tp_start = std::chrono::steady_clock::now();
+	auto ret      = sut.pop_wait_for( std::chrono::milliseconds( 20 ) );
+	auto tp_end   = std::chrono::steady_clock::now();
+
+	// Assert
+	EXPECT_FALSE( ret.has_value() );
+	EXPECT_GE( tp_end - tp_start, std::chrono::milliseconds( 20 ) );
+}
+
+TEST( lfBlockingFifoTest, PushFromOtherThread_Then_PopWaitIsWokenUp )
+{
+	// Arrange
+	alpha::concurrent::blocking_fifo_list<int> sut;
+	auto                                       producer_func = [&sut]() {
+		std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+		sut.push( 1 );
+	};
+	std::thread th_producer( producer_func );
+
+	// Act
+	auto ret = sut.pop_wait();
+
+	// Assert
+	th_producer.join();
+	ASSERT_TRUE( ret.has_value() );
+	EXPECT_EQ( ret.value(), 1 );
+}
+
+TEST( lfBlockingFifoTest, Close_Then_WaitersAreWokenUpAfterDrain )
+{
+	// Arrange
+	constexpr int                              num_of_consumers = 4;
+	alpha::concurrent::blocking_fifo_list<int> sut;
+	std::atomic<int>                           count_popped( 0 );
+	std::vector<std::thread>                   ths;
+	for ( int i = 0; i < num_of_consumers; i++ ) {
+		ths.emplace_back( [&sut, &count_popped]() {
+			while ( sut.pop_wait().has_value() ) {
+				count_popped++;
+			}
+		} );
+	}
+	sut.push( 1 );
+	sut.push( 2 );
+	sut.push( 3 );
+
+	// Act
+	sut.close();
+	for ( auto& e : ths ) {
+		e.join();
+	}
+
+	// Assert
+	EXPECT_TRUE( sut.is_closed() );
+	EXPECT_FALSE( sut.push( 4 ) );
+	EXPECT_EQ( count_popped.load(), 3 );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST( lfBlockingFifoTest, PushPopWaitInParallel_Then_AllValuesArePopped )
+{
+	// Arrange
+	constexpr int                                    num_of_producers = 4;
+	constexpr int                                    num_of_consumers = 4;
+	constexpr int                                    num_of_values    = 20000;
+	alpha::concurrent::blocking_fifo_list<long long> sut;
+	std::atomic<long long>                           sum_popped( 0 );
+	std::vector<std::thread>                         ths_producer;
+	std::vector<std::thread>                         ths_consumer;
+
+	// Act
+	for ( int i = 0; i < num_of_consumers; i++ ) {
+		ths_consumer.emplace_back( [&sut, &sum_popped]() {
+			long long local_sum = 0;
+			while ( true ) {
+				auto ret = sut.pop_wait_for( std::chrono::milliseconds( 1 ) );
+				if ( ret.has_value() ) {
+					local_sum += ret.value();
+				} else if ( sut.is_closed() && sut.is_empty() ) {
+					break;
+				}
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( int i = 0; i < num_of_producers; i++ ) {
+		ths_producer.emplace_back( [&sut, i]() {
+			for ( int j = 0; j < num_of_values; j++ ) {
+				sut.push( static_cast<long long>( i ) * num_of_values + j );
+			}
+		} );
+	}
+	for ( auto& e : ths_producer ) {
+		e.join();
+	}
+	sut.close();
+	for ( auto& e : ths_consumer ) {
+		e.join();
+	}
+
+	// Assert
+	long long n = static_cast<long long>( num_of_producers ) * num_of_values;
+	EXPECT_EQ( sum_popped.load(), n * ( n - 1 ) / 2 );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST( lfBlockingFifoTest, CloseWhilePushing_Then_AllSucceededValuesArePoppedByPopWait )
+{
+	// Arrange
+	constexpr int                                    num_of_producers = 4;
+	constexpr int                                    num_of_consumers = 4;
+	alpha::concurrent::blocking_fifo_list<long long> sut;
+	std::atomic<long long>                           sum_pushed( 0 );
+	std::atomic<long long>                           sum_popped( 0 );
+	std::vector<std::thread>                         ths_producer;
+	std::vector<std::thread>                         ths_consumer;
+
+	for ( int i = 0; i < num_of_consumers; i++ ) {
+		ths_consumer.emplace_back( [&sut, &sum_popped]() {
+			long long local_sum = 0;
+			auto      ret       = sut.pop_wait();
+			while ( ret.has_value() ) {
+				local_sum += ret.value();
+				ret = sut.pop_wait();
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( int i = 0; i < num_of_producers; i++ ) {
+		ths_producer.emplace_back( [&sut, &sum_pushed]() {
+			long long local_sum = 0;
+			long long v         = 1;
+			while ( sut.push( v ) ) {
+				local_sum += v;
+				v++;
+			}
+			sum_pushed += local_sum;
+		} );
+	}
+
+	// Act
+	std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+	sut.close();
+	for ( auto& e : ths_producer ) {
+		e.join();
+	}
+	for ( auto& e : ths_consumer ) {
+		e.join();
+	}
+
+	// Assert
+	EXPECT_EQ( sum_popped.load(), sum_pushed.load() );
+	EXPECT_TRUE( sut.is_empty() );
+}
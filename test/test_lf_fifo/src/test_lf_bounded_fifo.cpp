@@ -0,0 +1,127 @@
+/**
+ * @file test_lf_bounded_fifo.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_bounded_fifo.hpp"
+
+TEST( lfBoundedFifoTest, CallPopFromEmpty )
+{
+	// Arrange
+	alpha::concurrent::bounded_fifo_list<int, 4> sut;
+
+	// Act
+	auto ret = sut.try_pop();
+
+	// Assert
+	EXPECT_FALSE( ret.has_value() );
+	EXPECT_TRUE( sut.is_empty() );
+	EXPECT_EQ( sut.capacity(), 4 );
+}
+
+TEST( lfBoundedFifoTest, PushUntilFull_Then_TryPushFailsAndOrderIsKept )
+{
+	// Arrange
+	alpha::concurrent::bounded_fifo_list<int, 4> sut;
+	for ( int i = 0; i < 4; i++ ) {
+		ASSERT_TRUE( sut.try_push( i ) );
+	}
+
+	// Act
+	bool ret_full = sut.try_push( 4 );
+
+	// Assert
+	EXPECT_FALSE( ret_full );
+	EXPECT_EQ( sut.count_size(), 4 );
+	for ( int i = 0; i < 4; i++ ) {
+		auto ret = sut.try_pop();
+		ASSERT_TRUE( ret.has_value() );
+		EXPECT_EQ( ret.value(), i );
+	}
+	EXPECT_TRUE( sut.try_push( 5 ) );   // 一周した後のセルも使える
+}
+
+TEST( lfBoundedFifoTest, RuntimeCapacity_Then_RoundedUpToPowerOf2 )
+{
+	// Arrange
+	alpha::concurrent::bounded_fifo_list<int> sut( 5 );
+
+	// Act
+	size_t ret = sut.capacity();
+
+	// Assert
+	EXPECT_EQ( ret, 8 );
+}
+
+TEST( lfBoundedFifoTest, MoveOnlyValue_Then_RemainedValueIsReleasedByDestructor )
+{
+	// Arrange
+	auto sp = std::make_shared<int>( 1 );
+	{
+		alpha::concurrent::bounded_fifo_list<std::unique_ptr<std::shared_ptr<int>>> sut( 4 );
+		sut.emplace( new std::shared_ptr<int>( sp ) );
+		sut.emplace( new std::shared_ptr<int>( sp ) );
+
+		// Act
+		auto ret = sut.pop();
+
+		// Assert
+		ASSERT_TRUE( ret.has_value() );
+		EXPECT_EQ( **( ret.value() ), 1 );
+		EXPECT_EQ( sp.use_count(), 3 );
+	}
+	EXPECT_EQ( sp.use_count(), 1 );
+}
+
+TEST( lfBoundedFifoTest, HighLoadPushPop_Then_SumIsKept )
+{
+	// Arrange
+	constexpr int num_of_threads = 4;
+	constexpr int num_of_loop    = 20000;
+
+	alpha::concurrent::bounded_fifo_list<size_t, 64> sut;
+	std::atomic<size_t>                              sum_popped( 0 );
+
+	// Act
+	std::vector<std::thread> workers;
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		workers.emplace_back( [&sut, &sum_popped]() {
+			size_t local_sum = 0;
+			for ( size_t j = 1; j <= num_of_loop; j++ ) {
+				while ( !sut.try_push( j ) ) {
+					std::this_thread::yield();
+				}
+				while ( true ) {
+					auto ret = sut.try_pop();
+					if ( ret.has_value() ) {
+						local_sum += ret.value();
+						break;
+					}
+					std::this_thread::yield();
+				}
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( auto& t : workers ) {
+		t.join();
+	}
+
+	// Assert
+	constexpr size_t expected_sum_per_thread = static_cast<size_t>( num_of_loop ) * ( num_of_loop + 1 ) / 2;
+	EXPECT_EQ( sum_popped.load(), expected_sum_per_thread * num_of_threads );
+	EXPECT_TRUE( sut.is_empty() );
+}
@@ -7,17 +7,28 @@
 //============================================================================
 
 #include <pthread.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <deque>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
+#include "alconcurrent/dynamic_tls.hpp"
+#include "alconcurrent/internal/ebr_domain.hpp"
 #include "alconcurrent/lf_fifo.hpp"
 #include "alconcurrent/lf_mem_alloc.hpp"
 
@@ -198,3 +209,336 @@ TEST_F( lffifoTest, FixedArray2 )
 
 	std::cout << "End Array array_test[2] test" << std::endl;
 }
+
+TEST_F( lffifoTest, PushRange_Then_PopBulkKeepsOrder )
+{
+	// Arrange
+	test_fifo_type              sut;
+	std::vector<std::uintptr_t> src { 1, 2, 3, 4, 5 };
+	std::vector<std::uintptr_t> dst;
+
+	// Act
+	sut.push_range( src.begin(), src.begin() );   // 空の範囲は何もしない
+	sut.push_range( src.begin(), src.end() );
+	sut.push( 6 );
+	size_t ret1 = sut.pop_bulk( std::back_inserter( dst ), 3 );
+	size_t ret2 = sut.pop_bulk( std::back_inserter( dst ), 10 );
+	size_t ret3 = sut.pop_bulk( std::back_inserter( dst ), 10 );
+
+	// Assert
+	EXPECT_EQ( ret1, 3 );
+	EXPECT_EQ( ret2, 3 );
+	EXPECT_EQ( ret3, 0 );
+	EXPECT_EQ( dst, ( std::vector<std::uintptr_t> { 1, 2, 3, 4, 5, 6 } ) );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+namespace {
+struct throw_on_copy_value {
+	static std::atomic<int> live_count_;   //!< number of live instances
+
+	explicit throw_on_copy_value( int v = 0 )
+	  : v_( v )
+	{
+		live_count_++;
+	}
+	throw_on_copy_value( const throw_on_copy_value& src )
+	  : v_( src.v_ )
+	{
+		if ( v_ < 0 ) throw std::runtime_error( "throw_on_copy_value" );
+		live_count_++;
+	}
+	throw_on_copy_value& operator=( const throw_on_copy_value& src )
+	{
+		if ( src.v_ < 0 ) throw std::runtime_error( "throw_on_copy_value" );
+		v_ = src.v_;
+		return *this;
+	}
+	~throw_on_copy_value()
+	{
+		live_count_--;
+	}
+
+	int v_;
+};
+std::atomic<int> throw_on_copy_value::live_count_( 0 );
+}   // namespace
+
+TEST_F( lffifoTest, PushRangeThrowsInTheMiddle_Then_NoValueIsPushedAndNoNodeIsLeaked )
+{
+	// Arrange
+	alpha::concurrent::fifo_list<throw_on_copy_value> sut;
+	std::vector<throw_on_copy_value>                  src;
+	src.emplace_back( 1 );
+	src.emplace_back( 2 );
+	src.emplace_back( -1 );
+	src.emplace_back( 4 );
+
+	// Act
+	EXPECT_THROW( sut.push_range( src.begin(), src.end() ), std::runtime_error );
+
+	// Assert
+	// 途中まで確保したノードが持つ値は、ノードの回収時に破棄される。
+	EXPECT_TRUE( sut.is_empty() );
+	EXPECT_EQ( throw_on_copy_value::live_count_.load(), static_cast<int>( src.size() ) );
+
+	sut.push_range( src.begin(), src.begin() + 2 );
+	auto ret1 = sut.pop();
+	auto ret2 = sut.pop();
+	ASSERT_TRUE( ret1.has_value() );
+	ASSERT_TRUE( ret2.has_value() );
+	EXPECT_EQ( ret1.value().v_, 1 );
+	EXPECT_EQ( ret2.value().v_, 2 );
+	EXPECT_FALSE( sut.pop().has_value() );
+}
+
+TEST_F( lffifoTest, PushRangeAndPopBulkInParallel_Then_SumIsSame )
+{
+	// Arrange
+	constexpr int            num_of_threads = 8;
+	constexpr int            loop_num_bulk  = 20000;
+	test_fifo_type           sut;
+	std::atomic<std::size_t> sum_popped( 0 );
+	std::vector<std::thread> ths;
+
+	// Act
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		ths.emplace_back( [&sut, &sum_popped]() {
+			std::array<std::uintptr_t, 4> src { 1, 1, 1, 1 };
+			std::array<std::uintptr_t, 4> dst;
+			std::size_t                   local_sum = 0;
+			for ( int j = 0; j < loop_num_bulk; j++ ) {
+				sut.push_range( src.begin(), src.end() );
+				size_t n = sut.pop_bulk( dst.begin(), dst.size() );
+				for ( size_t k = 0; k < n; k++ ) {
+					local_sum += dst[k];
+				}
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+	auto ret = sut.pop();
+	while ( ret.has_value() ) {
+		sum_popped += ret.value();
+		ret = sut.pop();
+	}
+
+	// Assert
+	EXPECT_EQ( sum_popped.load(), static_cast<std::size_t>( num_of_threads ) * loop_num_bulk * 4 );
+}
+
+namespace {
+struct no_default_ctor_value {
+	explicit no_default_ctor_value( int v )
+	  : v_( v )
+	{
+	}
+
+	int v_;
+};
+}   // namespace
+
+TEST_F( lffifoTest, NoDefaultConstructibleValue_Then_CanPushPop )
+{
+	// Arrange
+	alpha::concurrent::fifo_list<no_default_ctor_value> sut;
+	std::vector<no_default_ctor_value>                  dst;
+
+	// Act
+	sut.push( no_default_ctor_value( 1 ) );
+	sut.emplace( 2 );
+	sut.emplace( 3 );
+	auto   ret1 = sut.pop();
+	size_t ret2 = sut.pop_bulk( std::back_inserter( dst ), 10 );
+	auto   ret3 = sut.pop();
+
+	// Assert
+	ASSERT_TRUE( ret1.has_value() );
+	EXPECT_EQ( ret1.value().v_, 1 );
+	ASSERT_EQ( ret2, 2 );
+	EXPECT_EQ( dst[0].v_, 2 );
+	EXPECT_EQ( dst[1].v_, 3 );
+	EXPECT_FALSE( ret3.has_value() );
+}
+
+TEST_F( lffifoTest, PushPopVariation_Then_ApproximateSizeIsSameToCountSize )
+{
+	// Arrange
+	test_fifo_type              sut;
+	std::vector<std::uintptr_t> src { 1, 2, 3, 4, 5 };
+	std::vector<std::uintptr_t> dst;
+	EXPECT_EQ( sut.approximate_size(), 0 );
+
+	// Act
+	sut.push( 0 );
+	sut.push_range( src.begin(), src.end() );
+	sut.push_head( 6 );
+	sut.emplace( 7 );
+	EXPECT_EQ( sut.approximate_size(), 8 );
+	sut.pop();
+	sut.pop_bulk( std::back_inserter( dst ), 3 );
+
+	// Assert
+	EXPECT_EQ( sut.approximate_size(), 4 );
+	EXPECT_EQ( sut.approximate_size(), sut.count_size() );
+}
+
+TEST_F( lffifoTest, PushPopInParallel_Then_ApproximateSizeIsZero )
+{
+	// Arrange
+	constexpr int            num_of_threads   = 8;
+	constexpr int            loop_num_pushpop = 20000;
+	test_fifo_type           sut;
+	std::vector<std::thread> ths;
+
+	// Act
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		ths.emplace_back( [&sut]() {
+			for ( int j = 0; j < loop_num_pushpop; j++ ) {
+				sut.push( 1 );
+				sut.pop();
+			}
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+
+	// Assert
+	EXPECT_EQ( sut.approximate_size(), 0 );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+static void delete_int_for_fork_test( void* p )
+{
+	delete static_cast<int*>( p );
+}
+
+static int child_main_for_fork_test( void )
+{
+	alarm( 10 );   // if a mutex that is inherited in locked state is taken, the child process is killed by SIGALRM
+
+	void* p_mem = alpha::concurrent::gmem_allocate( 128 );
+	if ( p_mem == nullptr ) return 1;
+	if ( !alpha::concurrent::gmem_deallocate( p_mem ) ) return 2;
+
+	alpha::concurrent::internal::hazard_ptr_mgr::Retire( new int( 1 ), delete_int_for_fork_test );
+	alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+	alpha::concurrent::internal::ebr_domain::Retire( new int( 2 ), delete_int_for_fork_test );
+	alpha::concurrent::internal::ebr_domain::DrainRetired();
+	{
+		alpha::concurrent::dynamic_tls<int> dtls;   // destructor takes the mutex of dynamic_tls
+	}
+
+	int         ret = 0;
+	std::thread th( [&ret]() {
+		test_fifo_type fifo;
+		fifo.push( 1 );
+		fifo.push( 2 );
+		auto v1 = fifo.pop();
+		auto v2 = fifo.pop();
+		if ( !v1.has_value() || ( v1.value() != 1 ) ) ret = 3;
+		if ( !v2.has_value() || ( v2.value() != 2 ) ) ret = 4;
+	} );
+	th.join();   // thread exit takes the mutex of dynamic_tls and the orphan lists
+	return ret;
+}
+
+TEST_F( lffifoTest, OtherThreadsTakeGlobalLocks_DoFork_Then_ChildCanAllocateRetireAndPop )
+{
+	// Arrange
+	constexpr int            num_of_lock_threads = 2;
+	constexpr int            num_of_forks        = 20;
+	std::atomic<bool>        is_running( true );
+	std::vector<std::thread> ths;
+	for ( int i = 0; i < num_of_lock_threads; i++ ) {
+		ths.emplace_back( [&is_running]() {
+			while ( is_running.load() ) {
+				// 短命なスレッドの終了処理と、DrainRetired()で、ライブラリのグローバルなmutexを繰り返し取得する。
+				std::thread th( []() {
+					test_fifo_type fifo;
+					fifo.push( 1 );
+					fifo.pop();
+					alpha::concurrent::internal::hazard_ptr_mgr::Retire( new int( 1 ), delete_int_for_fork_test );
+					alpha::concurrent::internal::ebr_domain::Retire( new int( 2 ), delete_int_for_fork_test );
+				} );
+				th.join();
+				alpha::concurrent::internal::hazard_ptr_mgr::DrainRetired();
+				alpha::concurrent::internal::ebr_domain::DrainRetired();
+			}
+		} );
+	}
+
+	// Act
+	for ( int i = 0; i < num_of_forks; i++ ) {
+		// 確実にロック保持中のfork()を検査するため、dynamic_tlsのmutexは別スレッドが保持した状態でfork()する。
+		std::atomic<bool> is_locked( false );
+		std::thread       th_holder( [&is_locked]() {
+			std::lock_guard<std::recursive_mutex> lg( alpha::concurrent::dynamic_tls_global_exclusive_control_for_destructions );
+			is_locked.store( true );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+		} );
+		while ( !is_locked.load() ) {
+			std::this_thread::yield();
+		}
+		pid_t pid = fork();
+		th_holder.join();
+		if ( pid == 0 ) {
+			_exit( child_main_for_fork_test() );
+		}
+
+		// Assert
+		ASSERT_GT( pid, 0 );
+		int status = 0;
+		EXPECT_EQ( waitpid( pid, &status, 0 ), pid );
+		EXPECT_TRUE( WIFEXITED( status ) );
+		EXPECT_EQ( WEXITSTATUS( status ), 0 );
+	}
+
+	// Cleanup
+	is_running.store( false );
+	for ( auto& e : ths ) {
+		e.join();
+	}
+}
+
+TEST_F( lffifoTest, OtherThreadIsInEbrCriticalSection_DoFork_Then_ChildCanAdvanceEpoch )
+{
+	// Arrange
+	std::atomic<bool> is_entered( false );
+	std::atomic<bool> is_running( true );
+	std::thread       th_guard_holder( [&is_entered, &is_running]() {
+		alpha::concurrent::internal::ebr_domain::critical_section cs;
+		is_entered.store( true );
+		while ( is_running.load() ) {
+			std::this_thread::yield();
+		}
+	} );
+	while ( !is_entered.load() ) {
+		std::this_thread::yield();
+	}
+
+	// Act
+	pid_t pid = fork();
+	if ( pid == 0 ) {
+		alarm( 10 );
+		// fork()元のスレッドのクリティカルセクションが残っていると、エポックが進まず、退避したポインタを解放できない。
+		std::uint64_t epoch_before = alpha::concurrent::internal::ebr_domain::GetGlobalEpoch();
+		alpha::concurrent::internal::ebr_domain::Retire( new int( 1 ), delete_int_for_fork_test );
+		if ( alpha::concurrent::internal::ebr_domain::DrainRetired() != 0 ) _exit( 1 );
+		if ( alpha::concurrent::internal::ebr_domain::GetGlobalEpoch() < ( epoch_before + 2 ) ) _exit( 2 );
+		_exit( 0 );
+	}
+	is_running.store( false );
+	th_guard_holder.join();
+
+	// Assert
+	ASSERT_GT( pid, 0 );
+	int status = 0;
+	EXPECT_EQ( waitpid( pid, &status, 0 ), pid );
+	EXPECT_TRUE( WIFEXITED( status ) );
+	EXPECT_EQ( WEXITSTATUS( status ), 0 );
+}
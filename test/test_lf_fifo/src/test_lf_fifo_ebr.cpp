@@ -0,0 +1,242 @@
+/**
+ * @file test_lf_fifo_ebr.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_fifo.hpp"
+
+using ebr_fifo_int = alpha::concurrent::fifo_list<int, alpha::concurrent::epoch_based_reclamation>;
+
+class lfFifoEbrTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+	}
+
+	void TearDown() override
+	{
+		alpha::concurrent::internal::ebr_domain::DrainRetired();
+	}
+};
+
+TEST_F( lfFifoEbrTest, CallPopFromEmpty )
+{
+	// Arrange
+	ebr_fifo_int sut;
+
+	// Act
+	auto ret = sut.pop();
+
+	// Assert
+	EXPECT_FALSE( ret.has_value() );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST_F( lfFifoEbrTest, CallPushPopTwo )
+{
+	// Arrange
+	ebr_fifo_int sut;
+
+	// Act
+	sut.push( 1 );
+	sut.push( 2 );
+	EXPECT_EQ( sut.count_size(), 2 );
+	auto ret1 = sut.pop();
+	auto ret2 = sut.pop();
+
+	// Assert
+	ASSERT_TRUE( ret1.has_value() );
+	EXPECT_EQ( ret1.value(), 1 );
+	ASSERT_TRUE( ret2.has_value() );
+	EXPECT_EQ( ret2.value(), 2 );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST_F( lfFifoEbrTest, PushPopInParallel_Then_SumIsSame )
+{
+	// Arrange
+	constexpr int            num_of_threads = 8;
+	constexpr int            loop_num       = 100000;
+	ebr_fifo_int             sut;
+	std::atomic<long long>   sum_popped( 0 );
+	std::vector<std::thread> ths;
+
+	// Act
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		ths.emplace_back( [&sut, &sum_popped]() {
+			long long local_sum = 0;
+			for ( int j = 0; j < loop_num; j++ ) {
+				sut.push( 1 );
+				auto ret = sut.pop();
+				if ( ret.has_value() ) {
+					local_sum += ret.value();
+				}
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+	auto ret = sut.pop();
+	while ( ret.has_value() ) {
+		sum_popped += ret.value();
+		ret = sut.pop();
+	}
+
+	// Assert
+	EXPECT_EQ( sum_popped.load(), static_cast<long long>( num_of_threads ) * loop_num );
+	EXPECT_EQ( sut.get_allocated_num(), 1 );
+	EXPECT_EQ( alpha::concurrent::internal::ebr_domain::DrainRetired(), 0 );
+}
+
+TEST_F( lfFifoEbrTest, PushRange_Then_PopBulkKeepsOrder )
+{
+	// Arrange
+	ebr_fifo_int     sut;
+	std::vector<int> src { 1, 2, 3, 4, 5 };
+	std::vector<int> dst;
+
+	// Act
+	sut.push_range( src.begin(), src.end() );
+	EXPECT_EQ( sut.count_size(), 5 );
+	size_t ret1 = sut.pop_bulk( std::back_inserter( dst ), 2 );
+	size_t ret2 = sut.pop_bulk( std::back_inserter( dst ), 10 );
+	size_t ret3 = sut.pop_bulk( std::back_inserter( dst ), 10 );
+
+	// Assert
+	EXPECT_EQ( ret1, 2 );
+	EXPECT_EQ( ret2, 3 );
+	EXPECT_EQ( ret3, 0 );
+	EXPECT_EQ( dst, ( std::vector<int> { 1, 2, 3, 4, 5 } ) );
+	EXPECT_EQ( sut.get_allocated_num(), 1 );
+}
+
+namespace {
+struct throw_on_copy_value {
+	static std::atomic<int> live_count_;   //!< number of live instances
+
+	explicit throw_on_copy_value( int v = 0 )
+	  : v_( v )
+	{
+		live_count_++;
+	}
+	throw_on_copy_value( const throw_on_copy_value& src )
+	  : v_( src.v_ )
+	{
+		if ( v_ < 0 ) throw std::runtime_error( "throw_on_copy_value" );
+		live_count_++;
+	}
+	throw_on_copy_value& operator=( const throw_on_copy_value& src )
+	{
+		if ( src.v_ < 0 ) throw std::runtime_error( "throw_on_copy_value" );
+		v_ = src.v_;
+		return *this;
+	}
+	~throw_on_copy_value()
+	{
+		live_count_--;
+	}
+
+	int v_;
+};
+std::atomic<int> throw_on_copy_value::live_count_( 0 );
+}   // namespace
+
+TEST_F( lfFifoEbrTest, PushRangeThrowsInTheMiddle_Then_NoValueIsPushedAndNoNodeIsLeaked )
+{
+	// Arrange
+	std::vector<throw_on_copy_value> src;
+	src.emplace_back( 1 );
+	src.emplace_back( 2 );
+	src.emplace_back( -1 );
+	src.emplace_back( 4 );
+	{
+		alpha::concurrent::fifo_list<throw_on_copy_value, alpha::concurrent::epoch_based_reclamation> sut;
+
+		// Act
+		EXPECT_THROW( sut.push_range( src.begin(), src.end() ), std::runtime_error );
+
+		// Assert
+		EXPECT_TRUE( sut.is_empty() );
+		EXPECT_EQ( sut.get_allocated_num(), 1 );
+	}
+	// 途中まで確保したノードは、例外を伝える前に解放されている。
+	EXPECT_EQ( throw_on_copy_value::live_count_.load(), static_cast<int>( src.size() ) );
+}
+
+TEST_F( lfFifoEbrTest, PushRangeAndPopBulkInParallel_Then_SumIsSame )
+{
+	// Arrange
+	constexpr int            num_of_threads = 8;
+	constexpr int            loop_num       = 20000;
+	ebr_fifo_int             sut;
+	std::atomic<long long>   sum_popped( 0 );
+	std::vector<std::thread> ths;
+
+	// Act
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		ths.emplace_back( [&sut, &sum_popped]() {
+			std::array<int, 4> src { 1, 1, 1, 1 };
+			std::array<int, 4> dst;
+			long long          local_sum = 0;
+			for ( int j = 0; j < loop_num; j++ ) {
+				sut.push_range( src.begin(), src.end() );
+				size_t n = sut.pop_bulk( dst.begin(), dst.size() );
+				for ( size_t k = 0; k < n; k++ ) {
+					local_sum += dst[k];
+				}
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+	std::array<int, 16> dst;
+	size_t              n = sut.pop_bulk( dst.begin(), dst.size() );
+	while ( n > 0 ) {
+		for ( size_t k = 0; k < n; k++ ) {
+			sum_popped += dst[k];
+		}
+		n = sut.pop_bulk( dst.begin(), dst.size() );
+	}
+
+	// Assert
+	EXPECT_EQ( sum_popped.load(), static_cast<long long>( num_of_threads ) * loop_num * 4 );
+	EXPECT_EQ( sut.get_allocated_num(), 1 );
+}
+
+TEST_F( lfFifoEbrTest, PushPopVariation_Then_ApproximateSizeIsSameToCountSize )
+{
+	// Arrange
+	ebr_fifo_int     sut;
+	std::vector<int> src { 1, 2, 3, 4, 5 };
+	std::vector<int> dst;
+
+	// Act
+	sut.push( 0 );
+	sut.push_range( src.begin(), src.end() );
+	EXPECT_EQ( sut.approximate_size(), 6 );
+	sut.pop();
+	sut.pop_bulk( std::back_inserter( dst ), 2 );
+
+	// Assert
+	EXPECT_EQ( sut.approximate_size(), 3 );
+	EXPECT_EQ( sut.approximate_size(), sut.count_size() );
+}
@@ -0,0 +1,160 @@
+/**
+ * @file test_lf_mpsc_fifo.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_mpsc_fifo.hpp"
+
+namespace {
+
+struct test_msg : public alpha::concurrent::mpsc_fifo_hook {
+	int v_;
+
+	explicit test_msg( int v )
+	  : v_( v )
+	{
+	}
+};
+
+}   // namespace
+
+TEST( lfMpscFifoTest, IntrusivePushPop_Then_OrderIsKept )
+{
+	// Arrange
+	alpha::concurrent::intrusive_mpsc_fifo<test_msg> sut;
+	test_msg                                         msg1( 1 );
+	test_msg                                         msg2( 2 );
+
+	// Act
+	sut.push( &msg1 );
+	sut.push( &msg2 );
+	test_msg* p_ret1 = sut.pop();
+	test_msg* p_ret2 = sut.pop();
+	test_msg* p_ret3 = sut.pop();
+
+	// Assert
+	EXPECT_EQ( p_ret1, &msg1 );
+	EXPECT_EQ( p_ret2, &msg2 );
+	EXPECT_EQ( p_ret3, nullptr );
+	EXPECT_TRUE( sut.is_empty() );
+
+	// 取り出した後は、再度pushできる
+	sut.push( &msg1 );
+	EXPECT_EQ( sut.pop(), &msg1 );
+}
+
+TEST( lfMpscFifoTest, IntrusiveConsumeAll_Then_AllObjectsAreConsumedInOrder )
+{
+	// Arrange
+	alpha::concurrent::intrusive_mpsc_fifo<test_msg> sut;
+	std::vector<test_msg>                            msgs;
+	for ( int i = 0; i < 10; i++ ) {
+		msgs.emplace_back( i );
+	}
+	for ( auto& e : msgs ) {
+		sut.push( &e );
+	}
+
+	// Act
+	int    expect = 0;
+	bool   is_ok  = true;
+	size_t ret    = sut.consume_all( [&expect, &is_ok]( test_msg* p ) {
+		if ( p->v_ != expect ) is_ok = false;
+		expect++;
+	} );
+
+	// Assert
+	EXPECT_EQ( ret, 10 );
+	EXPECT_TRUE( is_ok );
+	EXPECT_EQ( sut.pop(), nullptr );
+}
+
+TEST( lfMpscFifoTest, ValuePushPop_Then_OrderIsKept )
+{
+	// Arrange
+	alpha::concurrent::mpsc_fifo<std::unique_ptr<int>> sut;
+
+	// Act
+	sut.push( std::unique_ptr<int>( new int( 1 ) ) );
+	sut.emplace( new int( 2 ) );
+	auto ret1 = sut.pop();
+	auto ret2 = sut.pop();
+	auto ret3 = sut.pop();
+
+	// Assert
+	ASSERT_TRUE( ret1.has_value() );
+	ASSERT_TRUE( ret2.has_value() );
+	EXPECT_EQ( *( ret1.value() ), 1 );
+	EXPECT_EQ( *( ret2.value() ), 2 );
+	EXPECT_FALSE( ret3.has_value() );
+}
+
+TEST( lfMpscFifoTest, DestructWithRemainedValue_Then_ValueIsReleased )
+{
+	// Arrange
+	auto sp = std::make_shared<int>( 1 );
+	{
+		alpha::concurrent::mpsc_fifo<std::shared_ptr<int>> sut;
+
+		// Act
+		sut.push( sp );
+		sut.push( sp );
+		EXPECT_EQ( sp.use_count(), 3 );
+	}
+
+	// Assert
+	EXPECT_EQ( sp.use_count(), 1 );
+}
+
+TEST( lfMpscFifoTest, ManyProducersOneConsumer_Then_OrderPerProducerIsKept )
+{
+	// Arrange
+	constexpr int                     num_of_producers = 4;
+	constexpr int                     num_of_values    = 20000;
+	alpha::concurrent::mpsc_fifo<int> sut;
+	std::vector<std::thread>          producers;
+	std::vector<int>                  last_values( num_of_producers, -1 );
+	bool                              is_ok = true;
+
+	// Act
+	for ( int i = 0; i < num_of_producers; i++ ) {
+		producers.emplace_back( [&sut, i]() {
+			for ( int j = 0; j < num_of_values; j++ ) {
+				sut.push( i * num_of_values + j );
+			}
+		} );
+	}
+	int count = 0;
+	while ( count < num_of_producers * num_of_values ) {
+		size_t n = sut.consume_all( [&last_values, &is_ok, &count]( int&& v ) {
+			int producer_id = v / num_of_values;
+			int seq         = v % num_of_values;
+			if ( last_values[static_cast<size_t>( producer_id )] + 1 != seq ) is_ok = false;
+			last_values[static_cast<size_t>( producer_id )] = seq;
+			count++;
+		} );
+		if ( n == 0 ) {
+			std::this_thread::yield();
+		}
+	}
+	for ( auto& t : producers ) {
+		t.join();
+	}
+
+	// Assert
+	EXPECT_TRUE( is_ok );
+	EXPECT_FALSE( sut.pop().has_value() );
+}
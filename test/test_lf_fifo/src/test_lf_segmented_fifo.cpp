@@ -0,0 +1,135 @@
+/**
+ * @file test_lf_segmented_fifo.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_segmented_fifo.hpp"
+
+TEST( lfSegmentedFifoTest, PushOverSegments_Then_OrderIsKept )
+{
+	// Arrange
+	alpha::concurrent::segmented_fifo_list<int, 4> sut;
+
+	// Act
+	for ( int i = 0; i < 10; i++ ) {
+		sut.push( i );
+	}
+
+	// Assert
+	EXPECT_FALSE( sut.is_empty() );
+	EXPECT_EQ( sut.count_size(), 10 );
+	for ( int i = 0; i < 10; i++ ) {
+		auto ret = sut.pop();
+		ASSERT_TRUE( ret.has_value() );
+		EXPECT_EQ( ret.value(), i );
+	}
+	EXPECT_FALSE( sut.pop().has_value() );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST( lfSegmentedFifoTest, PopFromEmpty_Then_PushIsStillPopped )
+{
+	// Arrange
+	alpha::concurrent::segmented_fifo_list<std::unique_ptr<int>, 2> sut;
+
+	// Act
+	auto ret1 = sut.pop();
+	sut.emplace( new int( 1 ) );
+	sut.push( std::unique_ptr<int>( new int( 2 ) ) );
+	sut.emplace( new int( 3 ) );
+	auto ret2 = sut.pop();
+	auto ret3 = sut.pop();
+	auto ret4 = sut.pop();
+
+	// Assert
+	EXPECT_FALSE( ret1.has_value() );
+	ASSERT_TRUE( ret2.has_value() );
+	ASSERT_TRUE( ret3.has_value() );
+	ASSERT_TRUE( ret4.has_value() );
+	EXPECT_EQ( *( ret2.value() ), 1 );
+	EXPECT_EQ( *( ret3.value() ), 2 );
+	EXPECT_EQ( *( ret4.value() ), 3 );
+}
+
+TEST( lfSegmentedFifoTest, DestructWithRemainedValue_Then_ValueIsReleased )
+{
+	// Arrange
+	auto sp = std::make_shared<int>( 1 );
+	{
+		alpha::concurrent::segmented_fifo_list<std::shared_ptr<int>, 2> sut;
+
+		// Act
+		for ( int i = 0; i < 5; i++ ) {
+			sut.push( sp );
+		}
+		sut.pop();
+		EXPECT_EQ( sp.use_count(), 5 );
+	}
+
+	// Assert
+	EXPECT_EQ( sp.use_count(), 1 );
+}
+
+TEST( lfSegmentedFifoTest, PushPopInParallel_Then_OrderPerProducerIsKept )
+{
+	// Arrange
+	constexpr int                                         num_of_producers = 4;
+	constexpr int                                         num_of_consumers = 4;
+	constexpr int                                         num_of_values    = 50000;
+	alpha::concurrent::segmented_fifo_list<long long, 64> sut;
+	std::atomic<long long>                                sum_popped( 0 );
+	std::atomic<int>                                      count_popped( 0 );
+	std::atomic<bool>                                     is_ok( true );
+	std::vector<std::thread>                              ths;
+
+	// Act
+	for ( int i = 0; i < num_of_producers; i++ ) {
+		ths.emplace_back( [&sut, i]() {
+			for ( int j = 0; j < num_of_values; j++ ) {
+				sut.push( static_cast<long long>( i ) * num_of_values + j );
+			}
+		} );
+	}
+	for ( int i = 0; i < num_of_consumers; i++ ) {
+		ths.emplace_back( [&sut, &sum_popped, &count_popped, &is_ok]() {
+			std::vector<long long> last_values( num_of_producers, -1 );
+			long long              local_sum = 0;
+			while ( count_popped.load() < num_of_producers * num_of_values ) {
+				auto ret = sut.pop();
+				if ( !ret.has_value() ) {
+					std::this_thread::yield();
+					continue;
+				}
+				size_t    producer_id = static_cast<size_t>( ret.value() / num_of_values );
+				long long seq         = ret.value() % num_of_values;
+				if ( last_values[producer_id] >= seq ) is_ok.store( false );
+				last_values[producer_id] = seq;
+				local_sum += ret.value();
+				count_popped++;
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+
+	// Assert
+	long long n = static_cast<long long>( num_of_producers ) * num_of_values;
+	EXPECT_TRUE( is_ok.load() );
+	EXPECT_EQ( sum_popped.load(), n * ( n - 1 ) / 2 );
+	EXPECT_TRUE( sut.is_empty() );
+}
@@ -0,0 +1,192 @@
+/**
+ * @file test_lf_spsc_fifo.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_spsc_fifo.hpp"
+
+TEST( lfSpscFifoTest, PushUntilFull_Then_TryPushFailsAndOrderIsKept )
+{
+	// Arrange
+	alpha::concurrent::spsc_fifo<int, 4> sut;
+	for ( int i = 0; i < 4; i++ ) {
+		ASSERT_TRUE( sut.try_push( i ) );
+	}
+
+	// Act
+	bool ret_full = sut.try_push( 4 );
+
+	// Assert
+	EXPECT_FALSE( ret_full );
+	EXPECT_EQ( sut.count_size(), 4 );
+	for ( int i = 0; i < 4; i++ ) {
+		auto ret = sut.try_pop();
+		ASSERT_TRUE( ret.has_value() );
+		EXPECT_EQ( ret.value(), i );
+	}
+	EXPECT_FALSE( sut.try_pop().has_value() );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST( lfSpscFifoTest, PushBulkOverCapacity_Then_PartiallyPushed )
+{
+	// Arrange
+	alpha::concurrent::spsc_fifo<int> sut( 5 );   // 8に切り上げられる
+	std::array<int, 10>               src { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	std::array<int, 10>               dst {};
+
+	// Act
+	size_t ret_push = sut.push_bulk( src.begin(), src.size() );
+	size_t ret_pop  = sut.pop_bulk( dst.begin(), 3 );
+
+	// Assert
+	EXPECT_EQ( sut.capacity(), 8 );
+	EXPECT_EQ( ret_push, 8 );
+	EXPECT_EQ( ret_pop, 3 );
+	EXPECT_EQ( dst[0], 0 );
+	EXPECT_EQ( dst[2], 2 );
+	EXPECT_EQ( sut.count_size(), 5 );
+}
+
+TEST( lfSpscFifoTest, DestructWithRemainedValue_Then_ValueIsReleased )
+{
+	// Arrange
+	auto sp = std::make_shared<int>( 1 );
+	{
+		alpha::concurrent::spsc_fifo<std::shared_ptr<int>, 4> sut;
+
+		// Act
+		sut.try_push( sp );
+		sut.try_push( sp );
+		EXPECT_EQ( sp.use_count(), 3 );
+	}
+
+	// Assert
+	EXPECT_EQ( sp.use_count(), 1 );
+}
+
+TEST( lfSpscFifoTest, ProducerAndConsumerThread_Then_OrderIsKept )
+{
+	// Arrange
+	constexpr size_t                         num_of_values = 100000;
+	alpha::concurrent::spsc_fifo<size_t, 64> sut;
+	bool                                     is_ok = true;
+
+	// Act
+	std::thread producer( [&sut]() {
+		for ( size_t i = 0; i < num_of_values; i++ ) {
+			while ( !sut.try_push( i ) ) {
+				std::this_thread::yield();
+			}
+		}
+	} );
+	std::thread consumer( [&sut, &is_ok]() {
+		size_t expect = 0;
+		while ( expect < num_of_values ) {
+			std::array<size_t, 16> buff;
+			size_t                 n = sut.pop_bulk( buff.begin(), buff.size() );
+			if ( n == 0 ) {
+				std::this_thread::yield();
+				continue;
+			}
+			for ( size_t i = 0; i < n; i++, expect++ ) {
+				if ( buff[i] != expect ) is_ok = false;
+			}
+		}
+	} );
+	producer.join();
+	consumer.join();
+
+	// Assert
+	EXPECT_TRUE( is_ok );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST( lfSpscUnboundedFifoTest, PushOverSegments_Then_OrderIsKept )
+{
+	// Arrange
+	alpha::concurrent::spsc_unbounded_fifo<int, 4> sut;
+	std::vector<int>                               src { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+	// Act
+	sut.push_bulk( src.begin(), src.size() );
+	sut.push( 10 );
+
+	// Assert
+	std::array<int, 6> dst {};
+	EXPECT_EQ( sut.pop_bulk( dst.begin(), dst.size() ), 6 );
+	EXPECT_EQ( dst[5], 5 );
+	for ( int i = 6; i <= 10; i++ ) {
+		auto ret = sut.try_pop();
+		ASSERT_TRUE( ret.has_value() );
+		EXPECT_EQ( ret.value(), i );
+	}
+	EXPECT_FALSE( sut.try_pop().has_value() );
+}
+
+TEST( lfSpscUnboundedFifoTest, DestructWithRemainedValue_Then_ValueIsReleased )
+{
+	// Arrange
+	auto sp = std::make_shared<int>( 1 );
+	{
+		alpha::concurrent::spsc_unbounded_fifo<std::shared_ptr<int>, 2> sut;
+
+		// Act
+		for ( int i = 0; i < 5; i++ ) {
+			sut.push( sp );
+		}
+		sut.try_pop();
+		sut.try_pop();
+		sut.try_pop();
+		EXPECT_EQ( sp.use_count(), 3 );
+	}
+
+	// Assert
+	EXPECT_EQ( sp.use_count(), 1 );
+}
+
+TEST( lfSpscUnboundedFifoTest, ProducerAndConsumerThread_Then_OrderIsKept )
+{
+	// Arrange
+	constexpr size_t                                   num_of_values = 100000;
+	alpha::concurrent::spsc_unbounded_fifo<size_t, 16> sut;
+	bool                                               is_ok = true;
+
+	// Act
+	std::thread producer( [&sut]() {
+		for ( size_t i = 0; i < num_of_values; i++ ) {
+			sut.push( i );
+		}
+	} );
+	std::thread consumer( [&sut, &is_ok]() {
+		size_t expect = 0;
+		while ( expect < num_of_values ) {
+			auto ret = sut.try_pop();
+			if ( !ret.has_value() ) {
+				std::this_thread::yield();
+				continue;
+			}
+			if ( ret.value() != expect ) is_ok = false;
+			expect++;
+		}
+	} );
+	producer.join();
+	consumer.join();
+
+	// Assert
+	EXPECT_TRUE( is_ok );
+	EXPECT_FALSE( sut.try_pop().has_value() );
+}
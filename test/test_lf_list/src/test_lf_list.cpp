@@ -116,6 +116,31 @@ TEST_F( Test_lockfree_list, Empty_DoRemoveOneIf_ThenEmpty )
 	EXPECT_EQ( sut_.count_size(), 0 );
 }
 
+TEST_F( Test_lockfree_list, PushInsertRemove_ThenApproximateSizeIsSameToCountSize )
+{
+	// Arrenge
+	EXPECT_TRUE( sut_.is_empty() );
+	EXPECT_EQ( sut_.approximate_size(), 0 );
+
+	// Act
+	sut_.push_front( 1 );
+	sut_.push_back( 2 );
+	sut_.emplace_back( 2 );
+	sut_.insert( []( const int& v ) -> bool { return v == 2; }, 3 );
+	EXPECT_EQ( sut_.approximate_size(), 4 );
+	sut_.pop_front();
+	sut_.pop_back();
+	sut_.remove_all_if( []( const tut_list::value_type& v ) -> bool { return v == 2; } );
+
+	// Assert
+	EXPECT_EQ( sut_.approximate_size(), 1 );
+	EXPECT_EQ( sut_.approximate_size(), sut_.count_size() );
+	EXPECT_FALSE( sut_.is_empty() );
+	sut_.remove_one_if( []( const tut_list::value_type& v ) -> bool { return v == 3; } );
+	EXPECT_EQ( sut_.approximate_size(), 0 );
+	EXPECT_TRUE( sut_.is_empty() );
+}
+
 TEST_F( Test_lockfree_list, OneElement_DoRemoveOneIf_ThenEmpty )
 {
 	// Arrenge
@@ -0,0 +1,173 @@
+/**
+ * @file test_lf_list_ebr.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_list.hpp"
+
+#include "test_type_variation.hpp"
+
+using ebr_list_int = alpha::concurrent::lockfree_list<int, alpha::concurrent::epoch_based_reclamation>;
+
+class lfListEbrTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+	}
+
+	void TearDown() override
+	{
+		alpha::concurrent::internal::ebr_domain::DrainRetired();
+	}
+};
+
+TEST_F( lfListEbrTest, CallPopFromEmpty )
+{
+	// Arrange
+	ebr_list_int sut;
+
+	// Act
+	auto ret_f = sut.pop_front();
+	auto ret_b = sut.pop_back();
+
+	// Assert
+	EXPECT_FALSE( ret_f.has_value() );
+	EXPECT_FALSE( ret_b.has_value() );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST_F( lfListEbrTest, CallPushFrontPushBack_Then_OrderIsKept )
+{
+	// Arrange
+	ebr_list_int sut;
+
+	// Act
+	sut.push_back( 2 );
+	sut.push_front( 1 );
+	sut.emplace_back( 3 );
+
+	// Assert
+	std::vector<int> values;
+	sut.for_each( [&values]( int& v ) { values.push_back( v ); } );
+	EXPECT_EQ( values, ( std::vector<int> { 1, 2, 3 } ) );
+	EXPECT_EQ( sut.count_size(), 3 );
+	EXPECT_EQ( sut.approximate_size(), 3 );
+
+	auto ret_b = sut.pop_back();
+	ASSERT_TRUE( ret_b.has_value() );
+	EXPECT_EQ( ret_b.value(), 3 );
+	auto ret_f = sut.pop_front();
+	ASSERT_TRUE( ret_f.has_value() );
+	EXPECT_EQ( ret_f.value(), 1 );
+	EXPECT_EQ( sut.count_size(), 1 );
+}
+
+TEST_F( lfListEbrTest, CallInsert_Then_InsertedBeforeFoundNode )
+{
+	// Arrange
+	ebr_list_int sut;
+	sut.push_back( 1 );
+	sut.push_back( 3 );
+
+	// Act
+	sut.insert( []( const int& v ) -> bool { return v > 2; }, 2 );
+	sut.insert( []( const int& v ) -> bool { return v > 10; }, 4 );
+
+	// Assert
+	std::vector<int> values;
+	sut.for_each( [&values]( int& v ) { values.push_back( v ); } );
+	EXPECT_EQ( values, ( std::vector<int> { 1, 2, 3, 4 } ) );
+}
+
+TEST_F( lfListEbrTest, CallRemove_Then_OnlyMatchedNodesAreRemoved )
+{
+	// Arrange
+	ebr_list_int sut;
+	for ( int i = 0; i < 10; i++ ) {
+		sut.push_back( i );
+	}
+
+	// Act
+	auto   ret_one = sut.remove_one_if( []( const int& v ) -> bool { return v == 5; } );
+	size_t ret_all = sut.remove_all_if( []( const int& v ) -> bool { return ( v % 2 ) == 0; } );
+
+	// Assert
+	ASSERT_TRUE( ret_one.has_value() );
+	EXPECT_EQ( ret_one.value(), 5 );
+	EXPECT_EQ( ret_all, 5 );
+	std::vector<int> values;
+	sut.for_each( [&values]( int& v ) { values.push_back( v ); } );
+	EXPECT_EQ( values, ( std::vector<int> { 1, 3, 7, 9 } ) );
+	EXPECT_EQ( sut.approximate_size(), sut.count_size() );
+}
+
+TEST_F( lfListEbrTest, DoEmplace )
+{
+	// Arrange
+	alpha::concurrent::lockfree_list<partly_userdefined_5_special_op_no_default_constructor, alpha::concurrent::epoch_based_reclamation> sut;
+
+	// Act
+	sut.emplace_front( 2, 3.0 );
+
+	// Arrange
+	auto poped_data = sut.pop_back();
+	ASSERT_TRUE( poped_data.has_value() );
+	EXPECT_EQ( poped_data.value().x_, 2 );
+	EXPECT_EQ( poped_data.value().y_, 3.0 );
+}
+
+TEST_F( lfListEbrTest, PushPopFindInParallel_Then_SumIsSame )
+{
+	// Arrange
+	constexpr int            num_of_threads = 8;
+	constexpr int            loop_num       = 20000;
+	ebr_list_int             sut;
+	std::atomic<long long>   sum_popped( 0 );
+	std::vector<std::thread> ths;
+
+	// Act
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		ths.emplace_back( [&sut, &sum_popped, i]() {
+			long long local_sum = 0;
+			for ( int j = 0; j < loop_num; j++ ) {
+				if ( ( i % 2 ) == 0 ) {
+					sut.push_back( 1 );
+				} else {
+					sut.push_front( 1 );
+				}
+				sut.find_if( []( const int& v ) -> bool { return v != 1; } );
+				auto ret = ( ( j % 2 ) == 0 ) ? sut.pop_front() : sut.pop_back();
+				if ( ret.has_value() ) {
+					local_sum += ret.value();
+				}
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+	auto ret = sut.pop_front();
+	while ( ret.has_value() ) {
+		sum_popped += ret.value();
+		ret = sut.pop_front();
+	}
+
+	// Assert
+	EXPECT_EQ( sum_popped.load(), static_cast<long long>( num_of_threads ) * loop_num );
+	EXPECT_TRUE( sut.is_empty() );
+	EXPECT_EQ( sut.get_allocated_num(), 0 );
+	EXPECT_EQ( alpha::concurrent::internal::ebr_domain::DrainRetired(), 0 );
+}
@@ -89,6 +89,24 @@ TEST_F( lfStackTest, CallPushPopTwo )
 	EXPECT_EQ( ret2.value(), 1 );
 }
 
+TEST_F( lfStackTest, CallPushPop_Then_ApproximateSizeIsSameToCountSize )
+{
+	// Arrange
+	alpha::concurrent::stack_list<int> sut;
+	EXPECT_EQ( sut.approximate_size(), 0 );
+
+	// Act
+	sut.push( 1 );
+	sut.push( 2 );
+	sut.emplace( 3 );
+	EXPECT_EQ( sut.approximate_size(), 3 );
+	sut.pop();
+
+	// Assert
+	EXPECT_EQ( sut.approximate_size(), 2 );
+	EXPECT_EQ( sut.approximate_size(), sut.count_size() );
+}
+
 TEST_F( lfStackTest, DoEmplace )
 {
 	// Arrange
@@ -0,0 +1,135 @@
+/**
+ * @file test_lf_stack_ebr.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_stack.hpp"
+
+#include "test_type_variation.hpp"
+
+using ebr_stack_int = alpha::concurrent::stack_list<int, alpha::concurrent::epoch_based_reclamation>;
+
+class lfStackEbrTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+	}
+
+	void TearDown() override
+	{
+		alpha::concurrent::internal::ebr_domain::DrainRetired();
+	}
+};
+
+TEST_F( lfStackEbrTest, CallPopFromEmpty )
+{
+	// Arrange
+	ebr_stack_int sut;
+
+	// Act
+	auto ret = sut.pop();
+
+	// Assert
+	EXPECT_FALSE( ret.has_value() );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST_F( lfStackEbrTest, CallPushPopTwo )
+{
+	// Arrange
+	ebr_stack_int sut;
+
+	// Act
+	sut.push( 1 );
+	sut.push( 2 );
+	EXPECT_EQ( sut.count_size(), 2 );
+	auto ret1 = sut.pop();
+	auto ret2 = sut.pop();
+
+	// Assert
+	ASSERT_TRUE( ret1.has_value() );
+	EXPECT_EQ( ret1.value(), 2 );
+	ASSERT_TRUE( ret2.has_value() );
+	EXPECT_EQ( ret2.value(), 1 );
+	EXPECT_EQ( sut.get_allocated_num(), 0 );
+}
+
+TEST_F( lfStackEbrTest, DoEmplace )
+{
+	// Arrange
+	alpha::concurrent::stack_list<partly_userdefined_5_special_op_no_default_constructor, alpha::concurrent::epoch_based_reclamation> sut;
+
+	// Act
+	sut.emplace( 2, 3.0 );
+
+	// Arrange
+	auto poped_data = sut.pop();
+	ASSERT_TRUE( poped_data.has_value() );
+	EXPECT_EQ( poped_data.value().x_, 2 );
+	EXPECT_EQ( poped_data.value().y_, 3.0 );
+}
+
+TEST_F( lfStackEbrTest, PushPopInParallel_Then_SumIsSame )
+{
+	// Arrange
+	constexpr int            num_of_threads = 8;
+	constexpr int            loop_num       = 100000;
+	ebr_stack_int            sut;
+	std::atomic<long long>   sum_popped( 0 );
+	std::vector<std::thread> ths;
+
+	// Act
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		ths.emplace_back( [&sut, &sum_popped]() {
+			long long local_sum = 0;
+			for ( int j = 0; j < loop_num; j++ ) {
+				sut.push( 1 );
+				auto ret = sut.pop();
+				if ( ret.has_value() ) {
+					local_sum += ret.value();
+				}
+			}
+			sum_popped += local_sum;
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+	auto ret = sut.pop();
+	while ( ret.has_value() ) {
+		sum_popped += ret.value();
+		ret = sut.pop();
+	}
+
+	// Assert
+	EXPECT_EQ( sum_popped.load(), static_cast<long long>( num_of_threads ) * loop_num );
+	EXPECT_EQ( alpha::concurrent::internal::ebr_domain::DrainRetired(), 0 );
+}
+
+TEST_F( lfStackEbrTest, CallPushPop_Then_ApproximateSizeIsSameToCountSize )
+{
+	// Arrange
+	ebr_stack_int sut;
+
+	// Act
+	sut.push( 1 );
+	sut.emplace( 2 );
+	sut.push( 3 );
+	sut.pop();
+
+	// Assert
+	EXPECT_EQ( sut.approximate_size(), 2 );
+	EXPECT_EQ( sut.approximate_size(), sut.count_size() );
+}
@@ -9,6 +9,12 @@
  *
  */
 
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include "gtest/gtest.h"
 
 #include "alconcurrent/lf_mem_alloc.hpp"
@@ -116,3 +122,98 @@ TEST( Test_GMemAllocator, CanAllocateWithOverBigSize )
 
 	// Cleanup
 }
+
+TEST( Test_GMemAllocator, ThreadExitWithCachedSlots_DoFork_Then_ChildCanAllocate )
+{
+	// Arrange
+	std::vector<std::thread> threads;
+	for ( int i = 0; i < 4; i++ ) {
+		threads.emplace_back( []() {
+			std::vector<void*> mems;
+			for ( size_t j = 0; j < 128; j++ ) {
+				mems.push_back( alpha::concurrent::gmem_allocate( ( j + 1 ) * 64 ) );
+			}
+			for ( auto p : mems ) {
+				alpha::concurrent::gmem_deallocate( p );
+			}
+		} );
+	}
+	for ( auto& t : threads ) {
+		t.join();
+	}
+
+	// Act
+	pid_t pid = fork();
+	if ( pid == 0 ) {
+		int ret = 0;
+		for ( size_t j = 0; j < 128; j++ ) {
+			void* p = alpha::concurrent::gmem_allocate( ( j + 1 ) * 64 );
+			if ( p == nullptr ) ret = 1;
+			if ( !alpha::concurrent::gmem_deallocate( p ) ) ret = 2;
+		}
+		_exit( ret );
+	}
+
+	// Assert
+	ASSERT_GT( pid, 0 );
+	int status = 0;
+	EXPECT_EQ( waitpid( pid, &status, 0 ), pid );
+	EXPECT_TRUE( WIFEXITED( status ) );
+	EXPECT_EQ( WEXITSTATUS( status ), 0 );
+}
+
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_DEBUG_GUARD
+#ifdef ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_SAMPLING_INTERVAL
+constexpr size_t test_guard_sampling_interval = ALCONCURRENT_CONF_GMEM_DEBUG_GUARD_SAMPLING_INTERVAL;
+#else
+constexpr size_t test_guard_sampling_interval = 1000;
+#endif
+
+TEST( Test_GMemAllocator, DebugGuard_AllocateAndWriteWholeArea_Then_CanDeallocate )
+{
+	// Arrange
+	std::vector<unsigned char*> mems;
+
+	// Act
+	for ( size_t i = 0; i < test_guard_sampling_interval * 2; i++ ) {
+		unsigned char* p = reinterpret_cast<unsigned char*>( alpha::concurrent::gmem_allocate( 64 ) );
+		ASSERT_NE( p, nullptr );
+		EXPECT_GE( alpha::concurrent::get_max_allocatable_size( p ), 64 );
+		for ( size_t j = 0; j < 64; j++ ) {
+			p[j] = static_cast<unsigned char>( j );
+		}
+		mems.push_back( p );
+	}
+
+	// Assert
+	for ( auto p : mems ) {
+		EXPECT_EQ( p[63], 63 );
+		EXPECT_TRUE( alpha::concurrent::gmem_deallocate( p ) );
+	}
+}
+
+TEST( Test_GMemAllocator, DebugGuard_WriteOverrun_Then_Crash )
+{
+	EXPECT_DEATH(
+		{
+			for ( size_t i = 0; i < test_guard_sampling_interval * 2; i++ ) {
+				volatile unsigned char* p = reinterpret_cast<unsigned char*>( alpha::concurrent::gmem_allocate( 64 ) );
+				p[64]                     = 1;
+			}
+		},
+		"" );
+}
+
+TEST( Test_GMemAllocator, DebugGuard_WriteAfterFree_Then_Crash )
+{
+	EXPECT_DEATH(
+		{
+			for ( size_t i = 0; i < test_guard_sampling_interval * 2; i++ ) {
+				volatile unsigned char* p = reinterpret_cast<unsigned char*>( alpha::concurrent::gmem_allocate( 64 ) );
+				alpha::concurrent::gmem_deallocate( const_cast<unsigned char*>( p ) );
+				p[32] = 1;
+			}
+		},
+		"" );
+}
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file test_mem_numa_node.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_NUMA_AWARE
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "gtest/gtest.h"
+
+#include "alconcurrent/lf_mem_alloc.hpp"
+
+#include "mem_numa_node.hpp"
+#include "mem_small_memory_slot.hpp"
+
+TEST( Test_NumaNode, CanGetNodeCount )
+{
+	// Arrange
+
+	// Act
+	size_t node_count = alpha::concurrent::internal::get_numa_node_count();
+
+	// Assert
+	EXPECT_GE( node_count, 1 );
+	EXPECT_LE( node_count, alpha::concurrent::internal::gmem_numa_max_nodes );
+}
+
+TEST( Test_NumaNode, CanGetCurrentNodeIdx )
+{
+	// Arrange
+	size_t node_count = alpha::concurrent::internal::get_numa_node_count();
+
+	// Act
+	for ( int i = 0; i < 1000; i++ ) {
+		size_t node_idx = alpha::concurrent::internal::get_current_numa_node_idx();
+
+		// Assert
+		EXPECT_LT( node_idx, node_count );
+	}
+}
+
+TEST( Test_NumaNode, CanBindMemory )
+{
+	// Arrange
+	constexpr uintptr_t        page_size = 4096;
+	std::vector<unsigned char> buff( page_size * 4 );
+	size_t                     node_idx = alpha::concurrent::internal::get_numa_node_count() - 1;
+
+	// Act
+	bool ret = alpha::concurrent::internal::bind_memory_to_numa_node( buff.data(), buff.size(), node_idx );
+
+	// Assert
+	EXPECT_TRUE( ret );
+	buff[0]               = 1;
+	buff[buff.size() - 1] = 1;
+#ifdef ALCONCURRENT_CONF_ENABLE_GMEM_NUMA_AWARE
+	if ( alpha::concurrent::internal::get_numa_node_count() > 1 ) {
+		// 完全に含まれるページのメモリポリシーが、指定したNUMAノードを優先するポリシーになっていることを確認する。
+		constexpr int           mpol_preferred                   = 1;          // MPOL_PREFERRED
+		constexpr unsigned long mpol_f_addr                      = 1UL << 1;   // MPOL_F_ADDR
+		constexpr size_t        mask_bits                        = 1024;
+		constexpr size_t        word_bits                        = sizeof( unsigned long ) * 8;
+		uintptr_t               addr_page                        = ( reinterpret_cast<uintptr_t>( buff.data() ) + page_size - 1 ) & ~( page_size - 1 );
+		int                     mode                             = -1;
+		unsigned long           node_mask[mask_bits / word_bits] = {};
+
+		long ret_policy = syscall( SYS_get_mempolicy, &mode, node_mask, mask_bits, reinterpret_cast<void*>( addr_page ), mpol_f_addr );
+		ASSERT_EQ( ret_policy, 0 );
+		EXPECT_EQ( mode, mpol_preferred );
+		EXPECT_NE( node_mask[node_idx / word_bits] & ( 1UL << ( node_idx % word_bits ) ), 0 );
+	}
+#endif
+}
+
+TEST( Test_NumaNode, CanFreeFromOtherThread )
+{
+	// Arrange
+	constexpr size_t   num_of_mem = 100;
+	std::vector<void*> mems;
+	for ( size_t i = 0; i < num_of_mem; i++ ) {
+		mems.push_back( alpha::concurrent::gmem_allocate( ( i + 1 ) * 100 ) );
+	}
+	mems.push_back( alpha::concurrent::gmem_allocate( 1024 * 1024 ) );
+
+	// Act
+	std::thread t( [&mems]() {
+		for ( auto p : mems ) {
+			EXPECT_TRUE( alpha::concurrent::gmem_deallocate( p ) );
+		}
+	} );
+	t.join();
+
+	// Assert
+	void* p_big = alpha::concurrent::gmem_allocate( 1024 * 1024 );
+	EXPECT_NE( p_big, nullptr );
+	EXPECT_TRUE( alpha::concurrent::gmem_deallocate( p_big ) );
+}
+
+TEST( Test_NumaNode, AllocateOnOneNodeAndFreeFromOtherThread_Then_SlotIsReturnedToOwnerNodeList )
+{
+	// Arrange
+	// gmemが使用しない末尾のエントリを、2つのNUMAノード用の同じサイズのリストとして使う。
+	using retrieved_mgr                                   = alpha::concurrent::internal::retrieved_small_slots_array_mgr;
+	constexpr size_t                                    owner_node_idx      = 1;
+	constexpr size_t                                    other_node_idx      = 0;
+	constexpr size_t                                    owner_retrieved_idx = retrieved_mgr::max_entry_ - 1;
+	constexpr size_t                                    other_retrieved_idx = retrieved_mgr::max_entry_ - 2;
+	alpha::concurrent::internal::memory_slot_group_list owner_list( 16, 4096, 4096, owner_retrieved_idx, owner_node_idx );
+	alpha::concurrent::internal::memory_slot_group_list other_list( 16, 4096, 4096, other_retrieved_idx, other_node_idx );
+
+	owner_list.request_allocate_memory_slot_group();
+	alpha::concurrent::internal::slot_link_info* p_slot = owner_list.allocate();
+	ASSERT_NE( p_slot, nullptr );
+
+	// Act
+	std::thread t( [&owner_list, p_slot]() {
+		EXPECT_TRUE( owner_list.deallocate( p_slot ) );
+	} );
+	t.join();   // スレッド終了時に、スレッドローカルに保持されたスロットはグローバルなリストへ移る
+
+	// Assert
+	EXPECT_EQ( retrieved_mgr::request_reuse( other_retrieved_idx ), nullptr );
+	EXPECT_EQ( retrieved_mgr::request_reuse( owner_retrieved_idx ), p_slot );
+
+	// Cleanup
+	owner_list.clear_for_test();
+	other_list.clear_for_test();
+}
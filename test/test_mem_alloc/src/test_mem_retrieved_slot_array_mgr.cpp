@@ -168,171 +168,32 @@ TEST( Test_RetrievedSlotsStack, CanMergeTwoStacks )
 	EXPECT_TRUE( sut2.is_empty() );
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-using tut2 = alpha::concurrent::internal::retrieved_slots_stack_lockable<alpha::concurrent::internal::slot_link_info>;
-
-TEST( Test_RetrievedSlotsStackLockable, CanConstruct )
-{
-	// Arrange
-
-	// Act
-	tut2 sut;
-
-	// Assert
-	EXPECT_EQ( 0, sut.count() );
-	EXPECT_TRUE( sut.is_empty() );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, CanPushWithNullPtr )
-{
-	// Arrange
-	tut2                                         sut;
-	alpha::concurrent::internal::slot_link_info* p = nullptr;
-
-	// Act
-	sut.try_push( p );
-
-	// Assert
-	EXPECT_EQ( 0, sut.count() );
-	EXPECT_TRUE( sut.is_empty() );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, CanPushOneElement )
-{
-	// Arrange
-	tut2                                         sut;
-	unsigned char                                buffer[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer, nullptr );
-
-	// Act
-	sut.try_push( p_sli );
-
-	// Assert
-	EXPECT_EQ( 1, sut.count() );
-	EXPECT_FALSE( sut.is_empty() );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, CanPushTwoElement )
-{
-	// Arrange
-	tut2                                         sut;
-	unsigned char                                buffer1[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli1 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer1, nullptr );
-	unsigned char                                buffer2[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli2 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer2, nullptr );
-
-	// Act
-	sut.try_push( p_sli1 );
-	sut.try_push( p_sli2 );
-
-	// Assert
-	EXPECT_EQ( 2, sut.count() );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, Empty_CanPopOneElement )
-{
-	// Arrange
-	tut2 sut;
-
-	// Act
-	auto p = sut.try_pop();
-
-	// Assert
-	EXPECT_EQ( 0, sut.count() );
-	EXPECT_TRUE( sut.is_empty() );
-	EXPECT_EQ( nullptr, p );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, OneElement_CanPopOneElement )
-{
-	// Arrange
-	tut2                                         sut;
-	unsigned char                                buffer[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer, nullptr );
-	sut.try_push( p_sli );
-	EXPECT_EQ( 1, sut.count() );
-
-	// Act
-	auto p = sut.try_pop();
-
-	// Assert
-	EXPECT_EQ( 0, sut.count() );
-	EXPECT_TRUE( sut.is_empty() );
-	EXPECT_EQ( p_sli, p );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, TwoElement_CanPopTwoElement )
+TEST( Test_RetrievedSlotsStack, CanMergeToEmptyStack_Then_PushPopKeepOrder )
 {
 	// Arrange
-	tut2                                         sut;
-	unsigned char                                buffer1[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli1 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer1, nullptr );
-	unsigned char                                buffer2[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli2 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer2, nullptr );
-	sut.try_push( p_sli1 );
-	sut.try_push( p_sli2 );
-	EXPECT_EQ( 2, sut.count() );
-
-	// Act
-	auto p1 = sut.try_pop();
-	auto p2 = sut.try_pop();
-
-	// Assert
-	EXPECT_EQ( 0, sut.count() );
-	EXPECT_TRUE( sut.is_empty() );
-	EXPECT_EQ( p_sli2, p1 );
-	EXPECT_EQ( p_sli1, p2 );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, OneElement_CanPopTwoElement_Then_ValidAndNullPtr )
-{
-	// Arrange
-	tut2                                         sut;
-	unsigned char                                buffer1[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli1 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer1, nullptr );
-	sut.try_push( p_sli1 );
-	EXPECT_EQ( 1, sut.count() );
-
-	// Act
-	auto p1 = sut.try_pop();
-	auto p2 = sut.try_pop();
-
-	// Assert
-	EXPECT_EQ( 0, sut.count() );
-	EXPECT_TRUE( sut.is_empty() );
-	EXPECT_EQ( p1, p_sli1 );
-	EXPECT_EQ( p2, nullptr );
-}
-
-TEST( Test_RetrievedSlotsStackLockable, CanMergeTwoStacks )
-{
-	// Arrange
-	tut2                                         sut1;
+	tut1                                         sut1;
+	tut1                                         sut2;
 	unsigned char                                buffer1[1024];
 	alpha::concurrent::internal::slot_link_info* p_sli1 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer1, nullptr );
 	unsigned char                                buffer2[1024];
 	alpha::concurrent::internal::slot_link_info* p_sli2 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer2, nullptr );
-	sut1.try_push( p_sli1 );
-	sut1.try_push( p_sli2 );
-	EXPECT_EQ( 2, sut1.count() );
-
-	tut1                                         sut2;
 	unsigned char                                buffer3[1024];
 	alpha::concurrent::internal::slot_link_info* p_sli3 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer3, nullptr );
-	unsigned char                                buffer4[1024];
-	alpha::concurrent::internal::slot_link_info* p_sli4 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer4, nullptr );
-	sut2.push( p_sli3 );
-	sut2.push( p_sli4 );
-	EXPECT_EQ( 2, sut2.count() );
+	sut2.push( p_sli1 );
 
 	// Act
 	sut1.merge( std::move( sut2 ) );
+	sut2.push( p_sli2 );
+	sut1.merge( std::move( sut2 ) );
+	sut1.push( p_sli3 );
 
 	// Assert
-	EXPECT_EQ( 4, sut1.count() );
-	EXPECT_FALSE( sut1.is_empty() );
-	EXPECT_EQ( 0, sut2.count() );
-	EXPECT_TRUE( sut2.is_empty() );
+	EXPECT_EQ( 3, sut1.count() );
+	EXPECT_EQ( p_sli3, sut1.pop() );
+	EXPECT_EQ( p_sli2, sut1.pop() );
+	EXPECT_EQ( p_sli1, sut1.pop() );
+	EXPECT_EQ( nullptr, sut1.pop() );
+	EXPECT_TRUE( sut1.is_empty() );
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -496,6 +357,108 @@ TEST( Test_RetrievedSlotsStackLockfree, CanMergeTwoStacks )
 	EXPECT_EQ( nullptr, p6 );
 }
 
+TEST( Test_RetrievedSlotsStackLockfree, TwoElement_CanPopTwoElement_Then_ValidAndNullPtr )
+{
+	// Arrange
+	tut3                                         sut;
+	unsigned char                                buffer1[1024];
+	alpha::concurrent::internal::slot_link_info* p_sli1 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer1, nullptr );
+	unsigned char                                buffer2[1024];
+	alpha::concurrent::internal::slot_link_info* p_sli2 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer2, nullptr );
+	sut.push( p_sli1 );
+	sut.push( p_sli2 );
+
+	// Act
+	auto p1 = sut.pop();
+	auto p2 = sut.pop();
+	auto p3 = sut.pop();
+
+	// Assert
+	EXPECT_EQ( p_sli2, p1 );
+	EXPECT_EQ( p_sli1, p2 );
+	EXPECT_EQ( nullptr, p3 );
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+using tut5 = alpha::concurrent::internal::retrieved_slots_stack_detachable<alpha::concurrent::internal::slot_link_info>;
+
+TEST( Test_RetrievedSlotsStackDetachable, CanConstruct )
+{
+	// Arrange
+
+	// Act
+	tut5 sut;
+
+	// Assert
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST( Test_RetrievedSlotsStackDetachable, Empty_CanPopNoInHazard_Then_ReturnNullPtr )
+{
+	// Arrange
+	tut5 sut;
+	tut3 dst;
+
+	// Act
+	auto p = sut.pop_no_in_hazard( dst );
+
+	// Assert
+	EXPECT_EQ( nullptr, p );
+	EXPECT_EQ( nullptr, dst.pop() );
+}
+
+TEST( Test_RetrievedSlotsStackDetachable, SomeSlotsInHazard_CanPopNoInHazard_Then_OtherSlotsAreSorted )
+{
+	// Arrange
+	tut5                                         sut;
+	tut3                                         dst;
+	unsigned char                                buffer1[1024];
+	alpha::concurrent::internal::slot_link_info* p_sli1 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer1, nullptr );
+	unsigned char                                buffer2[1024];
+	alpha::concurrent::internal::slot_link_info* p_sli2 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer2, nullptr );
+	unsigned char                                buffer3[1024];
+	alpha::concurrent::internal::slot_link_info* p_sli3 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer3, nullptr );
+	tut1                                         src;
+	src.push( p_sli1 );
+	src.push( p_sli2 );
+	src.push( p_sli3 );
+	sut.merge( std::move( src ) );
+	alpha::concurrent::hazard_ptr<alpha::concurrent::internal::slot_link_info> hp2( p_sli2 );
+
+	// Act
+	auto p1 = sut.pop_no_in_hazard( dst );
+
+	// Assert
+	ASSERT_NE( nullptr, p1 );
+	EXPECT_NE( p_sli2, p1 );
+	auto p2 = dst.pop();   // the other slot that is not in hazard moves to dst
+	EXPECT_NE( nullptr, p2 );
+	EXPECT_NE( p_sli2, p2 );
+	EXPECT_NE( p1, p2 );
+	EXPECT_EQ( nullptr, dst.pop() );
+	EXPECT_FALSE( sut.is_empty() );   // the slot in hazard is kept
+
+	hp2.reset();
+	auto p3 = sut.pop_no_in_hazard( dst );
+	EXPECT_EQ( p_sli2, p3 );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST( Test_RetrievedSlotsStackDetachable, PopByOnlyThisThread_CanWaitForPopByOthers_Then_ReturnFalse )
+{
+	// Arrange
+	tut5 sut;
+	tut3 dst;
+	auto p = sut.pop_no_in_hazard( dst );
+	EXPECT_EQ( nullptr, p );
+
+	// Act
+	bool ret = sut.wait_for_pop_by_others();
+
+	// Assert
+	EXPECT_FALSE( ret );
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 using tut4 = alpha::concurrent::internal::retrieved_slots_stack_array_mgr<alpha::concurrent::internal::slot_link_info>;
 
@@ -557,3 +520,31 @@ TEST( Test_RetrievedSlotsStackArrayMgr, Empty_CanPop_Then_ReturnNullPtr )
 	// Assert
 	EXPECT_EQ( p, nullptr );
 }
+
+TEST( Test_RetrievedSlotsStackArrayMgr, HeadSlotInHazard_CanPop_Then_ReturnNotInHazardSlot )
+{
+	// Arrange
+	tut4::reset_for_test();
+	unsigned char                                buffer1[1024];
+	alpha::concurrent::internal::slot_link_info* p_sli1 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer1, nullptr );
+	unsigned char                                buffer2[1024];
+	alpha::concurrent::internal::slot_link_info* p_sli2 = alpha::concurrent::internal::slot_link_info::emplace_on_mem( buffer2, nullptr );
+
+	alpha::concurrent::hazard_ptr<alpha::concurrent::internal::slot_link_info> hp1( p_sli1 );
+	alpha::concurrent::hazard_ptr<alpha::concurrent::internal::slot_link_info> hp2( p_sli2 );
+	tut4::retrieve( 0, p_sli1 );
+	tut4::retrieve( 0, p_sli2 );
+	hp1.reset();
+
+	// Act
+	auto p1 = tut4::request_reuse( 0 );
+
+	// Assert
+	EXPECT_EQ( p_sli1, p1 );
+
+	// Cleanup
+	hp2.reset();
+	auto p2 = tut4::request_reuse( 0 );
+	EXPECT_EQ( p_sli2, p2 );
+	tut4::reset_for_test();
+}
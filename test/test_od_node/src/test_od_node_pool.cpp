@@ -9,8 +9,11 @@
  *
  */
 
+#include <atomic>
+#include <set>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -202,3 +205,117 @@ TEST( od_node_pool_class, CanCleanAsPossibleAs_InHazardPtr )
 	EXPECT_EQ( p_tmp3, p_tmp );
 	delete p_tmp3;
 }
+
+TEST( od_node_pool_class, PushManyInOtherThread_Then_CanPopBeforeThreadExit )
+{
+	// Arrange
+	constexpr size_t  num_of_nodes = alpha::concurrent::internal::aggressive_aggregation_threshold * 5;
+	sut_type          sut;
+	std::atomic<bool> is_pushed( false );
+	std::atomic<bool> is_popped( false );
+	std::thread       t( [&sut, &is_pushed, &is_popped]() {
+		for ( size_t i = 0; i < num_of_nodes; i++ ) {
+			sut.push( new test_od_node_of_pool );
+		}
+		is_pushed.store( true );
+		while ( !is_popped.load() ) {
+			std::this_thread::yield();
+		}
+	} );
+	while ( !is_pushed.load() ) {
+		std::this_thread::yield();
+	}
+
+	// Act
+	std::vector<test_od_node_of_pool*> popped_nodes;
+	for ( size_t i = 0; i < alpha::concurrent::internal::aggressive_aggregation_threshold * 3; i++ ) {
+		popped_nodes.push_back( sut.pop() );
+	}
+	is_popped.store( true );
+	t.join();
+
+	// Assert
+	for ( auto p : popped_nodes ) {
+		EXPECT_NE( p, nullptr );
+		delete p;
+	}
+
+	// Cleanup
+	sut.clear_as_possible_as();
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+// od_node_poolのグローバル変数はノードの型ごとに存在するため、他のテストの影響を受けないよう専用のノード型を使う。
+class test_od_node_of_batch_pool : public alpha::concurrent::internal::od_node_simple_link, public alpha::concurrent::internal::od_node_link_by_hazard_handler {};
+
+using sut_batch_type = alpha::concurrent::internal::od_node_pool<test_od_node_of_batch_pool>;
+
+TEST( od_node_pool_class, PushOverThresholdInOtherThread_Then_OneBatchIsPoppedByThisThread )
+{
+	// Arrange
+	constexpr size_t                      batch_size = alpha::concurrent::internal::aggressive_aggregation_threshold;
+	sut_batch_type                        sut;
+	std::set<test_od_node_of_batch_pool*> pushed_nodes;
+	std::atomic<int>                      step( 0 );
+	std::thread                           t( [&sut, &pushed_nodes, &step]() {
+		// 閾値の直前まではスレッドローカルなリストに留まる
+		for ( size_t i = 0; i < ( batch_size * 2 ) - 1; i++ ) {
+			auto p = new test_od_node_of_batch_pool;
+			pushed_nodes.insert( p );
+			sut.push( p );
+		}
+		step.store( 1 );
+		while ( step.load() != 2 ) {
+			std::this_thread::yield();
+		}
+
+		// 閾値に達したら、1バッチ分だけグローバルなリストへ移る
+		auto p = new test_od_node_of_batch_pool;
+		pushed_nodes.insert( p );
+		sut.push( p );
+		step.store( 3 );
+		while ( step.load() != 4 ) {
+			std::this_thread::yield();
+		}
+	} );
+	while ( step.load() != 1 ) {
+		std::this_thread::yield();
+	}
+	EXPECT_EQ( sut.pop(), nullptr );
+	step.store( 2 );
+	while ( step.load() != 3 ) {
+		std::this_thread::yield();
+	}
+
+	// Act
+	std::set<test_od_node_of_batch_pool*> popped_nodes;
+	for ( size_t i = 0; i < batch_size; i++ ) {
+		auto p = sut.pop();
+		ASSERT_NE( p, nullptr ) << "i=" << i;
+		EXPECT_TRUE( popped_nodes.insert( p ).second ) << "same node is popped twice";
+	}
+	auto p_over = sut.pop();
+
+	// Assert
+	EXPECT_EQ( p_over, nullptr );
+	EXPECT_EQ( popped_nodes.size(), batch_size );
+	for ( auto p : popped_nodes ) {
+		EXPECT_EQ( pushed_nodes.count( p ), 1 );
+	}
+	step.store( 4 );
+	t.join();
+
+	// スレッド終了により、残りのノードはグローバルなリストへ移っている
+	for ( size_t i = 0; i < batch_size; i++ ) {
+		auto p = sut.pop();
+		ASSERT_NE( p, nullptr ) << "i=" << i;
+		EXPECT_TRUE( popped_nodes.insert( p ).second ) << "same node is popped twice";
+	}
+	EXPECT_EQ( sut.pop(), nullptr );
+	EXPECT_EQ( popped_nodes, pushed_nodes );
+
+	// Cleanup
+	for ( auto p : popped_nodes ) {
+		delete p;
+	}
+}
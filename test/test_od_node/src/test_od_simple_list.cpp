@@ -9,6 +9,11 @@
  *
  */
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "alconcurrent/conf_logger.hpp"
@@ -457,6 +462,60 @@ TEST_F( TestOdSimpleList, CanMergePushBackToList )
 	EXPECT_EQ( p, nullptr );
 }
 
+TEST_F( TestOdSimpleList, CanMergePushFrontChain_Then_SizeIsNumberOfNodes )
+{
+	// Arrange
+	test_node_type* p_nd1 = new test_node_type;
+	test_node_type* p_nd2 = new test_node_type;
+	test_node_type* p_nd3 = new test_node_type;
+	p_nd1->set_next( p_nd2 );
+	p_nd2->set_next( p_nd3 );
+	od_simple_list sut;
+	sut.push_front( new test_node_type );
+
+	// Act
+	sut.merge_push_front( p_nd1 );
+
+	// Assert
+	EXPECT_EQ( sut.size(), 4 );
+	EXPECT_EQ( sut.pop_front(), p_nd1 );
+	EXPECT_EQ( sut.pop_front(), p_nd2 );
+	EXPECT_EQ( sut.pop_front(), p_nd3 );
+	EXPECT_EQ( sut.size(), 1 );
+	delete p_nd1;
+	delete p_nd2;
+	delete p_nd3;
+	delete sut.pop_front();
+	EXPECT_EQ( sut.size(), 0 );
+}
+
+TEST_F( TestOdSimpleList, CanMergePushBackChain_Then_SizeIsNumberOfNodes )
+{
+	// Arrange
+	test_node_type* p_nd1 = new test_node_type;
+	test_node_type* p_nd2 = new test_node_type;
+	test_node_type* p_nd3 = new test_node_type;
+	p_nd1->set_next( p_nd2 );
+	p_nd2->set_next( p_nd3 );
+	od_simple_list sut;
+	sut.push_front( new test_node_type );
+
+	// Act
+	sut.merge_push_back( p_nd1 );
+
+	// Assert
+	EXPECT_EQ( sut.size(), 4 );
+	delete sut.pop_front();
+	EXPECT_EQ( sut.size(), 3 );
+	EXPECT_EQ( sut.pop_front(), p_nd1 );
+	EXPECT_EQ( sut.pop_front(), p_nd2 );
+	EXPECT_EQ( sut.pop_front(), p_nd3 );
+	EXPECT_EQ( sut.size(), 0 );
+	delete p_nd1;
+	delete p_nd2;
+	delete p_nd3;
+}
+
 TEST_F( TestOdSimpleList, CanClearWithEmpty )
 {
 	// Arrange
@@ -810,6 +869,122 @@ TEST_F( TestOdSimpleListLockable, AccessNoLockConstObj_Then_ThrowException )
 	// Assert
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+class TestOdSimpleListDetachable : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		alpha::concurrent::GetErrorWarningLogCountAndReset( nullptr, nullptr );
+	}
+
+	void TearDown() override
+	{
+		int cw, ce;
+		alpha::concurrent::GetErrorWarningLogCountAndReset( &ce, &cw );
+		EXPECT_EQ( ce, 0 );
+		EXPECT_EQ( cw, 0 );
+	}
+};
+
+TEST_F( TestOdSimpleListDetachable, CanConstruct )
+{
+	// Arrange
+
+	// Act
+	od_simple_list_detachable sut;
+
+	// Assert
+	EXPECT_TRUE( sut.is_empty() );
+	EXPECT_EQ( sut.size(), 0 );
+	EXPECT_TRUE( sut.detach_all().is_empty() );
+}
+
+TEST_F( TestOdSimpleListDetachable, CanMergeTwice_Then_DetachAll )
+{
+	// Arrange
+	od_simple_list_detachable sut;
+	od_simple_list            src1;
+	src1.push_back( new test_node_type );
+	src1.push_back( new test_node_type );
+	od_simple_list src2;
+	src2.push_back( new test_node_type );
+
+	// Act
+	sut.merge_push_front( std::move( src1 ) );
+	sut.merge_push_front( std::move( src2 ) );
+
+	// Assert
+	EXPECT_TRUE( src1.is_empty() );
+	EXPECT_TRUE( src2.is_empty() );
+	EXPECT_FALSE( sut.is_empty() );
+	EXPECT_EQ( sut.size(), 3 );
+	od_simple_list ret = sut.detach_all();
+	EXPECT_TRUE( sut.is_empty() );
+	EXPECT_EQ( sut.size(), 0 );
+	EXPECT_EQ( ret.size(), 3 );
+}
+
+TEST_F( TestOdSimpleListDetachable, MergeInParallel_Then_DetachAllNodes )
+{
+	// Arrange
+	constexpr int             num_of_threads = 4;
+	constexpr int             num_of_loops   = 1000;
+	od_simple_list_detachable sut;
+	std::atomic<size_t>       count_detached( 0 );
+	std::vector<std::thread>  ths;
+
+	// Act
+	for ( int i = 0; i < num_of_threads; i++ ) {
+		ths.emplace_back( [&sut, &count_detached]() {
+			for ( int j = 0; j < num_of_loops; j++ ) {
+				od_simple_list src;
+				src.push_back( new test_node_type );
+				sut.merge_push_front( std::move( src ) );
+				if ( ( j % 10 ) == 0 ) {
+					count_detached += sut.detach_all().size();
+				}
+			}
+		} );
+	}
+	for ( auto& e : ths ) {
+		e.join();
+	}
+	count_detached += sut.detach_all().size();
+
+	// Assert
+	EXPECT_EQ( count_detached.load(), static_cast<size_t>( num_of_threads * num_of_loops ) );
+	EXPECT_TRUE( sut.is_empty() );
+}
+
+TEST_F( TestOdSimpleListDetachable, DetachIsNotEnded_Then_WaitUntilEndDetach )
+{
+	// Arrange
+	od_simple_list_detachable sut;
+	od_simple_list            src;
+	src.push_back( new test_node_type );
+	sut.merge_push_front( std::move( src ) );
+	od_simple_list   detached = sut.begin_detach();
+	std::atomic_bool is_ended( false );
+	EXPECT_TRUE( sut.is_empty() );
+
+	// Act
+	std::thread th( [&sut, &detached, &is_ended]() {
+		std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+		sut.merge_push_front( std::move( detached ) );
+		is_ended.store( true );
+		sut.end_detach();
+	} );
+	bool ret = sut.wait_for_detaching_by_others();
+
+	// Assert
+	EXPECT_TRUE( ret );
+	EXPECT_TRUE( is_ended.load() );
+	EXPECT_FALSE( sut.is_empty() );
+	EXPECT_FALSE( sut.wait_for_detaching_by_others() );
+	th.join();
+	EXPECT_EQ( sut.detach_all().size(), 1 );
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 class TestOdSimpleListConditionalLockable : public ::testing::Test {
 protected: